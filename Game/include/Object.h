@@ -1,5 +1,7 @@
 #pragma once
 #include "baseTypes.h"
+#include "transform.h"
+#include "fixed.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -8,38 +10,133 @@ extern "C" {
 
 // object "virtual" functions
 typedef struct object_t Object;
-typedef void (*ObjDrawFunc)(Object*);
+// draw receives the interpolation alpha: how far (0..1) the frame is between the last two fixed steps
+typedef void (*ObjDrawFunc)(Object*, float);
 typedef void (*ObjUpdateFunc)(Object*, uint32_t);
-typedef void (*ObjFixedUpdateFunc)(Object*, uint32_t);
+// fixed updates receive the step length in seconds; velocities are in units per second
+typedef void (*ObjFixedUpdateFunc)(Object*, float);
+// called when a wakeup requested through objWakeIn comes due
+typedef void (*ObjWakeFunc)(Object*);
+// fills in the box the object occupies at its current position
+typedef void (*ObjBoundsFunc)(const Object*, Bounds2D*);
+// whether a ray (unit direction) enters the object's exact shape within a distance, & where;
+// a ray starting inside hits at 0
+typedef bool (*ObjRaycastFunc)(const Object*, Coord2D, Coord2D, float, float*);
+
+// optional batch entry points, called with a span of objects that all share this vtable;
+// entries are NULL for objects removed earlier in the same pass, & must be skipped
+typedef void (*ObjUpdateBatchFunc)(Object**, uint32_t, uint32_t);
+typedef void (*ObjDrawBatchFunc)(Object**, uint32_t, float);
+typedef void (*ObjFixedUpdateBatchFunc)(Object**, uint32_t, float);
+
+// update only touches the object itself (no registration, callbacks or shared state),
+// so the object manager may run it on worker threads
+#define OBJ_FLAG_THREAD_SAFE_UPDATE 0x1
+
+// what kind of thing an object is, so queries can pick out just some kinds & levels can say
+// which kinds collide; masks hold one OBJ_LAYER_BIT per layer they select
+typedef enum obj_layer_t {
+    OBJ_LAYER_DEFAULT = 0,
+    OBJ_LAYER_FIELD,
+    OBJ_LAYER_BALL,
+    OBJ_LAYER_PLAYER,
+    OBJ_LAYER_FACE,
+    OBJ_LAYER_COUNT
+} ObjLayer;
+
+#define OBJ_LAYER_BIT(layer) (1u << (layer))
+#define OBJ_LAYER_MASK_ALL UINT32_MAX
 
 typedef struct object_vtable_t {
     ObjDrawFunc        draw;
     ObjUpdateFunc      update;
     ObjFixedUpdateFunc fixedUpdate;
+    ObjUpdateBatchFunc updateBatch;
+    ObjDrawBatchFunc   drawBatch;
+    ObjWakeFunc        wake;
+    ObjFixedUpdateBatchFunc fixedUpdateBatch;
+    ObjBoundsFunc      getBounds;       // optional; objects with bounds are tracked for spatial queries
+    ObjRaycastFunc     raycast;         // optional; exact shape within the bounds, for scene queries
+    uint32_t           flags;
+    ObjLayer           layer;
 } ObjVtable;
 
+// slot index of an object that is not tracked by the object manager
+#define OBJ_INVALID_SLOT UINT32_MAX
+// transform index of an object whose position & velocity live in the object itself
+#define OBJ_NO_TRANSFORM UINT32_MAX
+
 typedef struct object_t {
     ObjVtable*      vtable;
-    uint32_t        nextUpdate;
-    Coord2D         position;
-    Coord2D         velocity;
+    uint32_t        mgrSlot;        // owned by the object manager
+    uint32_t        transform;      // index into the transform store, if attached
+    uint32_t        category;       // OBJ_LAYER_BITs the object is on; starts as its type's layer
+    uint32_t        collideMask;    // OBJ_LAYER_BITs it collides with; starts from the layer matrix
+
+    // only valid while transform is OBJ_NO_TRANSFORM; prefer the accessors below
+    RealCoord2D     position;
+    RealCoord2D     velocity;
+    RealCoord2D     acceleration;
+    RealCoord2D     prevPosition;   // position at the start of the current fixed step
 } Object;
 
 typedef void (*ObjRegistrationFunc)(Object*);
+typedef bool (*ObjScheduleFunc)(Object*, uint32_t);
 
 // class-wide registration methods
 void objEnableRegistration(ObjRegistrationFunc registerFunc, ObjRegistrationFunc deregisterFunc);
 void objDisableRegistration();
 
+// class-wide transform storage, used by objects with an attached transform index
+void objEnableTransforms(TransformStore* store);
+void objDisableTransforms();
+
+// class-wide wakeup scheduler, used by objWakeIn
+void objEnableTimers(ObjScheduleFunc scheduleFunc);
+void objDisableTimers();
+
+// class-wide layer matrix; objects take their collide mask from it when initialized
+void objSetLayerMatrix(const uint32_t* layerMasks);
+uint32_t objGetLayerMask(ObjLayer layer);
+
 // object API
 void objInit(Object* obj, ObjVtable* vtable, Coord2D pos, Coord2D vel);
 void objDeinit(Object* obj);
-void objDraw(Object* obj);
+void objDraw(Object* obj, float alpha);
 void objUpdate(Object* obj, uint32_t milliseconds);
-void objFixedUpdate(Object* obj, uint32_t milliseconds);
+void objFixedUpdate(Object* obj, float seconds);
+void objWake(Object* obj);
+bool objWakeIn(Object* obj, uint32_t milliseconds);
+bool objGetBounds(const Object* obj, Bounds2D* box);
+bool objRaycast(const Object* obj, Coord2D origin, Coord2D direction, float maxDistance, float* distance);
+bool objContainsPoint(const Object* obj, Coord2D point);
+bool objInLayers(const Object* obj, uint32_t mask);
+bool objShouldCollide(const Object* a, const Object* b);
+void objSetCollisionFilter(Object* obj, uint32_t category, uint32_t collideMask);
+
+// batched API; every object in the span must share the same vtable
+void objDrawBatch(Object** objs, uint32_t count, float alpha);
+void objFixedUpdateBatch(Object** objs, uint32_t count, float seconds);
+void objUpdateBatch(Object** objs, uint32_t count, uint32_t milliseconds);
+
+Coord2D objGetPosition(const Object* obj);
+void objSetPosition(Object* obj, Coord2D pos);
+Coord2D objGetVelocity(const Object* obj);
+void objSetVelocity(Object* obj, Coord2D vel);
+Coord2D objGetAcceleration(const Object* obj);
+void objSetAcceleration(Object* obj, Coord2D accel);
+Coord2D objGetDrawPosition(const Object* obj, float alpha);
+
+// the same, in the simulation's own number type; physics code should use these so it stays exact
+// in fixed point builds
+RealCoord2D objGetRealPosition(const Object* obj);
+void objSetRealPosition(Object* obj, RealCoord2D pos);
+RealCoord2D objGetRealVelocity(const Object* obj);
+void objSetRealVelocity(Object* obj, RealCoord2D vel);
+RealCoord2D objGetRealPrevPosition(const Object* obj);
 
-// default update implementation that just moves at the current velocity
-void objDefaultUpdate(Object* obj, uint32_t milliseconds);
+// default fixed update implementation; semi-implicit Euler
+void objDefaultUpdate(Object* obj, float seconds);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,13 @@
+#pragma once
+#include "baseTypes.h"
+#include "broadphase.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+Broadphase* aabbTreeNew(float margin);
+
+#ifdef __cplusplus
+}
+#endif
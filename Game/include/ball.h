@@ -7,11 +7,19 @@ extern "C" {
 
 typedef struct ball_t Ball;
 
-typedef void (*BallCollideCB) (Ball*);
-void ballSetCollideCB(BallCollideCB cb);
-void ballClearCollideCB();
+// broadphases balls can collide through
+typedef enum ball_broadphase_t {
+    BALL_BROADPHASE_GRID,
+    BALL_BROADPHASE_SWEEP_PRUNE,
+    BALL_BROADPHASE_AABB_TREE
+} BallBroadphase;
+
+void ballInitPool();
+void ballShutdownPool();
+void ballSetBroadphase(BallBroadphase type);
 
 Ball* ballNew(Bounds2D bounds);
+Ball* ballNewAt(Bounds2D bounds, Coord2D pos);
 void ballDelete(Ball* ball);
 
 #ifdef __cplusplus
@@ -0,0 +1,109 @@
+#pragma once
+#include "baseTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// returned when a proxy could not be added
+#define BROADPHASE_INVALID_PROXY UINT32_MAX
+// filter a proxy starts with: one category, colliding with every other
+#define BROADPHASE_DEFAULT_CATEGORY 0x1u
+#define BROADPHASE_MASK_ALL UINT32_MAX
+
+/// @brief Two proxies whose boxes overlap
+typedef struct collision_pair_t {
+    uint32_t    a;
+    uint32_t    b;
+} CollisionPair;
+
+/// @brief A box tracked by a broadphase, plus whatever the owner wants back in pair reports.
+/// Two proxies only pair if each one's category is in the other's mask
+typedef struct broadphase_proxy_t {
+    Bounds2D    box;
+    void*       userData;
+    uint32_t    category;
+    uint32_t    mask;
+    uint32_t    nextFree;
+    bool        active;
+} BroadphaseProxy;
+
+// broadphase "virtual" functions; the base has already updated the proxy when these are called
+typedef struct broadphase_t Broadphase;
+typedef void (*BroadphaseDeleteFunc)(Broadphase*);
+typedef void (*BroadphaseProxyFunc)(Broadphase*, uint32_t);
+// returns false if out of memory, in which case the base drops the proxy again
+typedef bool (*BroadphaseAddFunc)(Broadphase*, uint32_t);
+typedef void (*BroadphaseFindPairsFunc)(Broadphase*);
+
+// query callbacks. Region & point callbacks return false to stop the query. Ray callbacks
+// return the distance to clip the rest of the ray to: maxDistance to keep going unchanged,
+// the hit distance to only look for closer hits, or 0 to stop
+typedef bool (*BroadphaseQueryFunc)(void* context, uint32_t proxy);
+typedef float (*BroadphaseRayFunc)(void* context, uint32_t proxy, float maxDistance);
+typedef void (*BroadphaseQueryRegionFunc)(const Broadphase*, const Bounds2D*, BroadphaseQueryFunc, void*);
+typedef void (*BroadphaseQueryRayFunc)(const Broadphase*, Coord2D, Coord2D, float, BroadphaseRayFunc, void*);
+
+typedef struct broadphase_vtable_t {
+    BroadphaseDeleteFunc    destroy;
+    BroadphaseAddFunc       add;        // optional
+    BroadphaseProxyFunc     move;       // optional
+    BroadphaseProxyFunc     remove;     // optional
+    BroadphaseFindPairsFunc findPairs;
+    BroadphaseQueryRegionFunc queryRegion;  // optional; the base scans every proxy
+    BroadphaseQueryRayFunc  queryRay;       // optional; the base scans every proxy
+} BroadphaseVtable;
+
+typedef struct broadphase_t {
+    const BroadphaseVtable* vtable;
+
+    BroadphaseProxy*    proxies;
+    uint32_t            proxyCount;     // high water mark; ids below this may be inactive
+    uint32_t            proxyCapacity;
+    uint32_t            freeHead;
+
+    CollisionPair*      pairs;
+    uint32_t            pairCount;
+    uint32_t            pairCapacity;
+} Broadphase;
+
+// broadphase API
+void broadphaseDelete(Broadphase* broadphase);
+uint32_t broadphaseAdd(Broadphase* broadphase, const Bounds2D* box, void* userData);
+void broadphaseMove(Broadphase* broadphase, uint32_t proxy, const Bounds2D* box);
+void broadphaseSetFilter(Broadphase* broadphase, uint32_t proxy, uint32_t category, uint32_t mask);
+void broadphaseRemove(Broadphase* broadphase, uint32_t proxy);
+uint32_t broadphaseFindPairs(Broadphase* broadphase, const CollisionPair** pairs);
+void* broadphaseGetUserData(const Broadphase* broadphase, uint32_t proxy);
+void broadphaseQueryRegion(const Broadphase* broadphase, const Bounds2D* region, BroadphaseQueryFunc func, void* context);
+void broadphaseQueryPoint(const Broadphase* broadphase, Coord2D point, BroadphaseQueryFunc func, void* context);
+void broadphaseQueryRay(const Broadphase* broadphase, Coord2D origin, Coord2D direction, float maxDistance, BroadphaseRayFunc func, void* context);
+
+// for implementations
+void broadphaseInit(Broadphase* broadphase, const BroadphaseVtable* vtable);
+void broadphaseDeinit(Broadphase* broadphase);
+bool broadphaseAddPair(Broadphase* broadphase, uint32_t a, uint32_t b);
+bool broadphaseReserve(void** array, uint32_t* capacity, uint32_t needed, size_t elementSize);
+bool broadphaseRayHitsBox(const Bounds2D* box, Coord2D origin, Coord2D direction, float maxDistance);
+bool broadphaseRayEntersBox(const Bounds2D* box, Coord2D origin, Coord2D direction, float maxDistance, float* distance);
+
+/// @brief Whether two boxes overlap; touching counts
+/// @param a 
+/// @param b 
+/// @return 
+inline bool boundsOverlap(const Bounds2D* a, const Bounds2D* b) {
+    return !(a->botRight.x < b->topLeft.x || b->botRight.x < a->topLeft.x ||
+             a->botRight.y < b->topLeft.y || b->botRight.y < a->topLeft.y);
+}
+
+/// @brief Whether the filters of two proxies let them pair
+/// @param a 
+/// @param b 
+/// @return 
+inline bool broadphaseShouldPair(const BroadphaseProxy* a, const BroadphaseProxy* b) {
+    return (a->category & b->mask) != 0 && (b->category & a->mask) != 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,26 @@
+#pragma once
+#include "baseTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ring levels, each with twice the segments of the one before
+#define CIRCLE_RINGS_LEVELS 5
+#define CIRCLE_RINGS_MIN_SEGMENTS 8
+#define CIRCLE_RINGS_MAX_SEGMENTS (CIRCLE_RINGS_MIN_SEGMENTS << (CIRCLE_RINGS_LEVELS - 1))
+
+/// @brief Points evenly spaced around the unit circle, counter clockwise from +X (clockwise
+/// on screen, y down). x[segments] & y[segments] repeat the first point to close the ring
+typedef struct circle_ring_t {
+    uint32_t        segments;
+    const float*    x;
+    const float*    y;
+} CircleRing;
+
+void circleRingsInit();
+const CircleRing* circleRingsForRadius(float radius);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,33 @@
+#pragma once
+#include "baseTypes.h"
+#include "Object.h"
+#include "objmgr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief One contact resolved during the frame's fixed steps
+typedef struct collision_event_t {
+    ObjHandle   a;
+    ObjHandle   b;          // OBJ_INVALID_HANDLE for static geometry, e.g. the field walls
+    Coord2D     point;      // where they touched
+    Coord2D     normal;     // unit length, pointing from b towards a
+    float       impulse;    // momentum exchanged along the normal (mass goes with area)
+} CollisionEvent;
+
+// receives every event of a frame at once, so it can dedupe, rate-limit or coalesce them
+typedef void (*CollisionListenerFunc)(void* context, const CollisionEvent* events, uint32_t count);
+
+void collisionEventsInit(uint32_t maxEvents);
+void collisionEventsShutdown();
+
+bool collisionEventsAddListener(CollisionListenerFunc func, void* context);
+void collisionEventsRemoveListener(CollisionListenerFunc func, void* context);
+
+void collisionEventsPush(const Object* a, const Object* b, Coord2D point, Coord2D normal, float impulse);
+void collisionEventsDispatch();
+
+#ifdef __cplusplus
+}
+#endif
@@ -7,6 +7,8 @@ extern "C" {
 typedef struct face_t Face;
 
 void faceInitTextures();
+void faceInitPool();
+void faceShutdownPool();
 Face* faceNew(Bounds2D box);
 void faceDelete(Face* face);
 
@@ -7,6 +7,9 @@ extern "C" {
 
 typedef struct field_t Field;
 
+void fieldInitPool();
+void fieldShutdownPool();
+
 Field* fieldNew(Bounds2D bounds, uint32_t color);
 void fieldDelete(Field* field);
 
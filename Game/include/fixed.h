@@ -0,0 +1,112 @@
+#pragma once
+#include <math.h>
+#include "baseTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Q16.16 fixed point: 16 integer bits (so magnitudes below 32768) & a resolution of 1/65536
+typedef int32_t Fixed;
+
+#define FIXED_SHIFT 16
+#define FIXED_ONE (1 << FIXED_SHIFT)
+#define FIXED_MAX INT32_MAX
+#define FIXED_MIN (-INT32_MAX)
+
+/// @brief Convert from float, truncating toward zero. Scaling by a power of two is exact, so
+/// the result is the same under any compiler or floating point mode
+/// @param value 
+/// @return 
+inline Fixed fixedFromFloat(float value) {
+    return (Fixed)(value * (float)FIXED_ONE);
+}
+
+/// @brief Convert to float, for drawing & anything else outside the simulation
+/// @param value 
+/// @return 
+inline float fixedToFloat(Fixed value) {
+    return (float)value * (1.0f / (float)FIXED_ONE);
+}
+
+/// @brief Multiply, rounding toward negative infinity
+/// @param a 
+/// @param b 
+/// @return 
+inline Fixed fixedMul(Fixed a, Fixed b) {
+    return (Fixed)(((int64_t)a * (int64_t)b) >> FIXED_SHIFT);
+}
+
+/// @brief Divide, saturating when the quotient doesn't fit (including division by zero)
+/// @param a 
+/// @param b 
+/// @return 
+inline Fixed fixedDiv(Fixed a, Fixed b) {
+    if (b == 0) {
+        return a < 0 ? FIXED_MIN : FIXED_MAX;
+    }
+    int64_t quotient = ((int64_t)a * FIXED_ONE) / b;
+    return quotient > FIXED_MAX ? FIXED_MAX : (quotient < FIXED_MIN ? FIXED_MIN : (Fixed)quotient);
+}
+
+Fixed fixedSqrt(Fixed value);
+
+// Real is the number type the simulation runs on: float by default, or Q16.16 fixed point when
+// GAME_FIXED_POINT is defined. Float results can change with the compiler, optimization level &
+// instruction set; fixed point ones are the same everywhere, for replays & lockstep. + - & the
+// comparisons work on either; everything else goes through the functions below. In fixed point,
+// positions must stay within +/-32767 & speeds well under half that, or sums overflow
+#ifdef GAME_FIXED_POINT
+
+typedef Fixed Real;
+typedef struct
+{
+    Real x;
+    Real y;
+} RealCoord2D;
+
+// a constant; the conversion of a literal is folded at compile time
+#define REAL(value) ((Real)((value) * (float)FIXED_ONE))
+
+inline Real realFromFloat(float value) { return fixedFromFloat(value); }
+inline float realToFloat(Real value) { return fixedToFloat(value); }
+inline Real realMul(Real a, Real b) { return fixedMul(a, b); }
+inline Real realDiv(Real a, Real b) { return fixedDiv(a, b); }
+inline Real realSqrt(Real value) { return fixedSqrt(value); }
+inline Real realAbs(Real value) { return value < 0 ? -value : value; }
+
+#else
+
+typedef float Real;
+typedef Coord2D RealCoord2D;
+
+#define REAL(value) ((Real)(value))
+
+inline Real realFromFloat(float value) { return value; }
+inline float realToFloat(Real value) { return value; }
+inline Real realMul(Real a, Real b) { return a * b; }
+inline Real realDiv(Real a, Real b) { return a / b; }
+inline Real realSqrt(Real value) { return sqrtf(value); }
+inline Real realAbs(Real value) { return fabsf(value); }
+
+#endif
+
+/// @brief Convert a float coordinate into simulation space
+/// @param coord 
+/// @return 
+inline RealCoord2D realCoordFromFloat(Coord2D coord) {
+    RealCoord2D result = { realFromFloat(coord.x), realFromFloat(coord.y) };
+    return result;
+}
+
+/// @brief Convert a simulation coordinate to float
+/// @param coord 
+/// @return 
+inline Coord2D realCoordToFloat(RealCoord2D coord) {
+    Coord2D result = { realToFloat(coord.x), realToFloat(coord.y) };
+    return result;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,6 @@
 #pragma once
 #include "baseTypes.h"
+#include "Object.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -11,6 +12,7 @@ typedef struct leveldef_t {
     uint32_t fieldColor;
     uint32_t numEnemies;
     uint32_t numPlayers;
+    const uint32_t* layerMasks;     // OBJ_LAYER_COUNT collide masks indexed by ObjLayer; NULL for all
 } LevelDef;
 
 typedef struct level_t Level;
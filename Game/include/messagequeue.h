@@ -4,10 +4,11 @@
 #include "Object.h"
 
 #define MAX_BATTLE_MESSAGES 32
+#define MAX_BATTLE_MESSAGE_LENGTH 128
 
 typedef struct BattleMessage
 {
-	char* text;
+	char text[MAX_BATTLE_MESSAGE_LENGTH];	// stored inline, messages can outlive a frame
 	float displayTime; // seconds (0 = wait for input)
 	bool waitForInput;
 	void (*onFinish)(void* userData);
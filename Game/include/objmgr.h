@@ -1,19 +1,43 @@
 #pragma once
 #include "baseTypes.h"
 #include "Object.h"
+#include "broadphase.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-void objMgrInit(uint32_t maxObjects);
+// generational handle: the low bits index a manager slot, the high bits hold the
+// slot's generation, so handles to removed objects stop resolving
+typedef uint32_t ObjHandle;
+#define OBJ_INVALID_HANDLE 0
+#define OBJ_HANDLE_INDEX_BITS 20
+#define OBJ_HANDLE_INDEX_MASK ((1u << OBJ_HANDLE_INDEX_BITS) - 1)
+#define OBJ_HANDLE_GENERATION_MASK (UINT32_MAX >> OBJ_HANDLE_INDEX_BITS)
+
+typedef void (*ObjDestroyFunc)(Object*);
+
+void objMgrInit(uint32_t maxObjects, bool useTransformStore);
 void objMgrShutdown();
 void objMgrAdd(Object* obj);
 void objMgrRemove(Object* obj);
 
+ObjHandle objMgrGetHandle(const Object* obj);
+Object* objMgrResolve(ObjHandle handle);
+void objMgrDestroy(ObjHandle handle, ObjDestroyFunc destroyFunc);
+void objMgrFlush();
+
+bool objMgrWakeIn(Object* obj, uint32_t milliseconds);
+Broadphase* objMgrGetBroadphase();
+
 void objMgrDraw();
 void objMgrUpdate(uint32_t milliseconds);
 void objMgrFixedUpdate(uint32_t milliseconds);
+void objMgrSetFixedStep(uint32_t milliseconds, uint32_t substeps);
+
+// determinism checks
+uint32_t objMgrGetStepCount();
+uint64_t objMgrHashState();
 
 #ifdef __cplusplus
 }
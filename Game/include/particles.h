@@ -0,0 +1,62 @@
+#pragma once
+#include "baseTypes.h"
+#include "Object.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// arrays are aligned & padded so the update kernel can use full 8-wide AVX loads
+#define PARTICLE_ALIGNMENT 32
+#define PARTICLE_LANES 8
+
+/// @brief Shape of one burst of particles thrown off a point
+typedef struct particle_burst_t {
+    uint32_t    count;
+    float       spread;         // radians either side of the normal; PI for a full circle
+    float       minSpeed;       // units per second
+    float       maxSpeed;
+    float       minLife;        // seconds
+    float       maxLife;
+    float       minSize;        // width & height of the quad
+    float       maxSize;
+    uint32_t    color;          // 0xRRGGBB; alpha fades out over each particle's life
+} ParticleBurst;
+
+/// @brief Structure-of-arrays storage for the live particles of one texture. Live particles
+/// are packed at the front; dead ones are swapped out with the last
+typedef struct particle_emitter_t {
+    Object      obj;            // drawn & updated through the object manager
+
+    float*      posX;
+    float*      posY;
+    float*      velX;
+    float*      velY;
+    float*      life;           // seconds left
+    float*      invLifetime;    // 1 / seconds it was born with, to fade by
+    float*      size;
+    uint32_t*   color;
+    uint32_t    count;
+    uint32_t    capacity;
+
+    uint32_t    texture;        // GL texture name; 0 for flat colored quads
+    Coord2D     gravity;        // units per second per second
+    float       drag;           // fraction of velocity lost per second
+    uint32_t    seed;           // own random stream, so effects don't disturb gameplay's
+    uint32_t    dropped;        // particles not spawned because the emitter was full
+} ParticleEmitter;
+
+ParticleEmitter* particleEmitterNew(uint32_t capacity, uint32_t texture, Coord2D gravity, float drag);
+void particleEmitterDelete(ParticleEmitter* emitter);
+
+void particleEmitterBurst(ParticleEmitter* emitter, const ParticleBurst* burst, Coord2D point, Coord2D normal);
+void particleEmitterClear(ParticleEmitter* emitter);
+
+// advance every live particle & pack out the dead, using the widest kernel available
+void particleEmitterUpdate(ParticleEmitter* emitter, float seconds);
+void particleEmitterUpdateScalar(ParticleEmitter* emitter, float seconds);
+void particleEmitterDraw(const ParticleEmitter* emitter);
+
+#ifdef __cplusplus
+}
+#endif
@@ -14,6 +14,9 @@ extern "C" {
 	void playerSetCollideCB(PlayerCollideCB cb);
 	void playerClearCollideCB();
 
+	void playerInitPool();
+	void playerShutdownPool();
+
 	Player* playerNew(Bounds2D bounds, const char* jsonPath);
 	void playerDelete(Player* player);
 
@@ -1,11 +1,14 @@
 #pragma once
 #include "baseTypes.h"
+#include "fixed.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+void randSeed(uint32_t seed);
 float randGetFloat(float min, float max);
+Real randGetReal(float min, float max);
 int32_t randGetInt(int32_t min, int32_t max);
 
 #ifdef __cplusplus
@@ -0,0 +1,128 @@
+#pragma once
+#include "baseTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// sort key layout, most significant first: layer (8 bits), depth (24 bits), material (32 bits)
+#define RENDER_KEY_LAYER_SHIFT 56
+#define RENDER_KEY_DEPTH_SHIFT 32
+#define RENDER_KEY_DEPTH_BITS 24
+
+/// @brief Coarse draw order; everything on a layer draws before anything on the next
+typedef enum render_layer_t {
+    RENDER_LAYER_WORLD = 0,     // field & shapes
+    RENDER_LAYER_SPRITES,
+    RENDER_LAYER_EFFECTS,       // particles
+    RENDER_LAYER_UI,
+    RENDER_LAYER_COUNT
+} RenderLayer;
+
+/// @brief How a texture is sampled between texels
+typedef enum render_filter_t {
+    RENDER_FILTER_NEAREST = 0,
+    RENDER_FILTER_LINEAR
+} RenderFilter;
+
+typedef enum render_command_type_t {
+    RENDER_CMD_CIRCLE = 0,
+    RENDER_CMD_LINE,
+    RENDER_CMD_QUADS,
+    RENDER_CMD_COUNT
+} RenderCommandType;
+
+/// @brief A corner of a textured quad, laid out for GL client arrays
+typedef struct render_vertex_t {
+    float       x, y, z;
+    float       u, v;
+    uint32_t    rgba;       // bytes in r, g, b, a order
+} RenderVertex;
+
+/// @brief One recorded draw
+typedef struct render_command_t {
+    uint32_t    type;       // RenderCommandType
+    uint32_t    rgba;       // bytes in r, g, b, a order; quads carry theirs per vertex
+    union {
+        struct {
+            float   x, y;
+            float   radius;
+            bool    filled;
+        } circle;
+        struct {
+            float   startX, startY;
+            float   endX, endY;
+        } line;
+        struct {
+            uint32_t texture;       // GL texture name; 0 for flat colored quads
+            uint32_t firstVertex;   // into the frame's vertex array
+            uint32_t vertexCount;   // 4 per quad
+        } quads;
+    } params;
+} RenderCommand;
+
+/// @brief A frame's commands as handed to a backend, with the order to run them in
+typedef struct render_frame_t {
+    const RenderCommand*    commands;
+    const uint32_t*         order;          // command indices, sorted by key
+    uint32_t                count;
+    const RenderVertex*     vertices;
+    uint32_t                vertexCount;
+} RenderFrame;
+
+/// @brief What the command buffer recorded over the last frame
+typedef struct render_stats_t {
+    uint32_t    commands;
+    uint32_t    vertices;
+    uint32_t    dropped;    // commands that didn't fit
+} RenderStats;
+
+// backend "virtual" functions
+typedef struct render_backend_t RenderBackend;
+typedef void (*RenderBackendDeleteFunc)(RenderBackend*);
+typedef void (*RenderBackendExecuteFunc)(RenderBackend*, const RenderFrame*);
+typedef uint32_t (*RenderBackendLoadTextureFunc)(RenderBackend*, const char*, uint32_t, RenderFilter);
+
+typedef struct render_backend_vtable_t {
+    RenderBackendDeleteFunc     destroy;
+    RenderBackendExecuteFunc    execute;
+    RenderBackendLoadTextureFunc loadTexture;   // optional; textures load as 0 (untextured) without it
+} RenderBackendVtable;
+
+typedef struct render_backend_t {
+    const RenderBackendVtable*  vtable;
+} RenderBackend;
+
+// backend API
+void renderBackendDelete(RenderBackend* backend);
+
+// command buffer API
+void renderInit(uint32_t maxCommands, uint32_t maxVertices);
+void renderShutdown();
+void renderSetBackend(RenderBackend* backend);
+RenderBackend* renderGetBackend();
+
+void renderBeginFrame();
+void renderEndFrame();
+const RenderStats* renderGetStats();
+uint32_t renderLoadTexture(const char* path, uint32_t soilFlags, RenderFilter filter);
+
+void renderCircle(RenderLayer layer, float depth, float x, float y, float radius, uint32_t rgba, bool filled);
+void renderLine(RenderLayer layer, float depth, float startX, float startY, float endX, float endY, uint32_t rgba);
+RenderVertex* renderQuads(RenderLayer layer, float depth, uint32_t texture, uint32_t vertexCount);
+
+uint64_t renderMakeKey(RenderLayer layer, float depth, uint32_t material);
+
+/// @brief Pack 8 bit color channels the way RenderVertex & RenderCommand hold them
+/// @param r 
+/// @param g 
+/// @param b 
+/// @param a 
+/// @return 
+inline uint32_t renderPackColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    return (uint32_t)r | ((uint32_t)g << 8) | ((uint32_t)b << 16) | ((uint32_t)a << 24);
+}
+
+#ifdef __cplusplus
+}
+#endif
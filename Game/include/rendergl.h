@@ -0,0 +1,13 @@
+#pragma once
+#include "baseTypes.h"
+#include "render.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+RenderBackend* renderGLNew();
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,24 @@
+#pragma once
+#include "baseTypes.h"
+#include "render.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief Running totals of what the null backend was handed
+typedef struct render_null_stats_t {
+    uint32_t    frames;
+    uint64_t    commands;
+    uint64_t    commandsByType[RENDER_CMD_COUNT];
+    uint64_t    vertices;
+    uint64_t    invalid;        // commands that failed validation
+} RenderNullStats;
+
+RenderBackend* renderNullNew();
+const RenderNullStats* renderNullGetStats(const RenderBackend* backend);
+void renderNullResetStats(RenderBackend* backend);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,18 @@
+#pragma once
+#include "baseTypes.h"
+#include "render.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+RenderBackend* renderSoftNew(uint32_t width, uint32_t height);
+void renderSoftSetClearColor(RenderBackend* backend, uint32_t rgba);
+uint32_t renderSoftAddTexture(RenderBackend* backend, const uint8_t* rgba, uint32_t width, uint32_t height, RenderFilter filter);
+
+const uint32_t* renderSoftGetPixels(const RenderBackend* backend, uint32_t* width, uint32_t* height);
+bool renderSoftWritePPM(const RenderBackend* backend, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,26 @@
+#pragma once
+#include "baseTypes.h"
+#include "Object.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief An object found by a scene query
+typedef struct scene_hit_t {
+    Object*     obj;
+    float       distance;   // along the ray to where it enters the object; for point queries,
+                            // from the point to the object's center
+    Coord2D     point;      // where the ray enters the object, or the query point
+} SceneHit;
+
+// queries over every object registered with the object manager that declares bounds. Objects
+// are hit by their exact shape where their type has one (balls are circles), else their bounds
+// box. Hits are written to the caller's array, nearest first, & the count is returned; when
+// there are more than fit, the nearest are kept. Nothing is allocated
+uint32_t sceneRaycast(Coord2D origin, Coord2D direction, float maxDistance, uint32_t mask, SceneHit* hits, uint32_t maxHits);
+uint32_t scenePointQuery(Coord2D point, uint32_t mask, SceneHit* hits, uint32_t maxHits);
+
+#ifdef __cplusplus
+}
+#endif
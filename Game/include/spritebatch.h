@@ -0,0 +1,44 @@
+#pragma once
+#include "baseTypes.h"
+#include "render.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief One textured quad to draw
+typedef struct sprite_t {
+    Coord2D     center;
+    Coord2D     size;
+    Bounds2D    uv;         // texture coords at the top left & bottom right corners
+    float       depth;      // lower draws further back, as glVertex3f z
+    uint32_t    color;      // 0xAARRGGBB, modulating the texture
+    uint32_t    texture;    // GL texture name; 0 for a flat colored quad
+} Sprite;
+
+/// @brief What the batcher has done since the last spriteBatchBegin
+typedef struct sprite_batch_stats_t {
+    uint32_t    sprites;    // quads drawn
+    uint32_t    batches;    // draw calls; one per run of sprites sharing a texture
+    uint32_t    flushes;    // times the queue was sorted & submitted
+} SpriteBatchStats;
+
+// hands one texture's run of quads to the renderer, 4 vertices per quad
+typedef void (*SpriteBatchSubmitFunc)(void* context, uint32_t texture, const RenderVertex* vertices, uint32_t vertexCount);
+
+void spriteBatchInit(uint32_t maxSprites);
+void spriteBatchShutdown();
+void spriteBatchSetSubmit(SpriteBatchSubmitFunc func, void* context);
+
+void spriteBatchBegin();
+void spriteBatchDraw(const Sprite* sprite);
+void spriteBatchFlush();
+void spriteBatchEnd();
+const SpriteBatchStats* spriteBatchGetStats();
+
+// the default submit function, recording each batch into the render command buffer
+void spriteBatchSubmitRender(void* context, uint32_t texture, const RenderVertex* vertices, uint32_t vertexCount);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,29 @@
+#pragma once
+#include "baseTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// each level has 2^TIMER_WHEEL_SLOT_BITS slots, at 1ms per slot on the finest level
+#define TIMER_WHEEL_LEVELS 4
+#define TIMER_WHEEL_SLOT_BITS 6
+#define TIMER_WHEEL_SLOTS (1u << TIMER_WHEEL_SLOT_BITS)
+// longest delay that can be scheduled; longer ones are clamped
+#define TIMER_WHEEL_MAX_DELAY ((1u << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOT_BITS)) - 1)
+
+typedef struct timer_wheel_t TimerWheel;
+
+// called once when a timer expires, with the values it was scheduled with
+typedef void (*TimerFunc)(void* context, uint32_t data);
+
+TimerWheel* timerWheelNew(uint32_t maxTimers);
+void timerWheelDelete(TimerWheel* wheel);
+
+bool timerWheelSchedule(TimerWheel* wheel, uint32_t milliseconds, TimerFunc func, void* context, uint32_t data);
+void timerWheelAdvance(TimerWheel* wheel, uint32_t milliseconds);
+uint32_t timerWheelGetPending(const TimerWheel* wheel);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,40 @@
+#pragma once
+#include "baseTypes.h"
+#include "fixed.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// arrays are aligned & padded so the integrator can use full 8-wide AVX loads
+#define TRANSFORM_ALIGNMENT 32
+#define TRANSFORM_LANES 8
+
+/// @brief Structure-of-arrays storage for object positions, velocities & accelerations
+typedef struct transform_store_t {
+    Real*       posX;
+    Real*       posY;
+    Real*       velX;
+    Real*       velY;
+    Real*       accX;
+    Real*       accY;
+    Real*       prevX;      // position at the start of the current fixed step, for interpolation
+    Real*       prevY;
+    uint32_t    capacity;
+} TransformStore;
+
+TransformStore* transformStoreNew(uint32_t capacity);
+void transformStoreDelete(TransformStore* store);
+
+void transformStoreSet(TransformStore* store, uint32_t index, RealCoord2D pos, RealCoord2D vel, RealCoord2D accel);
+void transformStoreMove(TransformStore* store, uint32_t dstIndex, uint32_t srcIndex);
+void transformStoreSnapshot(TransformStore* store, uint32_t count);
+
+// integrate the first count transforms, using the widest kernel available (fixed point is scalar only)
+void transformIntegrate(TransformStore* store, uint32_t count, float dt);
+void transformIntegrateRange(TransformStore* store, uint32_t begin, uint32_t end, float dt);
+void transformIntegrateScalar(TransformStore* store, uint32_t count, float dt);
+
+#ifdef __cplusplus
+}
+#endif
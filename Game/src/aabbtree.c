@@ -0,0 +1,767 @@
+#include <Windows.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "baseTypes.h"
+#include "aabbtree.h"
+
+// marks a missing parent, child or node
+#define AABB_TREE_NULL UINT32_MAX
+// deepest a query can walk; rotations keep the tree far shallower than this
+#define AABB_TREE_STACK_SIZE 256
+
+/// @brief A node of the tree. Leaves hold one proxy with its box fattened by the margin,
+/// so small moves don't touch the tree; internal nodes hold the union of their children
+typedef struct aabb_node_t {
+    Bounds2D    box;
+    uint32_t    parent;     // next free node while unused
+    uint32_t    child1;
+    uint32_t    child2;     // AABB_TREE_NULL for leaves
+    uint32_t    proxy;      // leaves only
+    uint32_t    height;     // leaves are 0
+} AabbNode;
+
+/// @brief Two subtrees still to be checked against each other while finding pairs; the same
+/// node twice means pairs within that subtree
+typedef struct aabb_node_pair_t {
+    uint32_t    a;
+    uint32_t    b;
+} AabbNodePair;
+
+/// @brief A ray set up for testing against many boxes
+typedef struct aabb_tree_ray_t {
+    float       origin[2];
+    float       invDirection[2];    // unused on an axis the ray runs parallel to
+    bool        parallel[2];
+} AabbTreeRay;
+
+/// @brief A subtree still to be walked by a ray, & where the ray enters it
+typedef struct aabb_tree_ray_entry_t {
+    uint32_t    node;
+    float       distance;
+} AabbTreeRayEntry;
+
+/// @brief Dynamic bounding volume tree. Insertion picks the sibling that grows the tree's
+/// total perimeter least, and every node refit on the way back up may rotate a grandchild
+/// into its place when that makes the boxes tighter, which keeps the tree shallow without
+/// ever rebuilding it
+typedef struct aabb_tree_t {
+    Broadphase      base;
+
+    AabbNode*       nodes;
+    uint32_t        nodeCount;      // high water mark
+    uint32_t        nodeCapacity;
+    uint32_t        freeNode;
+    uint32_t        root;
+
+    uint32_t*       leaves;         // leaf node of each proxy
+    uint32_t        leafCapacity;
+
+    AabbNodePair*   stack;          // pair finding work list
+    uint32_t        stackCapacity;
+
+    float           margin;
+} AabbTree;
+
+// the broadphase vtable for trees
+static void _aabbTreeDelete(Broadphase* broadphase);
+static bool _aabbTreeAdd(Broadphase* broadphase, uint32_t proxy);
+static void _aabbTreeMove(Broadphase* broadphase, uint32_t proxy);
+static void _aabbTreeRemove(Broadphase* broadphase, uint32_t proxy);
+static void _aabbTreeFindPairs(Broadphase* broadphase);
+static void _aabbTreeQueryRegion(const Broadphase* broadphase, const Bounds2D* region, BroadphaseQueryFunc func, void* context);
+static void _aabbTreeQueryRay(const Broadphase* broadphase, Coord2D origin, Coord2D direction, float maxDistance, BroadphaseRayFunc func, void* context);
+static const BroadphaseVtable _aabbTreeVtable = {
+    _aabbTreeDelete,
+    _aabbTreeAdd,
+    _aabbTreeMove,
+    _aabbTreeRemove,
+    _aabbTreeFindPairs,
+    _aabbTreeQueryRegion,
+    _aabbTreeQueryRay
+};
+
+static uint32_t _aabbTreeAllocNode(AabbTree* tree);
+static void _aabbTreeFreeNode(AabbTree* tree, uint32_t node);
+static bool _aabbTreeInsertLeaf(AabbTree* tree, uint32_t leaf);
+static void _aabbTreeRemoveLeaf(AabbTree* tree, uint32_t leaf);
+static void _aabbTreeRefit(AabbTree* tree, uint32_t node);
+static void _aabbTreeRotate(AabbTree* tree, uint32_t node);
+static void _aabbTreeSwap(AabbTree* tree, uint32_t node, uint32_t outer, uint32_t inner);
+static void _aabbTreeUpdateNode(AabbTree* tree, uint32_t node);
+static bool _aabbTreePushPair(AabbTree* tree, uint32_t* count, uint32_t a, uint32_t b);
+static Bounds2D _boundsUnion(const Bounds2D* a, const Bounds2D* b);
+static float _boundsPerimeter(const Bounds2D* box);
+static bool _aabbTreeRayEnters(const AabbTreeRay* ray, const Bounds2D* box, float maxDistance, float* distance);
+static bool _boundsContains(const Bounds2D* outer, const Bounds2D* inner);
+
+/// @brief Create an empty tree broadphase
+/// @param margin how far each proxy's box is fattened on all sides; a proxy that stays
+/// within its fat box when moved costs nothing to update
+/// @return 
+Broadphase* aabbTreeNew(float margin)
+{
+    assert(margin >= 0.0f);
+
+    AabbTree* tree = malloc(sizeof(AabbTree));
+    if (tree != NULL)
+    {
+        ZeroMemory(tree, sizeof(AabbTree));
+        broadphaseInit(&tree->base, &_aabbTreeVtable);
+        tree->freeNode = AABB_TREE_NULL;
+        tree->root = AABB_TREE_NULL;
+        tree->margin = margin;
+    }
+    return (Broadphase*)tree;
+}
+
+/// @brief Free the tree & all of its buffers
+/// @param broadphase 
+static void _aabbTreeDelete(Broadphase* broadphase)
+{
+    AabbTree* tree = (AabbTree*)broadphase;
+
+    broadphaseDeinit(&tree->base);
+    free(tree->nodes);
+    free(tree->leaves);
+    free(tree->stack);
+    free(tree);
+}
+
+/// @brief Insert a leaf for a new proxy
+/// @param broadphase 
+/// @param proxy 
+/// @return false if out of memory
+static bool _aabbTreeAdd(Broadphase* broadphase, uint32_t proxy)
+{
+    AabbTree* tree = (AabbTree*)broadphase;
+    if (!broadphaseReserve((void**)&tree->leaves, &tree->leafCapacity, proxy + 1, sizeof(uint32_t)))
+    {
+        return false;
+    }
+
+    uint32_t leaf = _aabbTreeAllocNode(tree);
+    tree->leaves[proxy] = leaf;
+    if (leaf == AABB_TREE_NULL)
+    {
+        return false;
+    }
+
+    const Bounds2D* box = &tree->base.proxies[proxy].box;
+    AabbNode* node = &tree->nodes[leaf];
+    node->box.topLeft.x = box->topLeft.x - tree->margin;
+    node->box.topLeft.y = box->topLeft.y - tree->margin;
+    node->box.botRight.x = box->botRight.x + tree->margin;
+    node->box.botRight.y = box->botRight.y + tree->margin;
+    node->proxy = proxy;
+    if (!_aabbTreeInsertLeaf(tree, leaf))
+    {
+        // no room for its parent
+        _aabbTreeFreeNode(tree, leaf);
+        tree->leaves[proxy] = AABB_TREE_NULL;
+        return false;
+    }
+    return true;
+}
+
+/// @brief Reinsert a proxy's leaf if it has left its fat box
+/// @param broadphase 
+/// @param proxy 
+static void _aabbTreeMove(Broadphase* broadphase, uint32_t proxy)
+{
+    AabbTree* tree = (AabbTree*)broadphase;
+    uint32_t leaf = tree->leaves[proxy];
+    if (leaf == AABB_TREE_NULL)
+    {
+        return;
+    }
+
+    const Bounds2D* box = &tree->base.proxies[proxy].box;
+    if (_boundsContains(&tree->nodes[leaf].box, box))
+    {
+        return;
+    }
+
+    _aabbTreeRemoveLeaf(tree, leaf);
+    AabbNode* node = &tree->nodes[leaf];
+    node->box.topLeft.x = box->topLeft.x - tree->margin;
+    node->box.topLeft.y = box->topLeft.y - tree->margin;
+    node->box.botRight.x = box->botRight.x + tree->margin;
+    node->box.botRight.y = box->botRight.y + tree->margin;
+    if (!_aabbTreeInsertLeaf(tree, leaf))
+    {
+        _aabbTreeFreeNode(tree, leaf);
+        tree->leaves[proxy] = AABB_TREE_NULL;
+    }
+}
+
+/// @brief Take a proxy's leaf out of the tree
+/// @param broadphase 
+/// @param proxy 
+static void _aabbTreeRemove(Broadphase* broadphase, uint32_t proxy)
+{
+    AabbTree* tree = (AabbTree*)broadphase;
+    uint32_t leaf = tree->leaves[proxy];
+    if (leaf == AABB_TREE_NULL)
+    {
+        return;
+    }
+
+    _aabbTreeRemoveLeaf(tree, leaf);
+    _aabbTreeFreeNode(tree, leaf);
+    tree->leaves[proxy] = AABB_TREE_NULL;
+}
+
+/// @brief Check the tree against itself. Each pair of leaves is met exactly once, at the
+/// node where their paths from the root split, and whole subtrees are skipped as soon as
+/// their boxes are apart
+/// @param broadphase 
+static void _aabbTreeFindPairs(Broadphase* broadphase)
+{
+    AabbTree* tree = (AabbTree*)broadphase;
+    const BroadphaseProxy* proxies = tree->base.proxies;
+    if (tree->root == AABB_TREE_NULL)
+    {
+        return;
+    }
+
+    uint32_t count = 0;
+    _aabbTreePushPair(tree, &count, tree->root, tree->root);
+    while (count > 0)
+    {
+        AabbNodePair work = tree->stack[--count];
+        const AabbNode* a = &tree->nodes[work.a];
+        const AabbNode* b = &tree->nodes[work.b];
+
+        if (work.a == work.b)
+        {
+            if (a->child2 != AABB_TREE_NULL &&
+                (!_aabbTreePushPair(tree, &count, a->child1, a->child1) ||
+                 !_aabbTreePushPair(tree, &count, a->child2, a->child2) ||
+                 !_aabbTreePushPair(tree, &count, a->child1, a->child2)))
+            {
+                return;
+            }
+            continue;
+        }
+
+        if (!boundsOverlap(&a->box, &b->box))
+        {
+            continue;
+        }
+
+        bool aLeaf = a->child2 == AABB_TREE_NULL;
+        bool bLeaf = b->child2 == AABB_TREE_NULL;
+        if (aLeaf && bLeaf)
+        {
+            // the fat boxes meet; report the pair only if the real ones do
+            if (boundsOverlap(&proxies[a->proxy].box, &proxies[b->proxy].box) &&
+                !broadphaseAddPair(&tree->base, a->proxy, b->proxy))
+            {
+                return;
+            }
+            continue;
+        }
+
+        // split the bigger side, so both shrink at a similar rate
+        uint32_t split = work.b;
+        uint32_t keep = work.a;
+        if (bLeaf || (!aLeaf && _boundsPerimeter(&a->box) >= _boundsPerimeter(&b->box)))
+        {
+            split = work.a;
+            keep = work.b;
+        }
+        uint32_t child1 = tree->nodes[split].child1;
+        uint32_t child2 = tree->nodes[split].child2;
+        if (!_aabbTreePushPair(tree, &count, child1, keep) || !_aabbTreePushPair(tree, &count, child2, keep))
+        {
+            return;
+        }
+    }
+}
+
+/// @brief Walk every branch whose box overlaps the region
+/// @param broadphase 
+/// @param region 
+/// @param func 
+/// @param context 
+static void _aabbTreeQueryRegion(const Broadphase* broadphase, const Bounds2D* region, BroadphaseQueryFunc func, void* context)
+{
+    const AabbTree* tree = (const AabbTree*)broadphase;
+    if (tree->root == AABB_TREE_NULL)
+    {
+        return;
+    }
+
+    uint32_t stack[AABB_TREE_STACK_SIZE];
+    uint32_t count = 0;
+    stack[count++] = tree->root;
+    while (count > 0)
+    {
+        const AabbNode* node = &tree->nodes[stack[--count]];
+        if (!boundsOverlap(&node->box, region))
+        {
+            continue;
+        }
+
+        if (node->child2 == AABB_TREE_NULL)
+        {
+            if (boundsOverlap(&tree->base.proxies[node->proxy].box, region) && !func(context, node->proxy))
+            {
+                return;
+            }
+            continue;
+        }
+
+        // tree is deeper than the query stack!
+        assert(count + 2 <= AABB_TREE_STACK_SIZE);
+        if (count + 2 > AABB_TREE_STACK_SIZE)
+        {
+            return;
+        }
+        stack[count++] = node->child1;
+        stack[count++] = node->child2;
+    }
+}
+
+/// @brief Walk every branch the ray passes through, nearest first, clipping the ray as the
+/// callback finds hits. Once a close hit clips it, farther branches are skipped without a test
+/// @param broadphase 
+/// @param origin 
+/// @param direction 
+/// @param maxDistance 
+/// @param func 
+/// @param context 
+static void _aabbTreeQueryRay(const Broadphase* broadphase, Coord2D origin, Coord2D direction, float maxDistance, BroadphaseRayFunc func, void* context)
+{
+    const AabbTree* tree = (const AabbTree*)broadphase;
+    AabbTreeRay ray = { { origin.x, origin.y }, { 0.0f, 0.0f }, { direction.x == 0.0f, direction.y == 0.0f } };
+    ray.invDirection[0] = ray.parallel[0] ? 0.0f : 1.0f / direction.x;
+    ray.invDirection[1] = ray.parallel[1] ? 0.0f : 1.0f / direction.y;
+
+    AabbTreeRayEntry stack[AABB_TREE_STACK_SIZE];
+    uint32_t count = 0;
+    float distance;
+    if (tree->root == AABB_TREE_NULL || !_aabbTreeRayEnters(&ray, &tree->nodes[tree->root].box, maxDistance, &distance))
+    {
+        return;
+    }
+    stack[count].node = tree->root;
+    stack[count++].distance = distance;
+
+    while (count > 0 && maxDistance > 0.0f)
+    {
+        --count;
+        if (stack[count].distance > maxDistance)
+        {
+            // entered beyond where the ray has since been clipped
+            continue;
+        }
+
+        const AabbNode* node = &tree->nodes[stack[count].node];
+        if (node->child2 == AABB_TREE_NULL)
+        {
+            if (_aabbTreeRayEnters(&ray, &tree->base.proxies[node->proxy].box, maxDistance, &distance))
+            {
+                maxDistance = func(context, node->proxy, maxDistance);
+            }
+            continue;
+        }
+
+        float distance1;
+        float distance2;
+        bool hit1 = _aabbTreeRayEnters(&ray, &tree->nodes[node->child1].box, maxDistance, &distance1);
+        bool hit2 = _aabbTreeRayEnters(&ray, &tree->nodes[node->child2].box, maxDistance, &distance2);
+
+        // tree is deeper than the query stack!
+        assert(count + 2 <= AABB_TREE_STACK_SIZE);
+        if (count + 2 > AABB_TREE_STACK_SIZE)
+        {
+            return;
+        }
+
+        // push the farther child first, so the nearer is walked first
+        uint32_t nearChild = node->child1;
+        uint32_t farChild = node->child2;
+        if (hit1 && hit2 && distance2 < distance1)
+        {
+            nearChild = node->child2;
+            farChild = node->child1;
+            distance = distance1;
+            distance1 = distance2;
+            distance2 = distance;
+        }
+        else if (!hit1)
+        {
+            nearChild = node->child2;
+            distance1 = distance2;
+            hit1 = hit2;
+            hit2 = false;
+        }
+        if (hit2)
+        {
+            stack[count].node = farChild;
+            stack[count++].distance = distance2;
+        }
+        if (hit1)
+        {
+            stack[count].node = nearChild;
+            stack[count++].distance = distance1;
+        }
+    }
+}
+
+/// @brief Take a node off the free list, or grow the node array
+/// @param tree 
+/// @return AABB_TREE_NULL if out of memory
+static uint32_t _aabbTreeAllocNode(AabbTree* tree)
+{
+    uint32_t node = tree->freeNode;
+    if (node != AABB_TREE_NULL)
+    {
+        tree->freeNode = tree->nodes[node].parent;
+    }
+    else
+    {
+        if (!broadphaseReserve((void**)&tree->nodes, &tree->nodeCapacity, tree->nodeCount + 1, sizeof(AabbNode)))
+        {
+            return AABB_TREE_NULL;
+        }
+        node = tree->nodeCount++;
+    }
+
+    tree->nodes[node].parent = AABB_TREE_NULL;
+    tree->nodes[node].child1 = AABB_TREE_NULL;
+    tree->nodes[node].child2 = AABB_TREE_NULL;
+    tree->nodes[node].proxy = BROADPHASE_INVALID_PROXY;
+    tree->nodes[node].height = 0;
+    return node;
+}
+
+/// @brief Return a node to the free list
+/// @param tree 
+/// @param node 
+static void _aabbTreeFreeNode(AabbTree* tree, uint32_t node)
+{
+    tree->nodes[node].parent = tree->freeNode;
+    tree->freeNode = node;
+}
+
+/// @brief Link a leaf into the tree next to the sibling that adds the least perimeter, counting
+/// the growth of every ancestor on the way down
+/// @param tree 
+/// @param leaf 
+/// @return false if out of memory; the leaf is left unlinked
+static bool _aabbTreeInsertLeaf(AabbTree* tree, uint32_t leaf)
+{
+    if (tree->root == AABB_TREE_NULL)
+    {
+        tree->root = leaf;
+        tree->nodes[leaf].parent = AABB_TREE_NULL;
+        return true;
+    }
+
+    // this can grow the node array, so only take pointers after it
+    uint32_t parent = _aabbTreeAllocNode(tree);
+    if (parent == AABB_TREE_NULL)
+    {
+        return false;
+    }
+
+    AabbNode* nodes = tree->nodes;
+    Bounds2D leafBox = nodes[leaf].box;
+    uint32_t sibling = tree->root;
+    while (nodes[sibling].child2 != AABB_TREE_NULL)
+    {
+        const AabbNode* node = &nodes[sibling];
+        Bounds2D combined = _boundsUnion(&node->box, &leafBox);
+        float combinedPerimeter = _boundsPerimeter(&combined);
+
+        // cost of pairing with this node, & what every option below pays for growing it
+        float cost = 2.0f * combinedPerimeter;
+        float inherited = 2.0f * (combinedPerimeter - _boundsPerimeter(&node->box));
+
+        float childCost[2];
+        const uint32_t children[2] = { node->child1, node->child2 };
+        for (uint32_t c = 0; c < 2; ++c)
+        {
+            const AabbNode* child = &nodes[children[c]];
+            Bounds2D grown = _boundsUnion(&child->box, &leafBox);
+            childCost[c] = _boundsPerimeter(&grown) + inherited;
+            if (child->child2 != AABB_TREE_NULL)
+            {
+                // an internal child only pays for its growth; its own box is paid for already
+                childCost[c] -= _boundsPerimeter(&child->box);
+            }
+        }
+
+        if (cost < childCost[0] && cost < childCost[1])
+        {
+            break;
+        }
+        sibling = childCost[0] <= childCost[1] ? children[0] : children[1];
+    }
+
+    // the new parent takes the sibling's place, with the sibling & leaf under it
+    uint32_t oldParent = nodes[sibling].parent;
+    nodes[parent].parent = oldParent;
+    nodes[parent].child1 = sibling;
+    nodes[parent].child2 = leaf;
+    nodes[sibling].parent = parent;
+    nodes[leaf].parent = parent;
+    if (oldParent == AABB_TREE_NULL)
+    {
+        tree->root = parent;
+    }
+    else if (nodes[oldParent].child1 == sibling)
+    {
+        nodes[oldParent].child1 = parent;
+    }
+    else
+    {
+        nodes[oldParent].child2 = parent;
+    }
+
+    _aabbTreeRefit(tree, parent);
+    return true;
+}
+
+/// @brief Unlink a leaf; its sibling takes the place of their parent
+/// @param tree 
+/// @param leaf 
+static void _aabbTreeRemoveLeaf(AabbTree* tree, uint32_t leaf)
+{
+    AabbNode* nodes = tree->nodes;
+    if (leaf == tree->root)
+    {
+        tree->root = AABB_TREE_NULL;
+        return;
+    }
+
+    uint32_t parent = nodes[leaf].parent;
+    uint32_t grandParent = nodes[parent].parent;
+    uint32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    nodes[sibling].parent = grandParent;
+    if (grandParent == AABB_TREE_NULL)
+    {
+        tree->root = sibling;
+    }
+    else
+    {
+        if (nodes[grandParent].child1 == parent)
+        {
+            nodes[grandParent].child1 = sibling;
+        }
+        else
+        {
+            nodes[grandParent].child2 = sibling;
+        }
+        _aabbTreeRefit(tree, grandParent);
+    }
+
+    _aabbTreeFreeNode(tree, parent);
+    nodes[leaf].parent = AABB_TREE_NULL;
+}
+
+/// @brief Recompute boxes & heights from a node up to the root, rotating where it helps
+/// @param tree 
+/// @param node 
+static void _aabbTreeRefit(AabbTree* tree, uint32_t node)
+{
+    while (node != AABB_TREE_NULL)
+    {
+        _aabbTreeUpdateNode(tree, node);
+        _aabbTreeRotate(tree, node);
+        node = tree->nodes[node].parent;
+    }
+}
+
+/// @brief Try swapping one child of a node with a grandchild under the other child. The node's
+/// own box can't change, but the child that gains a new subtree can end up smaller; take the
+/// swap that shrinks it the most, if any
+/// @param tree 
+/// @param node 
+static void _aabbTreeRotate(AabbTree* tree, uint32_t node)
+{
+    const AabbNode* nodes = tree->nodes;
+    if (nodes[node].height < 2)
+    {
+        return;
+    }
+
+    uint32_t bestOuter = AABB_TREE_NULL;
+    uint32_t bestInner = AABB_TREE_NULL;
+    float bestGain = 0.0f;
+
+    const uint32_t children[2] = { nodes[node].child1, nodes[node].child2 };
+    for (uint32_t c = 0; c < 2; ++c)
+    {
+        const AabbNode* inner = &nodes[children[c]];
+        const AabbNode* outer = &nodes[children[1 - c]];
+        if (inner->child2 == AABB_TREE_NULL)
+        {
+            continue;
+        }
+
+        float perimeter = _boundsPerimeter(&inner->box);
+        const uint32_t grandChildren[2] = { inner->child1, inner->child2 };
+        for (uint32_t g = 0; g < 2; ++g)
+        {
+            // outer moves down, taking the place of grandChildren[g], which moves up
+            const AabbNode* stays = &nodes[grandChildren[1 - g]];
+            Bounds2D rotated = _boundsUnion(&outer->box, &stays->box);
+            float gain = perimeter - _boundsPerimeter(&rotated);
+            if (gain > bestGain)
+            {
+                bestGain = gain;
+                bestOuter = children[1 - c];
+                bestInner = grandChildren[g];
+            }
+        }
+    }
+
+    if (bestOuter != AABB_TREE_NULL)
+    {
+        _aabbTreeSwap(tree, node, bestOuter, bestInner);
+    }
+}
+
+/// @brief Exchange a child of node with a grandchild under its other child
+/// @param tree 
+/// @param node 
+/// @param outer child of node
+/// @param inner grandchild of node, not under outer
+static void _aabbTreeSwap(AabbTree* tree, uint32_t node, uint32_t outer, uint32_t inner)
+{
+    AabbNode* nodes = tree->nodes;
+    uint32_t middle = nodes[inner].parent;
+
+    if (nodes[node].child1 == outer)
+    {
+        nodes[node].child1 = inner;
+    }
+    else
+    {
+        nodes[node].child2 = inner;
+    }
+    if (nodes[middle].child1 == inner)
+    {
+        nodes[middle].child1 = outer;
+    }
+    else
+    {
+        nodes[middle].child2 = outer;
+    }
+    nodes[inner].parent = node;
+    nodes[outer].parent = middle;
+
+    _aabbTreeUpdateNode(tree, middle);
+    _aabbTreeUpdateNode(tree, node);
+}
+
+/// @brief Recompute an internal node's box & height from its children
+/// @param tree 
+/// @param node 
+static void _aabbTreeUpdateNode(AabbTree* tree, uint32_t node)
+{
+    AabbNode* nodes = tree->nodes;
+    const AabbNode* child1 = &nodes[nodes[node].child1];
+    const AabbNode* child2 = &nodes[nodes[node].child2];
+
+    nodes[node].box = _boundsUnion(&child1->box, &child2->box);
+    nodes[node].height = 1 + (child1->height > child2->height ? child1->height : child2->height);
+}
+
+/// @brief Add to the pair finding work list
+/// @param tree 
+/// @param count 
+/// @param a 
+/// @param b 
+/// @return false if the list could not grow
+static bool _aabbTreePushPair(AabbTree* tree, uint32_t* count, uint32_t a, uint32_t b)
+{
+    if (!broadphaseReserve((void**)&tree->stack, &tree->stackCapacity, *count + 1, sizeof(AabbNodePair)))
+    {
+        return false;
+    }
+
+    tree->stack[*count].a = a;
+    tree->stack[*count].b = b;
+    ++*count;
+    return true;
+}
+
+/// @brief Smallest box containing both
+/// @param a 
+/// @param b 
+/// @return 
+static Bounds2D _boundsUnion(const Bounds2D* a, const Bounds2D* b)
+{
+    Bounds2D box;
+    box.topLeft.x = a->topLeft.x < b->topLeft.x ? a->topLeft.x : b->topLeft.x;
+    box.topLeft.y = a->topLeft.y < b->topLeft.y ? a->topLeft.y : b->topLeft.y;
+    box.botRight.x = a->botRight.x > b->botRight.x ? a->botRight.x : b->botRight.x;
+    box.botRight.y = a->botRight.y > b->botRight.y ? a->botRight.y : b->botRight.y;
+    return box;
+}
+
+/// @brief Perimeter of a box; the 2D stand-in for surface area when costing the tree
+/// @param box 
+/// @return 
+static float _boundsPerimeter(const Bounds2D* box)
+{
+    return 2.0f * ((box->botRight.x - box->topLeft.x) + (box->botRight.y - box->topLeft.y));
+}
+
+/// @brief Whether inner lies entirely within outer
+/// @param outer 
+/// @param inner 
+/// @return 
+static bool _boundsContains(const Bounds2D* outer, const Bounds2D* inner)
+{
+    return outer->topLeft.x <= inner->topLeft.x && outer->topLeft.y <= inner->topLeft.y &&
+           inner->botRight.x <= outer->botRight.x && inner->botRight.y <= outer->botRight.y;
+}
+
+/// @brief Slab test against a prepared ray
+/// @param ray 
+/// @param box 
+/// @param maxDistance 
+/// @param distance set to where the ray enters the box, or 0 if it starts inside
+/// @return true if the ray enters the box before maxDistance
+static bool _aabbTreeRayEnters(const AabbTreeRay* ray, const Bounds2D* box, float maxDistance, float* distance)
+{
+    float tMin = 0.0f;
+    float tMax = maxDistance;
+
+    const float lo[2] = { box->topLeft.x, box->topLeft.y };
+    const float hi[2] = { box->botRight.x, box->botRight.y };
+    for (uint32_t axis = 0; axis < 2; ++axis)
+    {
+        if (ray->parallel[axis])
+        {
+            if (ray->origin[axis] < lo[axis] || ray->origin[axis] > hi[axis])
+            {
+                return false;
+            }
+            continue;
+        }
+
+        float t0 = (lo[axis] - ray->origin[axis]) * ray->invDirection[axis];
+        float t1 = (hi[axis] - ray->origin[axis]) * ray->invDirection[axis];
+        if (t0 > t1)
+        {
+            float t = t0;
+            t0 = t1;
+            t1 = t;
+        }
+        tMin = t0 > tMin ? t0 : tMin;
+        tMax = t1 < tMax ? t1 : tMax;
+        if (tMin > tMax)
+        {
+            return false;
+        }
+    }
+    *distance = tMin;
+    return true;
+}
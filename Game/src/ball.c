@@ -1,4 +1,6 @@
 #include <stdlib.h>
+#include <math.h>
+#include <assert.h>
 
 #include "baseTypes.h"
 #include "shape.h"
@@ -6,64 +8,170 @@
 #include "random.h"
 #include "field.h"
 #include "Object.h"
+#include "pool.h"
+#include "spatialgrid.h"
+#include "sweepprune.h"
+#include "aabbtree.h"
+#include "collisionevents.h"
+#include "fixed.h"
 
 typedef struct ball_t {
 	Object obj;
 
 	Bounds2D bounds;
 	uint32_t color;
-	float radius;
+	Real radius;
+	uint32_t proxy;
+
+	// the straight line the ball follows for the rest of the fixed step: it is at pathStart
+	// pathTime into the step, & moves at its current velocity from there
+	RealCoord2D pathStart;
+	Real pathTime;
 } Ball;
 
 // the object vtable for all balls
-static void _ballUpdate(Object* obj, uint32_t milliseconds);
-static void _ballDraw(Object* obj);
+static void _ballFixedUpdate(Object* obj, float seconds);
+static void _ballDraw(Object* obj, float alpha);
+static void _ballDrawBatch(Object** objs, uint32_t count, float alpha);
+static void _ballFixedUpdateBatch(Object** objs, uint32_t count, float seconds);
+static void _ballGetBounds(const Object* obj, Bounds2D* box);
+static void _ballSetBox(Bounds2D* box, RealCoord2D from, RealCoord2D to, Real radius);
+static bool _ballRaycast(const Object* obj, Coord2D origin, Coord2D direction, float maxDistance, float* distance);
 static ObjVtable _ballVtable = {
 	_ballDraw,
-	_ballUpdate
+	NULL,
+	_ballFixedUpdate,
+	NULL,
+	_ballDrawBatch,
+	NULL,
+	_ballFixedUpdateBatch,
+	_ballGetBounds,
+	_ballRaycast,
+	0,
+	OBJ_LAYER_BALL
 };
 
-// storage for a collision callback
-static BallCollideCB _ballCollideCB = NULL;
+// all balls are allocated from here, so they sit next to each other in memory
+static Pool* _ballPool = NULL;
+static const uint32_t BALLS_PER_CHUNK = 64;
+
+// broadphase for ball vs ball collisions; define BALL_USE_SWEEP_PRUNE to swap the grid for
+// sweep & prune, which does less work per step while balls keep their neighbours, or
+// BALL_USE_AABB_TREE for a bounding volume tree. ballSetBroadphase overrides it at runtime
+static Broadphase* _ballBroadphase = NULL;
+#if defined(BALL_USE_SWEEP_PRUNE)
+static BallBroadphase _ballBroadphaseType = BALL_BROADPHASE_SWEEP_PRUNE;
+#elif defined(BALL_USE_AABB_TREE)
+static BallBroadphase _ballBroadphaseType = BALL_BROADPHASE_AABB_TREE;
+#else
+static BallBroadphase _ballBroadphaseType = BALL_BROADPHASE_GRID;
+#endif
+// the diameter of the largest ball, so most balls touch no more than 4 cells
+static const float BALL_GRID_CELL_SIZE = 100.0f;
+// how far a ball can move before its tree leaf is reinserted
+static const float BALL_TREE_MARGIN = 8.0f;
+// most wall bounces resolved within one step; only reached in a corner at extreme speed
+static const uint32_t BALL_MAX_BOUNCES = 8;
 
 // other private methods
 static void _ballSetRandomColor(Ball* ball);
-static void _ballDoCollisions(Ball* ball);
-static void _ballCollideField(Ball* ball);
-static void _ballTriggerCollideCB(Ball* ball);
+static void _ballStartPath(Ball* ball, float seconds);
+static void _ballCollideField(Ball* ball, float seconds);
+static void _ballCollideBalls(Ball** balls, uint32_t count, float seconds);
+static bool _ballSweepContact(Ball* a, Ball* b, float seconds);
+static void _ballResolveContact(Ball* a, Ball* b, float seconds);
+static float _ballExchangeMomentum(const Ball* a, const Ball* b, Real nx, Real ny, RealCoord2D* velA, RealCoord2D* velB);
+static void _ballPushWallEvent(const Ball* ball, const Real* p, uint32_t axis, Real speed);
+static void _ballPushBallEvent(const Ball* a, const Ball* b, RealCoord2D posA, Real nx, Real ny, float impulse);
+
+/// @brief One time creation of the ball pool & collision broadphase
+void ballInitPool()
+{
+	if (_ballPool == NULL)
+	{
+		_ballPool = POOL_NEW(Ball, BALLS_PER_CHUNK);
+		assert(_ballPool != NULL);
+	}
+	if (_ballBroadphase == NULL)
+	{
+		switch (_ballBroadphaseType)
+		{
+		case BALL_BROADPHASE_SWEEP_PRUNE:
+			_ballBroadphase = sweepPruneNew();
+			break;
+		case BALL_BROADPHASE_AABB_TREE:
+			_ballBroadphase = aabbTreeNew(BALL_TREE_MARGIN);
+			break;
+		default:
+			_ballBroadphase = spatialGridNew(BALL_GRID_CELL_SIZE);
+			break;
+		}
+		assert(_ballBroadphase != NULL);
+	}
+}
 
-/// @brief Sets the callback
-/// @param cb 
-void ballSetCollideCB(BallCollideCB cb)
+/// @brief Choose the broadphase for ball vs ball collisions, e.g. to benchmark them against
+/// each other. Takes effect the next time the pool & broadphase are created
+/// @param type 
+void ballSetBroadphase(BallBroadphase type)
 {
-	_ballCollideCB = cb;
+	// the current broadphase is kept until ballShutdownPool!
+	assert(_ballBroadphase == NULL);
+	_ballBroadphaseType = type;
 }
 
-/// @brief Clears the callback
-void ballClearCollideCB()
+/// @brief Release the ball pool & collision broadphase; all balls must have been deleted
+void ballShutdownPool()
 {
-	_ballCollideCB = NULL;
+	poolDelete(_ballPool);
+	_ballPool = NULL;
+	broadphaseDelete(_ballBroadphase);
+	_ballBroadphase = NULL;
 }
 
-/// @brief Instantiate and initialize a ball object
+/// @brief Instantiate and initialize a ball object, in the middle of its bounds
 /// @param bounds 
 /// @return 
 Ball* ballNew(Bounds2D bounds)
 {
-	const float MAX_VEL = 5.0f;
+	return ballNewAt(bounds, boundsGetCenter(&bounds));
+}
+
+/// @brief Instantiate and initialize a ball object at a given point
+/// @param bounds the field the ball bounces around in
+/// @param pos 
+/// @return 
+Ball* ballNewAt(Bounds2D bounds, Coord2D pos)
+{
+	// units per second; 5 per step at the original 30Hz step
+	const float MAX_VEL = 150.0f;
 	const float MIN_RADIUS = 10.0f;
 	const float MAX_RADIUS = 50.0f;
 
-	Ball* ball = malloc(sizeof(Ball));
+	Ball* ball = POOL_ALLOC(_ballPool, Ball);
 	if (ball != NULL)
 	{
-		Coord2D pos = boundsGetCenter(&bounds);
-		Coord2D vel = { randGetFloat(-MAX_VEL, MAX_VEL), randGetFloat(-MAX_VEL, MAX_VEL) };
-		objInit(&ball->obj, &_ballVtable, pos, vel);
-
+		// size first, so the bounds are valid when the object registers
 		ball->bounds = bounds;
-		ball->radius = randGetFloat(MIN_RADIUS, MAX_RADIUS);
+		ball->radius = randGetReal(MIN_RADIUS, MAX_RADIUS);
 		_ballSetRandomColor(ball);
+
+		Coord2D still = { 0.0f, 0.0f };
+		RealCoord2D vel = { randGetReal(-MAX_VEL, MAX_VEL), randGetReal(-MAX_VEL, MAX_VEL) };
+		objInit(&ball->obj, &_ballVtable, pos, still);
+		objSetRealVelocity(&ball->obj, vel);
+
+		ball->proxy = BROADPHASE_INVALID_PROXY;
+		if (_ballBroadphase != NULL)
+		{
+			Bounds2D box;
+			_ballGetBounds(&ball->obj, &box);
+			ball->proxy = broadphaseAdd(_ballBroadphase, &box, ball);
+			if (ball->proxy != BROADPHASE_INVALID_PROXY)
+			{
+				broadphaseSetFilter(_ballBroadphase, ball->proxy, ball->obj.category, ball->obj.collideMask);
+			}
+		}
 	}
 	return ball;
 }
@@ -72,9 +180,13 @@ Ball* ballNew(Bounds2D bounds)
 /// @param ball 
 void ballDelete(Ball* ball)
 {
+	if (_ballBroadphase != NULL && ball->proxy != BROADPHASE_INVALID_PROXY)
+	{
+		broadphaseRemove(_ballBroadphase, ball->proxy);
+	}
 	objDeinit(&ball->obj);
 
-	free(ball);
+	poolFree(_ballPool, ball);
 }
 
 /// @brief Sets the color of the ball to a random RGB
@@ -86,17 +198,18 @@ static void _ballSetRandomColor(Ball* ball)
 	ball->color += randGetInt(0, 256) << 16;
 }
 
-/// @brief Mainly process ball collisions
+/// @brief Move & process ball collisions, once per fixed step
 /// @param obj 
-/// @param milliseconds 
-static void _ballUpdate(Object* obj, uint32_t milliseconds)
+/// @param seconds 
+static void _ballFixedUpdate(Object* obj, float seconds)
 {
-	objDefaultUpdate(obj, milliseconds);
+	objDefaultUpdate(obj, seconds);
 
-	_ballDoCollisions((Ball*)obj);
+	_ballStartPath((Ball*)obj, seconds);
+	_ballCollideField((Ball*)obj, seconds);
 }
 
-static void _ballDraw(Object* obj)
+static void _ballDraw(Object* obj, float alpha)
 {
 	Ball* ball = (Ball*)obj;
 
@@ -105,58 +218,508 @@ static void _ballDraw(Object* obj)
 	uint8_t blue = (uint8_t)((ball->color >> 0) & 0xFF);
 	bool filledVal = true;
 
-	shapeDrawCircle(ball->radius, ball->obj.position.x, ball->obj.position.y, red, green, blue, filledVal);
+	Coord2D pos = objGetDrawPosition(obj, alpha);
+	shapeDrawCircle(realToFloat(ball->radius), pos.x, pos.y, red, green, blue, filledVal);
 }
 
-static void _ballDoCollisions(Ball* ball)
+/// @brief Draw every ball in the span with direct (inlinable) calls
+/// @param objs 
+/// @param count 
+/// @param alpha 
+static void _ballDrawBatch(Object** objs, uint32_t count, float alpha)
 {
-	_ballCollideField(ball);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		if (objs[i] != NULL)
+		{
+			_ballDraw(objs[i], alpha);
+		}
+	}
 }
 
-static void _ballCollideField(Ball* ball)
+/// @brief Move every ball in the span & collide them with each other, then with the field.
+/// The walls go last since they can't give way, so no ball ends the step outside
+/// @param objs 
+/// @param count 
+/// @param seconds 
+static void _ballFixedUpdateBatch(Object** objs, uint32_t count, float seconds)
 {
-	float rightSide = ball->bounds.botRight.x;
-	float leftSide = ball->bounds.topLeft.x;
-	float topSide = ball->bounds.topLeft.y;
-	float bottomSide = ball->bounds.botRight.y;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		if (objs[i] != NULL)
+		{
+			objDefaultUpdate(objs[i], seconds);
+			_ballStartPath((Ball*)objs[i], seconds);
+		}
+	}
 
-	if(ball->obj.position.x - ball->radius <= leftSide  )
+	_ballCollideBalls((Ball**)objs, count, seconds);
+
+	for (uint32_t i = 0; i < count; ++i)
 	{
-		ball->obj.velocity.x = -ball->obj.velocity.x;
-		ball->obj.position.x = leftSide + ball->radius;
-		_ballSetRandomColor(ball);
-		_ballTriggerCollideCB(ball);
+		if (objs[i] != NULL)
+		{
+			_ballCollideField((Ball*)objs[i], seconds);
+		}
+	}
+}
+
+/// @brief Record the path the step just integrated, before any collision changes the ball's
+/// position or velocity. Integration moved it in a straight line at its current velocity, so
+/// walking back along that gives where it started
+/// @param ball 
+/// @param seconds length of the step just integrated
+static void _ballStartPath(Ball* ball, float seconds)
+{
+	RealCoord2D pos = objGetRealPosition(&ball->obj);
+	RealCoord2D vel = objGetRealVelocity(&ball->obj);
+	Real dt = realFromFloat(seconds);
+	ball->pathStart.x = pos.x - realMul(vel.x, dt);
+	ball->pathStart.y = pos.y - realMul(vel.y, dt);
+	ball->pathTime = 0;
+}
+
+/// @brief Sweep the ball along what's left of this step's path, bouncing off the field walls
+/// at the moment it reaches them, as many times as the step holds. Moving after the fact &
+/// then testing for overlap lets a fast ball pass clean through a wall within one step
+/// @param ball 
+/// @param seconds length of the step just integrated
+static void _ballCollideField(Ball* ball, float seconds)
+{
+	RealCoord2D vel = objGetRealVelocity(&ball->obj);
+	Real dt = realFromFloat(seconds);
+
+	// the center has to stay within the field shrunk by the radius
+	Real lo[2] = { realFromFloat(ball->bounds.topLeft.x) + ball->radius, realFromFloat(ball->bounds.topLeft.y) + ball->radius };
+	Real hi[2] = { realFromFloat(ball->bounds.botRight.x) - ball->radius, realFromFloat(ball->bounds.botRight.y) - ball->radius };
+
+	// start from where the path was last set, by integration or a bounce off another ball;
+	// paths that start outside the field start from its edge
+	Real p[2] = { ball->pathStart.x, ball->pathStart.y };
+	Real v[2] = { vel.x, vel.y };
+	uint32_t hits = 0;
+	bool clamped = false;
+	for (uint32_t axis = 0; axis < 2; ++axis)
+	{
+		if (hi[axis] < lo[axis])
+		{
+			// bigger than the field; pin it to the middle
+			lo[axis] = hi[axis] = (lo[axis] + hi[axis]) / 2;
+		}
+		if (p[axis] < lo[axis])
+		{
+			p[axis] = lo[axis];
+			clamped = true;
+			if (v[axis] < 0)
+			{
+				_ballPushWallEvent(ball, p, axis, v[axis]);
+				v[axis] = -v[axis];
+				++hits;
+			}
+		}
+		else if (p[axis] > hi[axis])
+		{
+			p[axis] = hi[axis];
+			clamped = true;
+			if (v[axis] > 0)
+			{
+				_ballPushWallEvent(ball, p, axis, v[axis]);
+				v[axis] = -v[axis];
+				++hits;
+			}
+		}
 	}
-	if(ball->obj.position.x + ball->radius >= rightSide  )
+
+	Real remaining = dt - ball->pathTime;
+	for (uint32_t bounce = 0; bounce < BALL_MAX_BOUNCES && remaining > 0; ++bounce)
 	{
-		ball->obj.velocity.x = -ball->obj.velocity.x;
-		ball->obj.position.x = rightSide - ball->radius;
-		_ballSetRandomColor(ball);
-		_ballTriggerCollideCB(ball);
+		// earliest wall reached within what's left of the step; both axes at once is a corner
+		Real toi = remaining;
+		uint32_t axesHit = 0;
+		for (uint32_t axis = 0; axis < 2; ++axis)
+		{
+			if (v[axis] == 0)
+			{
+				continue;
+			}
+			Real wall = v[axis] > 0 ? hi[axis] : lo[axis];
+			Real t = realDiv(wall - p[axis], v[axis]);
+			t = t > 0 ? t : 0;
+			if (t < toi)
+			{
+				toi = t;
+				axesHit = 1u << axis;
+			}
+			else if (t == toi)
+			{
+				axesHit |= 1u << axis;
+			}
+		}
+
+		p[0] += realMul(v[0], toi);
+		p[1] += realMul(v[1], toi);
+		remaining -= toi;
+		if (axesHit == 0)
+		{
+			break;
+		}
+
+		for (uint32_t axis = 0; axis < 2; ++axis)
+		{
+			if (axesHit & (1u << axis))
+			{
+				p[axis] = v[axis] > 0 ? hi[axis] : lo[axis];
+				_ballPushWallEvent(ball, p, axis, v[axis]);
+				v[axis] = -v[axis];
+				++hits;
+			}
+		}
 	}
-	if(ball->obj.position.y + ball->radius >= bottomSide  )
+
+	if (hits == 0 && !clamped)
 	{
-		ball->obj.velocity.y = -ball->obj.velocity.y;
-		ball->obj.position.y = bottomSide - ball->radius;
-		_ballSetRandomColor(ball);
-		_ballTriggerCollideCB(ball);
+		// the straight path never reached a wall; the integrated position stands
+		return;
+	}
+
+	// out of bounces with time left over; finish the step, but stay inside
+	for (uint32_t axis = 0; axis < 2; ++axis)
+	{
+		p[axis] += realMul(v[axis], remaining);
+		p[axis] = p[axis] < lo[axis] ? lo[axis] : (p[axis] > hi[axis] ? hi[axis] : p[axis]);
 	}
-	if(ball->obj.position.y - ball->radius <= topSide  )
+
+	RealCoord2D endPos = { p[0], p[1] };
+	RealCoord2D endVel = { v[0], v[1] };
+	objSetRealPosition(&ball->obj, endPos);
+	objSetRealVelocity(&ball->obj, endVel);
+	for (uint32_t i = 0; i < hits; ++i)
 	{
-		ball->obj.velocity.y = -ball->obj.velocity.y;
-		ball->obj.position.y = topSide + ball->radius;
 		_ballSetRandomColor(ball);
-		_ballTriggerCollideCB(ball);
 	}
 }
 
-/// @brief Triggers the callback, if one is registered
+/// @brief Report a bounce off one of the field walls
 /// @param ball 
-static void _ballTriggerCollideCB(Ball* ball)
+/// @param p center of the ball as it reaches the wall
+/// @param axis 0 for a side wall, 1 for the top or bottom
+/// @param speed velocity along the axis, before the bounce
+static void _ballPushWallEvent(const Ball* ball, const Real* p, uint32_t axis, Real speed)
 {
-	if (_ballCollideCB != NULL)
+	// the normal points back into the field, the contact is on the rim of the ball facing the wall
+	float sign = speed > 0 ? -1.0f : 1.0f;
+	float radius = realToFloat(ball->radius);
+	Coord2D normal = { axis == 0 ? sign : 0.0f, axis == 1 ? sign : 0.0f };
+	Coord2D point = { realToFloat(p[0]) - normal.x * radius, realToFloat(p[1]) - normal.y * radius };
+	float impulse = 2.0f * fabsf(realToFloat(speed)) * radius * radius;
+	collisionEventsPush(&ball->obj, NULL, point, normal, impulse);
+}
+
+/// @brief Report a bounce between two balls
+/// @param a 
+/// @param b 
+/// @param posA a's center at the moment of contact
+/// @param nx contact normal from a to b
+/// @param ny 
+/// @param impulse 
+static void _ballPushBallEvent(const Ball* a, const Ball* b, RealCoord2D posA, Real nx, Real ny, float impulse)
+{
+	Coord2D point = { realToFloat(posA.x + realMul(nx, a->radius)), realToFloat(posA.y + realMul(ny, a->radius)) };
+	Coord2D normal = { -realToFloat(nx), -realToFloat(ny) };
+	collisionEventsPush(&a->obj, &b->obj, point, normal, impulse);
+}
+
+/// @brief Bounce balls off each other, using the broadphase over each ball's swept path to
+/// find candidate pairs
+/// @param balls 
+/// @param count 
+/// @param seconds length of the step just integrated
+static void _ballCollideBalls(Ball** balls, uint32_t count, float seconds)
+{
+	if (_ballBroadphase == NULL)
+	{
+		return;
+	}
+
+	for (uint32_t i = 0; i < count; ++i)
 	{
-		_ballCollideCB(ball);
+		if (balls[i] != NULL && balls[i]->proxy != BROADPHASE_INVALID_PROXY)
+		{
+			// cover where the ball started the step as well as where it ended up
+			Bounds2D box;
+			_ballSetBox(&box, balls[i]->pathStart, objGetRealPosition(&balls[i]->obj), balls[i]->radius);
+			broadphaseMove(_ballBroadphase, balls[i]->proxy, &box);
+			// layers are filtered in the broadphase, so filtered pairs never reach the sweep
+			broadphaseSetFilter(_ballBroadphase, balls[i]->proxy, balls[i]->obj.category, balls[i]->obj.collideMask);
+		}
 	}
+
+	const CollisionPair* pairs;
+	uint32_t pairCount = broadphaseFindPairs(_ballBroadphase, &pairs);
+	for (uint32_t p = 0; p < pairCount; ++p)
+	{
+		Ball* a = broadphaseGetUserData(_ballBroadphase, pairs[p].a);
+		Ball* b = broadphaseGetUserData(_ballBroadphase, pairs[p].b);
+		if (!_ballSweepContact(a, b, seconds))
+		{
+			_ballResolveContact(a, b, seconds);
+		}
+	}
+}
+
+/// @brief Box around the ball at its current position
+/// @param obj 
+/// @param box 
+static void _ballGetBounds(const Object* obj, Bounds2D* box)
+{
+	const Ball* ball = (const Ball*)obj;
+	RealCoord2D pos = objGetRealPosition(obj);
+	_ballSetBox(box, pos, pos, ball->radius);
 }
 
+/// @brief Box around a ball moving in a straight line between two points. The edges are
+/// worked out as Real & only converted at the end: in fixed point the conversion is exact,
+/// so the broadphase sees the same boxes (& finds the same pairs, in the same order) however
+/// the compiler treats float math
+/// @param box 
+/// @param from 
+/// @param to 
+/// @param radius 
+static void _ballSetBox(Bounds2D* box, RealCoord2D from, RealCoord2D to, Real radius)
+{
+	box->topLeft.x = realToFloat((from.x < to.x ? from.x : to.x) - radius);
+	box->topLeft.y = realToFloat((from.y < to.y ? from.y : to.y) - radius);
+	box->botRight.x = realToFloat((from.x > to.x ? from.x : to.x) + radius);
+	box->botRight.y = realToFloat((from.y > to.y ? from.y : to.y) + radius);
+}
+
+/// @brief Ray vs circle, so scene queries don't pick balls by the corners of their boxes
+/// @param obj 
+/// @param origin 
+/// @param direction unit length
+/// @param maxDistance 
+/// @param distance set to where the ray enters the circle; 0 if it starts inside
+/// @return 
+static bool _ballRaycast(const Object* obj, Coord2D origin, Coord2D direction, float maxDistance, float* distance)
+{
+	const Ball* ball = (const Ball*)obj;
+	Coord2D pos = objGetPosition(obj);
+	float radius = realToFloat(ball->radius);
+
+	// solve |origin + t * direction - pos| = radius; b is half the usual linear term
+	float mx = origin.x - pos.x;
+	float my = origin.y - pos.y;
+	float b = mx * direction.x + my * direction.y;
+	float c = mx * mx + my * my - radius * radius;
+	if (c <= 0.0f)
+	{
+		*distance = 0.0f;
+		return true;
+	}
+
+	float discriminant = b * b - c;
+	if (b > 0.0f || discriminant < 0.0f)
+	{
+		return false;
+	}
+
+	float t = -b - sqrtf(discriminant);
+	if (t > maxDistance)
+	{
+		return false;
+	}
+	*distance = t;
+	return true;
+}
+
+/// @brief Time of impact between two balls moving along the rest of their paths. If they
+/// meet, both bounce at the moment of contact, and new paths start there
+/// @param a 
+/// @param b 
+/// @param seconds length of the step just integrated
+/// @return false if they don't meet during the step, or already overlapped when it began
+static bool _ballSweepContact(Ball* a, Ball* b, float seconds)
+{
+	RealCoord2D velA = objGetRealVelocity(&a->obj);
+	RealCoord2D velB = objGetRealVelocity(&b->obj);
+	Real dt = realFromFloat(seconds);
+	Real radii = a->radius + b->radius;
+
+	// sweep from when both paths are known, which is the later of their starts
+	Real start = a->pathTime > b->pathTime ? a->pathTime : b->pathTime;
+	Real span = dt - start;
+	if (span <= 0)
+	{
+		return false;
+	}
+	RealCoord2D posA = a->pathStart;
+	RealCoord2D posB = b->pathStart;
+	posA.x += realMul(velA.x, start - a->pathTime);
+	posA.y += realMul(velA.y, start - a->pathTime);
+	posB.x += realMul(velB.x, start - b->pathTime);
+	posB.y += realMul(velB.y, start - b->pathTime);
+
+	// b relative to a: where it was at the start (d) & how far it moves over the span (m), in
+	// units of the touching distance, so |d + m s| = 1 is a quadratic in s, the fraction of it
+	Real mx = realDiv(realMul(velB.x - velA.x, span), radii);
+	Real my = realDiv(realMul(velB.y - velA.y, span), radii);
+	Real dx = realDiv(posB.x - posA.x, radii);
+	Real dy = realDiv(posB.y - posA.y, radii);
+
+	Real qa = realMul(mx, mx) + realMul(my, my);
+	Real qb = realMul(dx, mx) + realMul(dy, my);
+	Real qc = realMul(dx, dx) + realMul(dy, dy) - REAL(1.0f);
+	if (qc <= 0 || qb >= 0 || qa == 0)
+	{
+		// overlapping from the start, or not closing in
+		return false;
+	}
+
+	// they first touch at s = qc / (-qb + sqrt(qb^2 - qa qc)), which can't be less than
+	// qc / -2qb. Past that test, the root is worked out relative to qb instead of squaring it,
+	// which would overflow fixed point for fast balls & lose precision for slow ones
+	if (qc > -2 * qb)
+	{
+		return false;
+	}
+	Real ratioC = realDiv(qc, -qb);
+	Real ratioA = realDiv(qa, -qb);
+	Real discriminant = REAL(1.0f) - realMul(ratioA, ratioC);
+	if (discriminant < 0)
+	{
+		return false;
+	}
+	Real toi = realDiv(ratioC, REAL(1.0f) + realSqrt(discriminant));
+	if (toi > REAL(1.0f))
+	{
+		return false;
+	}
+
+	// positions at the moment of contact
+	Real elapsed = realMul(toi, span);
+	posA.x += realMul(velA.x, elapsed);
+	posA.y += realMul(velA.y, elapsed);
+	posB.x += realMul(velB.x, elapsed);
+	posB.y += realMul(velB.y, elapsed);
+
+	// already unit length, being in units of the touching distance
+	Real nx = dx + realMul(mx, toi);
+	Real ny = dy + realMul(my, toi);
+	float impulse = _ballExchangeMomentum(a, b, nx, ny, &velA, &velB);
+	if (impulse > 0.0f)
+	{
+		_ballPushBallEvent(a, b, posA, nx, ny, impulse);
+	}
+
+	// both paths now start at the contact; spend the rest of the step moving apart
+	Real contact = start + elapsed;
+	Real remaining = dt - contact;
+	a->pathStart = posA;
+	b->pathStart = posB;
+	a->pathTime = b->pathTime = contact;
+	posA.x += realMul(velA.x, remaining);
+	posA.y += realMul(velA.y, remaining);
+	posB.x += realMul(velB.x, remaining);
+	posB.y += realMul(velB.y, remaining);
+	objSetRealPosition(&a->obj, posA);
+	objSetRealPosition(&b->obj, posB);
+	objSetRealVelocity(&a->obj, velA);
+	objSetRealVelocity(&b->obj, velB);
+	return true;
+}
+
+/// @brief Circle vs circle test, with an elastic bounce if they overlap. Mass goes with area.
+/// The push apart doesn't follow either path, so both end at where they were pushed to
+/// @param a 
+/// @param b 
+/// @param seconds length of the step just integrated
+static void _ballResolveContact(Ball* a, Ball* b, float seconds)
+{
+	RealCoord2D posA = objGetRealPosition(&a->obj);
+	RealCoord2D posB = objGetRealPosition(&b->obj);
+
+	Real dx = posB.x - posA.x;
+	Real dy = posB.y - posA.y;
+	Real radii = a->radius + b->radius;
+	// rule out the clearly separated first, so the squares can't overflow in fixed point
+	if (realAbs(dx) >= radii || realAbs(dy) >= radii)
+	{
+		return;
+	}
+	Real distSq = realMul(dx, dx) + realMul(dy, dy);
+	if (distSq >= realMul(radii, radii))
+	{
+		// boxes overlap, but the circles don't
+		return;
+	}
+
+	// contact normal from a to b; pick any direction if they're exactly on top of each other
+	Real dist = realSqrt(distSq);
+	Real nx = REAL(1.0f);
+	Real ny = 0;
+	if (dist > 0)
+	{
+		nx = realDiv(dx, dist);
+		ny = realDiv(dy, dist);
+	}
+
+	// separate them, with the lighter ball moving further
+	Real massA = realMul(a->radius, a->radius);
+	Real massB = realMul(b->radius, b->radius);
+	Real shareA = realDiv(massB, massA + massB);
+	Real overlap = radii - dist;
+	Real pushA = realMul(overlap, shareA);
+	Real pushB = overlap - pushA;
+	posA.x -= realMul(nx, pushA);
+	posA.y -= realMul(ny, pushA);
+	posB.x += realMul(nx, pushB);
+	posB.y += realMul(ny, pushB);
+	objSetRealPosition(&a->obj, posA);
+	objSetRealPosition(&b->obj, posB);
+	a->pathStart = posA;
+	b->pathStart = posB;
+	a->pathTime = b->pathTime = realFromFloat(seconds);
+
+	RealCoord2D velA = objGetRealVelocity(&a->obj);
+	RealCoord2D velB = objGetRealVelocity(&b->obj);
+	float impulse = _ballExchangeMomentum(a, b, nx, ny, &velA, &velB);
+	if (impulse > 0.0f)
+	{
+		objSetRealVelocity(&a->obj, velA);
+		objSetRealVelocity(&b->obj, velB);
+
+		// touching point on a's rim, part way into the overlap that was just resolved
+		_ballPushBallEvent(a, b, posA, nx, ny, impulse);
+	}
+}
+
+/// @brief Elastic bounce along the contact normal, unless they're already moving apart
+/// @param a 
+/// @param b 
+/// @param nx contact normal from a to b
+/// @param ny 
+/// @param velA updated in place
+/// @param velB updated in place
+/// @return momentum exchanged, or 0 if they were moving apart
+static float _ballExchangeMomentum(const Ball* a, const Ball* b, Real nx, Real ny, RealCoord2D* velA, RealCoord2D* velB)
+{
+	Real approach = realMul(velB->x - velA->x, nx) + realMul(velB->y - velA->y, ny);
+	if (approach >= 0)
+	{
+		return 0.0f;
+	}
+
+	// each ball's share of the velocity change, by the other's mass; the lighter one changes more
+	Real massA = realMul(a->radius, a->radius);
+	Real massB = realMul(b->radius, b->radius);
+	Real shareA = realDiv(massB, massA + massB);
+	Real changeA = 2 * realMul(approach, shareA);
+	Real changeB = 2 * approach - changeA;
+	velA->x += realMul(nx, changeA);
+	velA->y += realMul(ny, changeA);
+	velB->x -= realMul(nx, changeB);
+	velB->y -= realMul(ny, changeB);
+
+	// only reported, so it's worked out in float, where it can't overflow
+	return -realToFloat(changeA) * realToFloat(massA);
+}
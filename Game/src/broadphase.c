@@ -0,0 +1,337 @@
+#include <Windows.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "baseTypes.h"
+#include "broadphase.h"
+
+// marks the end of the free proxy chain
+#define BROADPHASE_FREE_END UINT32_MAX
+// smallest size any broadphase array grows to
+#define BROADPHASE_MIN_CAPACITY 64
+
+/// @brief Destroy a broadphase, using it's vtable
+/// @param broadphase 
+void broadphaseDelete(Broadphase* broadphase)
+{
+    if (broadphase != NULL && broadphase->vtable != NULL)
+    {
+        broadphase->vtable->destroy(broadphase);
+    }
+}
+
+/// @brief Start tracking a box
+/// @param broadphase 
+/// @param box 
+/// @param userData handed back by broadphaseGetUserData
+/// @return the new proxy's id, or BROADPHASE_INVALID_PROXY if out of memory
+uint32_t broadphaseAdd(Broadphase* broadphase, const Bounds2D* box, void* userData)
+{
+    uint32_t proxy = broadphase->freeHead;
+    if (proxy == BROADPHASE_FREE_END)
+    {
+        if (!broadphaseReserve((void**)&broadphase->proxies, &broadphase->proxyCapacity,
+            broadphase->proxyCount + 1, sizeof(BroadphaseProxy)))
+        {
+            return BROADPHASE_INVALID_PROXY;
+        }
+        proxy = broadphase->proxyCount++;
+    }
+    else
+    {
+        broadphase->freeHead = broadphase->proxies[proxy].nextFree;
+    }
+
+    BroadphaseProxy* entry = &broadphase->proxies[proxy];
+    entry->box = *box;
+    entry->userData = userData;
+    entry->category = BROADPHASE_DEFAULT_CATEGORY;
+    entry->mask = BROADPHASE_MASK_ALL;
+    entry->nextFree = BROADPHASE_FREE_END;
+    entry->active = true;
+
+    if (broadphase->vtable->add != NULL && !broadphase->vtable->add(broadphase, proxy))
+    {
+        // the implementation couldn't track it, so hand the id back rather than leave an
+        // active proxy it knows nothing about
+        entry->active = false;
+        entry->userData = NULL;
+        entry->nextFree = broadphase->freeHead;
+        broadphase->freeHead = proxy;
+        return BROADPHASE_INVALID_PROXY;
+    }
+    return proxy;
+}
+
+/// @brief Update the box of a proxy
+/// @param broadphase 
+/// @param proxy 
+/// @param box 
+void broadphaseMove(Broadphase* broadphase, uint32_t proxy, const Bounds2D* box)
+{
+    assert(proxy < broadphase->proxyCount && broadphase->proxies[proxy].active);
+
+    broadphase->proxies[proxy].box = *box;
+    if (broadphase->vtable->move != NULL)
+    {
+        broadphase->vtable->move(broadphase, proxy);
+    }
+}
+
+/// @brief Set which categories a proxy belongs to & which it pairs with. Takes effect
+/// from the next broadphaseFindPairs
+/// @param broadphase 
+/// @param proxy 
+/// @param category 
+/// @param mask 
+void broadphaseSetFilter(Broadphase* broadphase, uint32_t proxy, uint32_t category, uint32_t mask)
+{
+    assert(proxy < broadphase->proxyCount && broadphase->proxies[proxy].active);
+
+    broadphase->proxies[proxy].category = category;
+    broadphase->proxies[proxy].mask = mask;
+}
+
+/// @brief Stop tracking a proxy; its id may be handed out again
+/// @param broadphase 
+/// @param proxy 
+void broadphaseRemove(Broadphase* broadphase, uint32_t proxy)
+{
+    // removing a proxy that isn't there!
+    assert(proxy < broadphase->proxyCount && broadphase->proxies[proxy].active);
+    if (proxy >= broadphase->proxyCount || !broadphase->proxies[proxy].active)
+    {
+        return;
+    }
+
+    if (broadphase->vtable->remove != NULL)
+    {
+        broadphase->vtable->remove(broadphase, proxy);
+    }
+
+    broadphase->proxies[proxy].active = false;
+    broadphase->proxies[proxy].userData = NULL;
+    broadphase->proxies[proxy].nextFree = broadphase->freeHead;
+    broadphase->freeHead = proxy;
+}
+
+/// @brief Find every pair of proxies with overlapping boxes. Each pair is reported once
+/// @param broadphase 
+/// @param pairs receives the pair list, valid until the next call
+/// @return number of pairs
+uint32_t broadphaseFindPairs(Broadphase* broadphase, const CollisionPair** pairs)
+{
+    broadphase->pairCount = 0;
+    broadphase->vtable->findPairs(broadphase);
+
+    *pairs = broadphase->pairs;
+    return broadphase->pairCount;
+}
+
+/// @brief Retrieve what a proxy was added with
+/// @param broadphase 
+/// @param proxy 
+/// @return 
+void* broadphaseGetUserData(const Broadphase* broadphase, uint32_t proxy)
+{
+    assert(proxy < broadphase->proxyCount);
+    return broadphase->proxies[proxy].userData;
+}
+
+/// @brief Report every proxy whose box overlaps a region
+/// @param broadphase 
+/// @param region 
+/// @param func return false from it to stop early
+/// @param context handed to func
+void broadphaseQueryRegion(const Broadphase* broadphase, const Bounds2D* region, BroadphaseQueryFunc func, void* context)
+{
+    if (broadphase->vtable->queryRegion != NULL)
+    {
+        broadphase->vtable->queryRegion(broadphase, region, func, context);
+        return;
+    }
+
+    for (uint32_t i = 0; i < broadphase->proxyCount; ++i)
+    {
+        if (broadphase->proxies[i].active && boundsOverlap(&broadphase->proxies[i].box, region))
+        {
+            if (!func(context, i))
+            {
+                return;
+            }
+        }
+    }
+}
+
+/// @brief Report every proxy whose box contains a point
+/// @param broadphase 
+/// @param point 
+/// @param func return false from it to stop early
+/// @param context handed to func
+void broadphaseQueryPoint(const Broadphase* broadphase, Coord2D point, BroadphaseQueryFunc func, void* context)
+{
+    Bounds2D region = { point, point };
+    broadphaseQueryRegion(broadphase, &region, func, context);
+}
+
+/// @brief Report proxies whose box the ray passes through, within the distance the callback
+/// leaves it. Proxies are not reported in any particular order
+/// @param broadphase 
+/// @param origin 
+/// @param direction distances are measured in multiples of this
+/// @param maxDistance 
+/// @param func 
+/// @param context handed to func
+void broadphaseQueryRay(const Broadphase* broadphase, Coord2D origin, Coord2D direction, float maxDistance, BroadphaseRayFunc func, void* context)
+{
+    if (broadphase->vtable->queryRay != NULL)
+    {
+        broadphase->vtable->queryRay(broadphase, origin, direction, maxDistance, func, context);
+        return;
+    }
+
+    for (uint32_t i = 0; i < broadphase->proxyCount && maxDistance > 0.0f; ++i)
+    {
+        if (broadphase->proxies[i].active && broadphaseRayHitsBox(&broadphase->proxies[i].box, origin, direction, maxDistance))
+        {
+            maxDistance = func(context, i, maxDistance);
+        }
+    }
+}
+
+/// @brief Initialize the base of a broadphase. Intended to be called from implementation constructors
+/// @param broadphase 
+/// @param vtable 
+void broadphaseInit(Broadphase* broadphase, const BroadphaseVtable* vtable)
+{
+    ZeroMemory(broadphase, sizeof(Broadphase));
+    broadphase->vtable = vtable;
+    broadphase->freeHead = BROADPHASE_FREE_END;
+}
+
+/// @brief Free the base's buffers. Intended to be called from implementation destructors
+/// @param broadphase 
+void broadphaseDeinit(Broadphase* broadphase)
+{
+    free(broadphase->proxies);
+    free(broadphase->pairs);
+    broadphase->proxies = NULL;
+    broadphase->pairs = NULL;
+    broadphase->proxyCount = broadphase->proxyCapacity = 0;
+    broadphase->pairCount = broadphase->pairCapacity = 0;
+    broadphase->freeHead = BROADPHASE_FREE_END;
+}
+
+/// @brief Append to the pair list being reported, unless the proxies' filters rule the pair out
+/// @param broadphase 
+/// @param a 
+/// @param b 
+/// @return false if the list could not grow
+bool broadphaseAddPair(Broadphase* broadphase, uint32_t a, uint32_t b)
+{
+    if (!broadphaseShouldPair(&broadphase->proxies[a], &broadphase->proxies[b]))
+    {
+        return true;
+    }
+
+    if (!broadphaseReserve((void**)&broadphase->pairs, &broadphase->pairCapacity,
+        broadphase->pairCount + 1, sizeof(CollisionPair)))
+    {
+        return false;
+    }
+
+    broadphase->pairs[broadphase->pairCount].a = a;
+    broadphase->pairs[broadphase->pairCount].b = b;
+    ++broadphase->pairCount;
+    return true;
+}
+
+/// @brief Make sure an array can hold at least the needed number of elements, doubling as it grows
+/// @param array 
+/// @param capacity 
+/// @param needed 
+/// @param elementSize 
+/// @return false if it could not grow
+bool broadphaseReserve(void** array, uint32_t* capacity, uint32_t needed, size_t elementSize)
+{
+    if (needed <= *capacity)
+    {
+        return true;
+    }
+
+    uint32_t newCapacity = *capacity > 0 ? *capacity : BROADPHASE_MIN_CAPACITY;
+    while (newCapacity < needed)
+    {
+        newCapacity *= 2;
+    }
+
+    void* grown = realloc(*array, newCapacity * elementSize);
+    // out of memory for the broadphase!
+    assert(grown != NULL);
+    if (grown == NULL)
+    {
+        return false;
+    }
+    *array = grown;
+    *capacity = newCapacity;
+    return true;
+}
+
+/// @brief Slab test: does the ray enter the box before maxDistance?
+/// @param box 
+/// @param origin 
+/// @param direction 
+/// @param maxDistance 
+/// @return true if it does, or starts inside
+bool broadphaseRayHitsBox(const Bounds2D* box, Coord2D origin, Coord2D direction, float maxDistance)
+{
+    float distance;
+    return broadphaseRayEntersBox(box, origin, direction, maxDistance, &distance);
+}
+
+/// @brief Slab test, also giving where the ray enters the box
+/// @param box 
+/// @param origin 
+/// @param direction 
+/// @param maxDistance 
+/// @param distance set to the entry distance when there is a hit; 0 if the ray starts inside
+/// @return true if the ray enters the box before maxDistance, or starts inside
+bool broadphaseRayEntersBox(const Bounds2D* box, Coord2D origin, Coord2D direction, float maxDistance, float* distance)
+{
+    float tMin = 0.0f;
+    float tMax = maxDistance;
+
+    const float o[2] = { origin.x, origin.y };
+    const float d[2] = { direction.x, direction.y };
+    const float lo[2] = { box->topLeft.x, box->topLeft.y };
+    const float hi[2] = { box->botRight.x, box->botRight.y };
+    for (uint32_t axis = 0; axis < 2; ++axis)
+    {
+        if (d[axis] == 0.0f)
+        {
+            // parallel to this slab; either always inside it or never
+            if (o[axis] < lo[axis] || o[axis] > hi[axis])
+            {
+                return false;
+            }
+            continue;
+        }
+
+        float inv = 1.0f / d[axis];
+        float t0 = (lo[axis] - o[axis]) * inv;
+        float t1 = (hi[axis] - o[axis]) * inv;
+        if (t0 > t1)
+        {
+            float t = t0;
+            t0 = t1;
+            t1 = t;
+        }
+        tMin = t0 > tMin ? t0 : tMin;
+        tMax = t1 < tMax ? t1 : tMax;
+        if (tMin > tMax)
+        {
+            return false;
+        }
+    }
+    *distance = tMin;
+    return true;
+}
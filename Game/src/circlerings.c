@@ -0,0 +1,62 @@
+#include <Windows.h>
+#include <math.h>
+#include <assert.h>
+#include "baseTypes.h"
+#include "circlerings.h"
+
+// longest a ring's edge may be on screen, in pixels
+#define CIRCLE_RINGS_MAX_EDGE 4.0f
+// every level's points, closing point included
+#define CIRCLE_RINGS_TABLE_SIZE (2 * CIRCLE_RINGS_MAX_SEGMENTS - CIRCLE_RINGS_MIN_SEGMENTS + CIRCLE_RINGS_LEVELS)
+
+static const float TWO_PI = 6.28318531f;
+
+static struct circle_rings_t {
+    CircleRing  levels[CIRCLE_RINGS_LEVELS];
+    float       x[CIRCLE_RINGS_TABLE_SIZE];
+    float       y[CIRCLE_RINGS_TABLE_SIZE];
+    bool        built;
+} _circleRings = { 0 };
+
+/// @brief Build the unit rings. Trig runs here, once, rather than for each circle drawn
+void circleRingsInit()
+{
+    uint32_t offset = 0;
+    for (uint32_t level = 0; level < CIRCLE_RINGS_LEVELS; ++level)
+    {
+        uint32_t segments = CIRCLE_RINGS_MIN_SEGMENTS << level;
+        for (uint32_t i = 0; i < segments; ++i)
+        {
+            float angle = TWO_PI * (float)i / (float)segments;
+            _circleRings.x[offset + i] = cosf(angle);
+            _circleRings.y[offset + i] = sinf(angle);
+        }
+        _circleRings.x[offset + segments] = _circleRings.x[offset];
+        _circleRings.y[offset + segments] = _circleRings.y[offset];
+
+        _circleRings.levels[level].segments = segments;
+        _circleRings.levels[level].x = &_circleRings.x[offset];
+        _circleRings.levels[level].y = &_circleRings.y[offset];
+        offset += segments + 1;
+    }
+    assert(offset == CIRCLE_RINGS_TABLE_SIZE);
+    _circleRings.built = true;
+}
+
+/// @brief The coarsest ring whose edges stay short at the given radius
+/// @param radius in pixels
+/// @return 
+const CircleRing* circleRingsForRadius(float radius)
+{
+    // rings used before circleRingsInit!
+    assert(_circleRings.built);
+
+    float circumference = TWO_PI * radius;
+    uint32_t level = 0;
+    while (level < CIRCLE_RINGS_LEVELS - 1 &&
+        circumference > CIRCLE_RINGS_MAX_EDGE * (float)_circleRings.levels[level].segments)
+    {
+        ++level;
+    }
+    return &_circleRings.levels[level];
+}
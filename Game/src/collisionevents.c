@@ -0,0 +1,124 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include "baseTypes.h"
+#include "collisionevents.h"
+
+// most listeners that can be registered at once
+#define COLLISION_MAX_LISTENERS 8
+
+/// @brief A registered consumer of the frame's events
+typedef struct collision_listener_t {
+    CollisionListenerFunc func;
+    void* context;
+} CollisionListener;
+
+static struct collision_events_t {
+    CollisionEvent* events;
+    uint32_t count;
+    uint32_t max;
+    uint32_t dropped;       // events that didn't fit this frame
+
+    CollisionListener listeners[COLLISION_MAX_LISTENERS];
+    uint32_t listenerCount;
+} _collisionEvents = { NULL, 0, 0, 0 };
+
+/// @brief Allocate the event buffer
+/// @param maxEvents events kept per frame; any more are dropped until the next dispatch
+void collisionEventsInit(uint32_t maxEvents)
+{
+    _collisionEvents.events = malloc(maxEvents * sizeof(CollisionEvent));
+    assert(_collisionEvents.events != NULL);
+    _collisionEvents.max = _collisionEvents.events != NULL ? maxEvents : 0;
+    _collisionEvents.count = 0;
+    _collisionEvents.dropped = 0;
+    _collisionEvents.listenerCount = 0;
+}
+
+/// @brief Free the event buffer; undelivered events are discarded
+void collisionEventsShutdown()
+{
+    free(_collisionEvents.events);
+    _collisionEvents.events = NULL;
+    _collisionEvents.count = _collisionEvents.max = 0;
+    _collisionEvents.listenerCount = 0;
+}
+
+/// @brief Register to receive each frame's events
+/// @param func 
+/// @param context handed back to func
+/// @return false if there are too many listeners
+bool collisionEventsAddListener(CollisionListenerFunc func, void* context)
+{
+    // out of listener slots!
+    assert(_collisionEvents.listenerCount < COLLISION_MAX_LISTENERS);
+    if (_collisionEvents.listenerCount >= COLLISION_MAX_LISTENERS)
+    {
+        return false;
+    }
+
+    CollisionListener* listener = &_collisionEvents.listeners[_collisionEvents.listenerCount++];
+    listener->func = func;
+    listener->context = context;
+    return true;
+}
+
+/// @brief Stop receiving events
+/// @param func 
+/// @param context the same context it was added with
+void collisionEventsRemoveListener(CollisionListenerFunc func, void* context)
+{
+    for (uint32_t i = 0; i < _collisionEvents.listenerCount; ++i)
+    {
+        CollisionListener* listener = &_collisionEvents.listeners[i];
+        if (listener->func == func && listener->context == context)
+        {
+            *listener = _collisionEvents.listeners[--_collisionEvents.listenerCount];
+            return;
+        }
+    }
+}
+
+/// @brief Record a contact. Objects are stored as handles, so events about objects that are
+/// destroyed before the dispatch just stop resolving
+/// @param a 
+/// @param b NULL for static geometry
+/// @param point 
+/// @param normal pointing from b towards a
+/// @param impulse 
+void collisionEventsPush(const Object* a, const Object* b, Coord2D point, Coord2D normal, float impulse)
+{
+    if (_collisionEvents.count >= _collisionEvents.max)
+    {
+        ++_collisionEvents.dropped;
+        return;
+    }
+
+    CollisionEvent* event = &_collisionEvents.events[_collisionEvents.count++];
+    event->a = objMgrGetHandle(a);
+    event->b = b != NULL ? objMgrGetHandle(b) : OBJ_INVALID_HANDLE;
+    event->point = point;
+    event->normal = normal;
+    event->impulse = impulse;
+}
+
+/// @brief Hand the frame's events to every listener, then start a new frame. Call once per
+/// frame, after the fixed steps
+void collisionEventsDispatch()
+{
+#ifdef _DEBUG
+    if (_collisionEvents.dropped > 0)
+    {
+        printf("collision events: dropped %u of %u this frame\n", _collisionEvents.dropped, _collisionEvents.dropped + _collisionEvents.count);
+    }
+#endif
+
+    for (uint32_t i = 0; i < _collisionEvents.listenerCount; ++i)
+    {
+        CollisionListener* listener = &_collisionEvents.listeners[i];
+        listener->func(listener->context, _collisionEvents.events, _collisionEvents.count);
+    }
+
+    _collisionEvents.count = 0;
+    _collisionEvents.dropped = 0;
+}
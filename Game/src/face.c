@@ -8,6 +8,9 @@
 #include "face.h"
 #include "Object.h"
 #include "random.h"
+#include "pool.h"
+#include "spritebatch.h"
+#include "render.h"
 
 // all of these values are based upon the layout of the PNG
 static const char CHARACTER_PAGE[] = "asset/snoods_default.png";
@@ -29,20 +32,34 @@ typedef struct face_t
     Coord2D     size;
     uint32_t    character;
     Mood        mood;
-
-    uint32_t    nextUpdate;
 } Face;
 
 static GLuint _faceTexture = 0;
 
-// the object vtable for all faces
-static void _faceUpdate(Object* obj, uint32_t milliseconds);
-static void _faceDraw(Object* obj);
+// all faces are allocated from here, so they sit next to each other in memory
+static Pool* _facePool = NULL;
+static const uint32_t FACES_PER_CHUNK = 32;
+
+// the object vtable for all faces; they sleep between mood changes, so have no per-frame update
+static void _faceDraw(Object* obj, float alpha);
+static void _faceDrawBatch(Object** objs, uint32_t count, float alpha);
+static void _faceWake(Object* obj);
+static void _faceGetBounds(const Object* obj, Bounds2D* box);
 static ObjVtable _faceVtable = {
     _faceDraw,
-    _faceUpdate
+    NULL,
+    NULL,
+    NULL,
+    _faceDrawBatch,
+    _faceWake,
+    NULL,
+    _faceGetBounds,
+    NULL,
+    0,
+    OBJ_LAYER_FACE
 };
 
+static void _faceQueueSprite(const Face* face, float alpha);
 static void _faceUpdateMood(Face* face);
 static uint32_t _getUpdateTime();
 
@@ -51,33 +68,52 @@ void faceInitTextures()
 {
     if (_faceTexture == 0)
     {
-        _faceTexture = SOIL_load_OGL_texture(CHARACTER_PAGE, SOIL_LOAD_AUTO, SOIL_CREATE_NEW_ID,
-            SOIL_FLAG_MIPMAPS | SOIL_FLAG_INVERT_Y | SOIL_FLAG_NTSC_SAFE_RGB | SOIL_FLAG_COMPRESS_TO_DXT);
+        _faceTexture = renderLoadTexture(CHARACTER_PAGE,
+            SOIL_FLAG_MIPMAPS | SOIL_FLAG_INVERT_Y | SOIL_FLAG_NTSC_SAFE_RGB | SOIL_FLAG_COMPRESS_TO_DXT,
+            RENDER_FILTER_LINEAR);
         assert(_faceTexture != 0);
     }
 }
 
+/// @brief One time creation of the face pool
+void faceInitPool()
+{
+    if (_facePool == NULL)
+    {
+        _facePool = POOL_NEW(Face, FACES_PER_CHUNK);
+        assert(_facePool != NULL);
+    }
+}
+
+/// @brief Release the face pool; all faces must have been deleted
+void faceShutdownPool()
+{
+    poolDelete(_facePool);
+    _facePool = NULL;
+}
+
 /// @brief Allocates & initializes a face object
 /// @param box 
 /// @return 
 Face* faceNew(Bounds2D box)
 {
-    Face* face = malloc(sizeof(Face));
+    Face* face = POOL_ALLOC(_facePool, Face);
     if (face != NULL)
     {
+        // extract the dimensions from the bounding box for rendering; before registering,
+        // so the bounds are valid
+        face->size = boundsGetDimensions(&box);
+
         Coord2D center = boundsGetCenter(&box);
         Coord2D vel = { 0.0f, 0.0f };
         objInit(&face->obj, &_faceVtable, center, vel);
 
-        // extract the dimensions from the bounding box for rendering
-        face->size = boundsGetDimensions(&box);
-
         // initialize the face to one of the characters in our sprite sheet
         face->character = 1;// randGetInt(0, CHARACTER_COUNT);
         face->mood = MOOD_NORMAL;
 
         // setup a random time to update mood
-        face->nextUpdate = _getUpdateTime();
+        objWakeIn(&face->obj, _getUpdateTime());
     }
 
     return face;
@@ -89,78 +125,83 @@ void faceDelete(Face* face)
 {
     objDeinit(&face->obj);
 
-    free(face);
+    poolFree(_facePool, face);
 }
 
 /// @brief Object draw handler
 /// @param obj 
-static void _faceDraw(Object* obj)
+/// @param alpha 
+static void _faceDraw(Object* obj, float alpha)
 {
-    Face* face = (Face*)obj;
-
+    _faceQueueSprite((Face*)obj, alpha);
+}
 
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, _faceTexture);
-    glBegin(GL_TRIANGLE_STRIP);
+/// @brief Queues every face in the span; they all share the sprite sheet, so they end up in
+/// one batch
+/// @param objs 
+/// @param count 
+/// @param alpha 
+static void _faceDrawBatch(Object** objs, uint32_t count, float alpha)
+{
+    for (uint32_t i = 0; i < count; ++i)
     {
-        // calculate the bounding box
-        GLfloat xPositionLeft = (obj->position.x - face->size.x / 2);
-        GLfloat xPositionRight = (obj->position.x + face->size.x / 2);
-        GLfloat yPositionTop = (obj->position.y - face->size.y / 2);
-        GLfloat yPositionBottom = (obj->position.y + face->size.y / 2);
-
-        // find the proper sprite frame from the 8x4 sprite sheet
-        float uPerChar = 1.0f / (float)CHARACTER_COUNT;
-        float vPerMood = 1.0f / (float)MOOD_COUNT;
-
-        // calculate the starting uv... remember v of 0 is the bottom of the texture
-        GLfloat xTextureCoord = 0 * uPerChar;
-        GLfloat yTextureCoord = (MOOD_COUNT-0) * vPerMood;
-
-        const float BG_DEPTH = -0.99f;
-
-        // draw the textured quad as a tristrip
-        glColor4ub(0xFF, 0xFF, 0xFF, 0xFF);
-
-        // TL
-        glTexCoord2f(xTextureCoord, yTextureCoord);
-        glVertex3f(xPositionLeft, yPositionTop, BG_DEPTH);
-
-        // BL
-        glTexCoord2f(xTextureCoord, yTextureCoord - vPerMood);
-        glVertex3f(xPositionLeft, yPositionBottom, BG_DEPTH);
-
-        // TR
-        glTexCoord2f(xTextureCoord + uPerChar, yTextureCoord);
-        glVertex3f(xPositionRight, yPositionTop, BG_DEPTH);
-
-        // BR
-        glTexCoord2f(xTextureCoord + uPerChar, yTextureCoord - vPerMood);
-        glVertex3f(xPositionRight, yPositionBottom, BG_DEPTH);
-
+        if (objs[i] != NULL)
+        {
+            _faceQueueSprite((Face*)objs[i], alpha);
+        }
     }
-    glEnd();
 }
 
-/// @brief Updates the character's mood every so often
-/// @param obj 
-/// @param milliseconds 
-static void _faceUpdate(Object* obj, uint32_t milliseconds)
+/// @brief Hands a face's quad to the sprite batcher
+/// @param face 
+/// @param alpha 
+static void _faceQueueSprite(const Face* face, float alpha)
 {
-    objDefaultUpdate(obj, milliseconds);
+    // find the proper sprite frame from the 8x4 sprite sheet
+    float uPerChar = 1.0f / (float)CHARACTER_COUNT;
+    float vPerMood = 1.0f / (float)MOOD_COUNT;
+
+    // calculate the starting uv... remember v of 0 is the bottom of the texture
+    GLfloat xTextureCoord = 0 * uPerChar;
+    GLfloat yTextureCoord = (MOOD_COUNT-0) * vPerMood;
+
+    const float BG_DEPTH = -0.99f;
+
+    Sprite sprite;
+    sprite.center = objGetDrawPosition(&face->obj, alpha);
+    sprite.size = face->size;
+    sprite.uv.topLeft.x = xTextureCoord;
+    sprite.uv.topLeft.y = yTextureCoord;
+    sprite.uv.botRight.x = xTextureCoord + uPerChar;
+    sprite.uv.botRight.y = yTextureCoord - vPerMood;
+    sprite.depth = BG_DEPTH;
+    sprite.color = 0xFFFFFFFF;
+    sprite.texture = _faceTexture;
+    spriteBatchDraw(&sprite);
+}
 
+/// @brief Changes the character's mood, then goes back to sleep for a while
+/// @param obj 
+static void _faceWake(Object* obj)
+{
     Face* face = (Face*)obj;
 
-    // check to see if we should update yet
-    if (face->nextUpdate > milliseconds)
-    {
-        face->nextUpdate -= milliseconds;
-        return;
-    }
-
     // perform the update & set up the next update time
     _faceUpdateMood(face);
-    face->nextUpdate = _getUpdateTime();
+    objWakeIn(obj, _getUpdateTime());
+}
+
+/// @brief The quad the face is drawn in
+/// @param obj 
+/// @param box 
+static void _faceGetBounds(const Object* obj, Bounds2D* box)
+{
+    const Face* face = (const Face*)obj;
+    Coord2D pos = objGetPosition(obj);
+    box->topLeft.x = pos.x - face->size.x / 2.0f;
+    box->topLeft.y = pos.y - face->size.y / 2.0f;
+    box->botRight.x = pos.x + face->size.x / 2.0f;
+    box->botRight.y = pos.y + face->size.y / 2.0f;
 }
 
 /// @brief Choose a random mood
@@ -2,6 +2,7 @@
 #include <stdlib.h>												// Header File For Malloc/Free
 #include <stdarg.h>												// Header File For Variable Argument Routines
 #include <math.h>												// Header File For Math Operations
+#include <assert.h>
 #include <gl\gl.h>												// Header File For The OpenGL32 Library
 #include <gl\glu.h>												// Header File For The GLu32 Library
 #include "glut.h"
@@ -9,6 +10,7 @@
 #include "object.h"
 #include "field.h"
 #include "shape.h"
+#include "pool.h"
 
 typedef struct field_t
 {
@@ -19,28 +21,59 @@ typedef struct field_t
 } Field;
 
 // the object vtable for all fields
-static void _fieldUpdate(Object* obj, uint32_t milliseconds);
-static void _fieldDraw(Object* obj);
+static void _fieldDraw(Object* obj, float alpha);
+static void _fieldGetBounds(const Object* obj, Bounds2D* box);
 static ObjVtable _fieldVtable = {
 	_fieldDraw,
-	_fieldUpdate
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	_fieldGetBounds,
+	NULL,
+	0,
+	OBJ_LAYER_FIELD
 };
 
+// all fields are allocated from here
+static Pool* _fieldPool = NULL;
+static const uint32_t FIELDS_PER_CHUNK = 4;
+
+/// @brief One time creation of the field pool
+void fieldInitPool()
+{
+	if (_fieldPool == NULL)
+	{
+		_fieldPool = POOL_NEW(Field, FIELDS_PER_CHUNK);
+		assert(_fieldPool != NULL);
+	}
+}
+
+/// @brief Release the field pool; all fields must have been deleted
+void fieldShutdownPool()
+{
+	poolDelete(_fieldPool);
+	_fieldPool = NULL;
+}
+
 /// @brief Instantiate and initialize a field object
 /// @param bounds 
 /// @param color 
 /// @return 
 Field* fieldNew(Bounds2D bounds, uint32_t color)
 {
-	Field* field = malloc(sizeof(Field));
+	Field* field = POOL_ALLOC(_fieldPool, Field);
 	if(field != NULL)
 	{
+		// size first, so the bounds are valid when the object registers
+		field->size = boundsGetDimensions(&bounds);
+		field->color = color;
+
 		Coord2D center = boundsGetCenter(&bounds);
 		Coord2D vel = { 0.0f, 0.0f };
 		objInit(&field->obj, &_fieldVtable, center, vel);
-
-		field->size = boundsGetDimensions(&bounds);
-		field->color = color;
 	}
 	return field;
 }
@@ -51,7 +84,7 @@ void fieldDelete(Field* field)
 {
 	objDeinit(&field->obj);
 
-	free(field);
+	poolFree(_fieldPool, field);
 }
 
 /// @brief Set the color to draw the field border
@@ -78,24 +111,18 @@ Coord2D fieldGetSize(const Field* field)
 	return field->size;
 }
 
-/// @brief Currently a no-op
-/// @param obj 
-/// @param milliseconds 
-static void _fieldUpdate(Object* obj, uint32_t milliseconds)
-{
-	objDefaultUpdate(obj, milliseconds);
-}
-
 /// @brief Draw the field border
 /// @param obj 
-static void _fieldDraw(Object* obj)
+/// @param alpha 
+static void _fieldDraw(Object* obj, float alpha)
 {
 	Field* field = (Field*)obj;
 
-	float left = field->obj.position.x - field->size.x/2.0f;
-	float right = field->obj.position.x + field->size.x /2.0f;
-	float bottom = field->obj.position.y - field->size.y /2.0f;
-	float top = field->obj.position.y + field->size.y/2.0f;
+	Coord2D pos = objGetDrawPosition(obj, alpha);
+	float left = pos.x - field->size.x/2.0f;
+	float right = pos.x + field->size.x /2.0f;
+	float bottom = pos.y - field->size.y /2.0f;
+	float top = pos.y + field->size.y/2.0f;
 
 	uint8_t r = (uint8_t)(field->color>>16 & 0xFF);
 	uint8_t g = (uint8_t)(field->color>>8 & 0xFF);
@@ -106,3 +133,16 @@ static void _fieldDraw(Object* obj)
 	shapeDrawLine(right,bottom,left,bottom,r,g,b);
 	shapeDrawLine(left,bottom,left,top,r,g,b);
 };
+
+/// @brief The area enclosed by the border
+/// @param obj 
+/// @param box 
+static void _fieldGetBounds(const Object* obj, Bounds2D* box)
+{
+	const Field* field = (const Field*)obj;
+	Coord2D pos = objGetPosition(obj);
+	box->topLeft.x = pos.x - field->size.x / 2.0f;
+	box->topLeft.y = pos.y - field->size.y / 2.0f;
+	box->botRight.x = pos.x + field->size.x / 2.0f;
+	box->botRight.y = pos.y + field->size.y / 2.0f;
+}
@@ -0,0 +1,38 @@
+#include "baseTypes.h"
+#include "fixed.h"
+
+/// @brief Square root by the bit-by-bit integer method, so it is exact & needs no floating point.
+/// Negative values give 0
+/// @param value 
+/// @return 
+Fixed fixedSqrt(Fixed value)
+{
+    if (value <= 0)
+    {
+        return 0;
+    }
+
+    // sqrt(v / 2^16) * 2^16 == sqrt(v * 2^16)
+    uint64_t remainder = (uint64_t)value << FIXED_SHIFT;
+    uint64_t root = 0;
+    uint64_t bit = 1ull << 62;
+    while (bit > remainder)
+    {
+        bit >>= 2;
+    }
+
+    while (bit != 0)
+    {
+        if (remainder >= root + bit)
+        {
+            remainder -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (Fixed)root;
+}
@@ -1,22 +1,61 @@
+#include <stdio.h>
 #include "baseTypes.h"
 #include "input.h"
 #include "application.h"
 #include "framework.h"
 #include "levelmgr.h"
 #include "objmgr.h"
+#include "collisionevents.h"
+#include "spritebatch.h"
+#include "render.h"
+#include "rendergl.h"
+#include "rendernull.h"
+#include "rendersoft.h"
+#include "glstate.h"
 
 static void _gameInit();
 static void _gameShutdown();
 static void _gameDraw();
 static void _gameUpdate(uint32_t milliseconds);
 
+#ifdef _DEBUG
+// the busiest frame's counts, each on its own, logged at shutdown to size the render buffers
+// & check how well draws batch
+static struct game_frame_peaks_t {
+	RenderStats render;
+	SpriteBatchStats sprites;
+	GLStateStats gl;
+} _framePeaks;
+
+static void _gameTrackFramePeaks();
+static void _gamePeak(uint32_t* peak, uint32_t value);
+static void _gameLogFramePeaks();
+#endif
+
+// which layers each layer collides with; a pair collides only if both rows allow it. Balls
+// bounce off the field & each other, the player is kept in by the field, & the faces are
+// background, colliding with nothing
+static const uint32_t _levelLayerMasks[OBJ_LAYER_COUNT] = {
+	// default
+	OBJ_LAYER_MASK_ALL,
+	// field
+	OBJ_LAYER_BIT(OBJ_LAYER_BALL) | OBJ_LAYER_BIT(OBJ_LAYER_PLAYER),
+	// ball
+	OBJ_LAYER_BIT(OBJ_LAYER_FIELD) | OBJ_LAYER_BIT(OBJ_LAYER_BALL),
+	// player
+	OBJ_LAYER_BIT(OBJ_LAYER_FIELD),
+	// face
+	0
+};
+
 static LevelDef _levelDefs[] = {
 
 	{
 		{{50, 50}, {974, 600}},		// fieldBounds
 		0x00ff0000,					// fieldColor
 		20,							// numEnemies
-		1
+		1,
+		_levelLayerMasks			// layerMasks
 	}
 };
 static Level* _curLevel = NULL;
@@ -30,11 +69,14 @@ static Level* _curLevel = NULL;
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
 {
 	const char GAME_NAME[] = "Framework1";
+	// circle batches are built in the frame arena; enough for every object as the largest outlined circle
+	const uint32_t FRAME_ARENA_SIZE = 5 * 1024 * 1024;
 
 	Application* app = appNew(hInstance, GAME_NAME, _gameDraw, _gameUpdate);
 
 	if (app != NULL)
 	{
+		appSetFrameArenaSize(app, FRAME_ARENA_SIZE);
 		GLWindow* window = fwInitWindow(app);
 		if (window != NULL)
 		{
@@ -58,7 +100,29 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 static void _gameInit()
 {
 	const uint32_t MAX_OBJECTS = 500;
-	objMgrInit(MAX_OBJECTS);
+	// plenty for every ball hitting a wall & another ball in each substep of a frame
+	const uint32_t MAX_COLLISION_EVENTS = 4096;
+	// sprites queued before the batcher has to draw early
+	const uint32_t MAX_SPRITES = 1024;
+	// draw commands & quad vertices recorded per frame; the vertices cover full particle emitters
+	const uint32_t MAX_RENDER_COMMANDS = 4096;
+	const uint32_t MAX_RENDER_VERTICES = 262144;
+	objMgrInit(MAX_OBJECTS, true);
+	collisionEventsInit(MAX_COLLISION_EVENTS);
+	renderInit(MAX_RENDER_COMMANDS, MAX_RENDER_VERTICES);
+	// define GAME_NULL_RENDERER to record & validate frames without drawing them, or
+	// GAME_SOFT_RENDERER to rasterize them on the CPU
+#if defined(GAME_NULL_RENDERER)
+	renderSetBackend(renderNullNew());
+#elif defined(GAME_SOFT_RENDERER)
+	// the software backend's framebuffer covers the default window
+	const uint32_t SOFT_RENDER_WIDTH = 1024;
+	const uint32_t SOFT_RENDER_HEIGHT = 768;
+	renderSetBackend(renderSoftNew(SOFT_RENDER_WIDTH, SOFT_RENDER_HEIGHT));
+#else
+	renderSetBackend(renderGLNew());
+#endif
+	spriteBatchInit(MAX_SPRITES);
 	levelMgrInit();
 
 	_curLevel = levelMgrLoad(&_levelDefs[0]);
@@ -70,13 +134,32 @@ static void _gameShutdown()
 
 	levelMgrUnload(_curLevel);
 	levelMgrShutdown();
+#ifdef _DEBUG
+	_gameLogFramePeaks();
+#endif
+	spriteBatchShutdown();
+#if defined(GAME_SOFT_RENDERER)
+	// keep the last frame for comparing against golden images
+	renderSoftWritePPM(renderGetBackend(), "lastframe.ppm");
+#endif
+	renderBackendDelete(renderGetBackend());
+	renderShutdown();
+	collisionEventsShutdown();
 	objMgrShutdown();
 }
 
 /// @brief Draw everything to the screen for current frame
 static void _gameDraw() 
 {
+	// objects record draw commands; the backend runs them in key order at the end of the frame
+	renderBeginFrame();
+	spriteBatchBegin();
 	objMgrDraw();
+	spriteBatchEnd();
+	renderEndFrame();
+#ifdef _DEBUG
+	_gameTrackFramePeaks();
+#endif
 }
 
 /// @brief Perform updates for all game objects, for the elapsed duration
@@ -100,4 +183,53 @@ static void _gameUpdate(uint32_t milliseconds)
 
 	objMgrUpdate(milliseconds);
 	objMgrFixedUpdate(milliseconds);
-}
\ No newline at end of file
+	// listeners see all of the frame's collisions at once
+	collisionEventsDispatch();
+}
+
+#ifdef _DEBUG
+/// @brief Fold the frame just drawn into the peaks. GL counts lag a frame, as they close
+/// when the next one starts
+static void _gameTrackFramePeaks()
+{
+	const RenderStats* render = renderGetStats();
+	const SpriteBatchStats* sprites = spriteBatchGetStats();
+	const GLStateStats* gl = glStateGetFrameStats();
+
+	_gamePeak(&_framePeaks.render.commands, render->commands);
+	_gamePeak(&_framePeaks.render.vertices, render->vertices);
+	_gamePeak(&_framePeaks.render.dropped, render->dropped);
+	_gamePeak(&_framePeaks.sprites.sprites, sprites->sprites);
+	_gamePeak(&_framePeaks.sprites.batches, sprites->batches);
+	_gamePeak(&_framePeaks.sprites.flushes, sprites->flushes);
+	_gamePeak(&_framePeaks.gl.issued, gl->issued);
+	_gamePeak(&_framePeaks.gl.elided, gl->elided);
+}
+
+/// @brief Raise a peak to a new value, if it's higher
+/// @param peak 
+/// @param value 
+static void _gamePeak(uint32_t* peak, uint32_t value)
+{
+	if (value > *peak)
+	{
+		*peak = value;
+	}
+}
+
+/// @brief Print the peaks, & the null backend's totals when it's the one in use
+static void _gameLogFramePeaks()
+{
+	printf("render peaks per frame: %u commands, %u vertices, %u dropped\n",
+		_framePeaks.render.commands, _framePeaks.render.vertices, _framePeaks.render.dropped);
+	printf("sprite batch peaks per frame: %u sprites, %u batches, %u flushes\n",
+		_framePeaks.sprites.sprites, _framePeaks.sprites.batches, _framePeaks.sprites.flushes);
+	printf("GL state peaks per frame: %u calls issued, %u elided\n",
+		_framePeaks.gl.issued, _framePeaks.gl.elided);
+#if defined(GAME_NULL_RENDERER)
+	const RenderNullStats* totals = renderNullGetStats(renderGetBackend());
+	printf("null renderer: %u frames, %llu commands, %llu vertices, %llu invalid\n",
+		totals->frames, (unsigned long long)totals->commands, (unsigned long long)totals->vertices, (unsigned long long)totals->invalid);
+#endif
+}
+#endif
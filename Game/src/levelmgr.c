@@ -14,6 +14,9 @@
 #include "objmgr.h"
 #include "SOIL.h"
 #include "sound.h"
+#include "pool.h"
+#include "collisionevents.h"
+#include "particles.h"
 
 typedef struct level_t
 {
@@ -22,31 +25,59 @@ typedef struct level_t
     Player* player;
     Field* field;
     Ball** enemies;
+
+    ParticleEmitter* sparks;     // thrown off where balls hit each other
+    ParticleEmitter* dust;       // kicked up where balls hit the walls
 } Level;
 
 static int32_t _soundId = SOUND_NOSOUND;
+// every hit used to start its own voice; now a frame's hits share one, at most this often
+static const ULONGLONG LEVEL_MIN_SOUND_GAP_MS = 50;
+static ULONGLONG _lastSoundTime = 0;
+
+// impact effects; each emitter is drawn in one call, so they're sized for a crowded field
+static const uint32_t LEVEL_MAX_SPARKS = 32768;
+static const uint32_t LEVEL_MAX_DUST = 16384;
+static const ParticleBurst LEVEL_SPARK_BURST = {
+    8, 3.14159f, 80.0f, 260.0f, 0.15f, 0.45f, 2.0f, 4.0f, 0xFFE080
+};
+static const ParticleBurst LEVEL_DUST_BURST = {
+    6, 1.4f, 20.0f, 70.0f, 0.4f, 0.9f, 4.0f, 8.0f, 0xA09080
+};
 
-static void _levelMgrPlaySound(Ball* ball);
+static void _levelMgrOnCollisions(void* context, const CollisionEvent* events, uint32_t count);
+static void _levelMgrSpawnImpacts(void* context, const CollisionEvent* events, uint32_t count);
 
 /// @brief Initialize the level manager
 void levelMgrInit()
 {
     faceInitTextures();
 
+    // each object type allocates from its own pool
+    fieldInitPool();
+    ballInitPool();
+    faceInitPool();
+    playerInitPool();
+
     // inside a sounds.c/h
     // have a player_sound.h
     // have a enemy_sound.h
     // have a level_sound.h
     // have other ui_sounds.h
     _soundId = soundLoad("asset/beep.wav");
-    ballSetCollideCB(_levelMgrPlaySound);
+    collisionEventsAddListener(_levelMgrOnCollisions, NULL);
 }
 
 /// @brief Shutdown the level manager
 void levelMgrShutdown()
 {
     soundUnload(_soundId);
-    ballClearCollideCB();
+    collisionEventsRemoveListener(_levelMgrOnCollisions, NULL);
+
+    playerShutdownPool();
+    faceShutdownPool();
+    ballShutdownPool();
+    fieldShutdownPool();
 }
 
 /// @brief Loads the level and all required objects/assets
@@ -59,6 +90,14 @@ Level* levelMgrLoad(const LevelDef* levelDef)
     if (level != NULL)
     {
         level->def = levelDef;
+        // before anything is created, since objects take their collide masks on init
+        objSetLayerMatrix(levelDef->layerMasks);
+
+        Coord2D sparkGravity = { 0.0f, 400.0f };
+        Coord2D dustGravity = { 0.0f, 30.0f };
+        level->sparks = particleEmitterNew(LEVEL_MAX_SPARKS, 0, sparkGravity, 2.0f);
+        level->dust = particleEmitterNew(LEVEL_MAX_DUST, 0, dustGravity, 3.0f);
+        collisionEventsAddListener(_levelMgrSpawnImpacts, level);
 
         // the field provides the boundaries of the scene & encloses the faces & balls
         level->field = fieldNew(levelDef->fieldBounds, levelDef->fieldColor);
@@ -74,6 +113,10 @@ Level* levelMgrLoad(const LevelDef* levelDef)
                 level->enemies[i] = ballNew(levelDef->fieldBounds);
             }
         }
+
+#ifdef _DEBUG
+        poolLogAllStats();
+#endif
     }
     return level;
 }
@@ -88,7 +131,6 @@ void levelMgrUnload(Level* level)
         {
             playerDelete(level->player);
         }
-        free(level->player);
         for (uint32_t i = 0; i < level->def->numEnemies; ++i)
         {
             ballDelete(level->enemies[i]);
@@ -96,11 +138,60 @@ void levelMgrUnload(Level* level)
         free(level->enemies);
 
         fieldDelete(level->field);
+
+        collisionEventsRemoveListener(_levelMgrSpawnImpacts, level);
+        particleEmitterDelete(level->sparks);
+        particleEmitterDelete(level->dust);
+        objSetLayerMatrix(NULL);
     }
     free(level);
 }
 
-static void _levelMgrPlaySound(Ball* ball)
+/// @brief Play one beep for a frame's worth of collisions, rate limited so a crowded field
+/// doesn't pile up voices
+/// @param context 
+/// @param events 
+/// @param count 
+static void _levelMgrOnCollisions(void* context, const CollisionEvent* events, uint32_t count)
 {
+    if (count == 0)
+    {
+        return;
+    }
+
+    ULONGLONG now = GetTickCount64();
+    if (now - _lastSoundTime < LEVEL_MIN_SOUND_GAP_MS)
+    {
+        return;
+    }
+    _lastSoundTime = now;
     soundPlay(_soundId);
 }
+
+/// @brief Throw sparks off ball on ball hits & dust off wall hits, more for harder hits
+/// @param context the level
+/// @param events 
+/// @param count 
+static void _levelMgrSpawnImpacts(void* context, const CollisionEvent* events, uint32_t count)
+{
+    // impulses are momentum with mass going as area; this much buys one extra particle
+    const float IMPULSE_PER_PARTICLE = 20000.0f;
+    const uint32_t MAX_EXTRA_PARTICLES = 16;
+
+    Level* level = (Level*)context;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const CollisionEvent* event = &events[i];
+        bool wall = event->b == OBJ_INVALID_HANDLE;
+        ParticleEmitter* emitter = wall ? level->dust : level->sparks;
+        if (emitter == NULL)
+        {
+            continue;
+        }
+
+        ParticleBurst burst = wall ? LEVEL_DUST_BURST : LEVEL_SPARK_BURST;
+        uint32_t extra = (uint32_t)(event->impulse / IMPULSE_PER_PARTICLE);
+        burst.count += extra < MAX_EXTRA_PARTICLES ? extra : MAX_EXTRA_PARTICLES;
+        particleEmitterBurst(emitter, &burst, event->point, event->normal);
+    }
+}
@@ -12,9 +12,9 @@
 
 
 // vtable
-void _battleMessageQueueDraw(Object* queue);
+void _battleMessageQueueDraw(Object* queue, float alpha);
 void _battleMessageQueueUpdate(Object* queue, uint32_t milliseconds);
-void _battleMessageQueueFixedUpdate(Object* obj, uint32_t milliseconds);
+void _battleMessageQueueFixedUpdate(Object* obj, float seconds);
 static ObjVtable _battleMessageQueueVtable = {
 	_battleMessageQueueDraw,
 	_battleMessageQueueUpdate,
@@ -37,10 +37,12 @@ void initBattleMessage(Object* obj)
 	battleMessageQueue->currentTimer = 0.0f;
 	battleMessageQueue->isActive = false;
 
-	Coord2D coord = { 0,0 };
+	RealCoord2D coord = { 0,0 };
 	// object params
 	obj->position = coord;
 	obj->velocity = coord;
+	obj->acceleration = coord;
+	obj->prevPosition = coord;
 	obj->vtable = &_battleMessageQueueVtable;
 }
 /// @brief 
@@ -57,7 +59,7 @@ void enqueueBattleMessage(BattleMessageQueue* queue, const char* text, float dis
 	}
 
 	BattleMessage* msg = &queue->messages[queue->tail];
-	msg->text = _strdup(text); // cross-platform → use strdup or write a wrapper
+	strncpy_s(msg->text, MAX_BATTLE_MESSAGE_LENGTH, text, _TRUNCATE);
 	msg->displayTime = displayTime;
 	msg->waitForInput = waitForInput;
 	msg->onFinish = NULL;
@@ -68,7 +70,8 @@ void enqueueBattleMessage(BattleMessageQueue* queue, const char* text, float dis
 }
 /// @brief 
 /// @param queue 
-void _battleMessageQueueDraw(Object* obj)
+/// @param alpha 
+void _battleMessageQueueDraw(Object* obj, float alpha)
 {
     BattleMessageQueue* queue = (BattleMessageQueue*)obj;
 
@@ -119,7 +122,6 @@ void _battleMessageQueueUpdate(Object* obj, uint32_t milliseconds)
         if (inputKeyPressed(VK_SPACE))
         {
             // Advance to next message
-            free(msg->text);
             queue->head = (queue->head + 1) % MAX_BATTLE_MESSAGES;
         }
     }
@@ -131,7 +133,6 @@ void _battleMessageQueueUpdate(Object* obj, uint32_t milliseconds)
         if (queue->currentTimer >= msg->displayTime)
         {
             // Advance
-            free(msg->text);
             queue->head = (queue->head + 1) % MAX_BATTLE_MESSAGES;
             queue->currentTimer = 0.0f;
         }
@@ -145,8 +146,8 @@ void _battleMessageQueueUpdate(Object* obj, uint32_t milliseconds)
 }
 /// @brief 
 /// @param obj 
-/// @param milliseconds 
-void _battleMessageQueueFixedUpdate(Object* obj, uint32_t milliseconds)
+/// @param seconds 
+void _battleMessageQueueFixedUpdate(Object* obj, float seconds)
 {
 	// Should ideally do nothing, unless I need to move the update into this
 }
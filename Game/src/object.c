@@ -1,8 +1,18 @@
+#include <assert.h>
 #include "baseTypes.h"
 #include "object.h"
+#include "broadphase.h"
 
 static ObjRegistrationFunc _registerFunc = NULL;
 static ObjRegistrationFunc _deregisterFunc = NULL;
+static TransformStore* _transforms = NULL;
+static ObjScheduleFunc _scheduleFunc = NULL;
+// which layers each layer collides with, indexed by ObjLayer
+static uint32_t _layerMasks[OBJ_LAYER_COUNT] = {
+    OBJ_LAYER_MASK_ALL, OBJ_LAYER_MASK_ALL, OBJ_LAYER_MASK_ALL, OBJ_LAYER_MASK_ALL, OBJ_LAYER_MASK_ALL
+};
+
+static uint32_t _objFirstInBatch(Object** objs, uint32_t count);
 
 /// @brief Enable callback to a registrar on ObjInit/Deinit
 /// @param registerFunc 
@@ -19,6 +29,52 @@ void objDisableRegistration()
     _registerFunc = _deregisterFunc = NULL;
 }
 
+/// @brief Route objects with a transform index to the given store
+/// @param store 
+void objEnableTransforms(TransformStore* store)
+{
+    _transforms = store;
+}
+
+/// @brief Stop resolving transform indices
+void objDisableTransforms()
+{
+    _transforms = NULL;
+}
+
+/// @brief Route objWakeIn requests to a scheduler
+/// @param scheduleFunc 
+void objEnableTimers(ObjScheduleFunc scheduleFunc)
+{
+    _scheduleFunc = scheduleFunc;
+}
+
+/// @brief Stop accepting objWakeIn requests
+void objDisableTimers()
+{
+    _scheduleFunc = NULL;
+}
+
+/// @brief Set which layers collide with which, for objects initialized from now on
+/// @param layerMasks OBJ_LAYER_COUNT masks of OBJ_LAYER_BITs, indexed by ObjLayer. A pair
+/// collides only if each side's mask has the other's layer. NULL lets everything collide
+void objSetLayerMatrix(const uint32_t* layerMasks)
+{
+    for (uint32_t layer = 0; layer < OBJ_LAYER_COUNT; ++layer)
+    {
+        _layerMasks[layer] = layerMasks != NULL ? layerMasks[layer] : OBJ_LAYER_MASK_ALL;
+    }
+}
+
+/// @brief Which layers a layer collides with, per the current matrix
+/// @param layer 
+/// @return OBJ_LAYER_BITs
+uint32_t objGetLayerMask(ObjLayer layer)
+{
+    assert(layer < OBJ_LAYER_COUNT);
+    return layer < OBJ_LAYER_COUNT ? _layerMasks[layer] : OBJ_LAYER_MASK_ALL;
+}
+
 /// @brief Initialize an object. Intended to be called from subclass constructors
 /// @param obj 
 /// @param vtable 
@@ -26,10 +82,17 @@ void objDisableRegistration()
 /// @param vel 
 void objInit(Object* obj, ObjVtable* vtable, Coord2D pos, Coord2D vel)
 {
+    ObjLayer layer = vtable != NULL ? vtable->layer : OBJ_LAYER_DEFAULT;
     obj->vtable = vtable;
-    obj->position = pos;
-    obj->velocity = vel;
-    obj->nextUpdate = (uint32_t)FRAME_TIME_MS;
+    obj->category = OBJ_LAYER_BIT(layer);
+    obj->collideMask = objGetLayerMask(layer);
+    obj->position = realCoordFromFloat(pos);
+    obj->velocity = realCoordFromFloat(vel);
+    obj->acceleration.x = 0;
+    obj->acceleration.y = 0;
+    obj->prevPosition = obj->position;
+    obj->mgrSlot = OBJ_INVALID_SLOT;
+    obj->transform = OBJ_NO_TRANSFORM;
     if (_registerFunc != NULL)
     {
         _registerFunc(obj);
@@ -48,11 +111,12 @@ void objDeinit(Object* obj)
 
 /// @brief Draw this object, using it's vtable
 /// @param obj 
-void objDraw(Object* obj)
+/// @param alpha interpolation between the previous & current fixed step
+void objDraw(Object* obj, float alpha)
 {
     if (obj->vtable != NULL && obj->vtable->draw != NULL) 
     {
-        obj->vtable->draw(obj);
+        obj->vtable->draw(obj, alpha);
     }
 }
 
@@ -64,31 +128,374 @@ void objUpdate(Object* obj, uint32_t milliseconds)
     if (obj->vtable != NULL && obj->vtable->update != NULL) 
     {
         obj->vtable->update(obj, milliseconds);
+    }
+}
+
+/// @brief Draw a span of same-typed objects, in one call if the type supports it
+/// @param objs 
+/// @param count 
+/// @param alpha 
+void objDrawBatch(Object** objs, uint32_t count, float alpha)
+{
+    uint32_t first = _objFirstInBatch(objs, count);
+    if (first == count)
+    {
+        return;
+    }
+
+    ObjVtable* vtable = objs[first]->vtable;
+    if (vtable != NULL && vtable->drawBatch != NULL)
+    {
+        vtable->drawBatch(objs, count, alpha);
         return;
     }
 
-    objDefaultUpdate(obj, milliseconds);
+    for (uint32_t i = first; i < count; ++i)
+    {
+        if (objs[i] != NULL)
+        {
+            objDraw(objs[i], alpha);
+        }
+    }
 }
 
-void objFixedUpdate(Object* obj, uint32_t milliseconds)
+/// @brief Update a span of same-typed objects, in one call if the type supports it
+/// @param objs 
+/// @param count 
+/// @param milliseconds 
+void objUpdateBatch(Object** objs, uint32_t count, uint32_t milliseconds)
 {
+    uint32_t first = _objFirstInBatch(objs, count);
+    if (first == count)
+    {
+        return;
+    }
 
-    //// Check if the object has to be updated
-    //if (obj->nextUpdate > milliseconds)
-    //{
-    //    obj->nextUpdate -= milliseconds;
-    //    return;
-    //}
+    ObjVtable* vtable = objs[first]->vtable;
+    if (vtable != NULL && vtable->updateBatch != NULL)
+    {
+        vtable->updateBatch(objs, count, milliseconds);
+        return;
+    }
 
-    // if object has to be updated, call that function
+    for (uint32_t i = first; i < count; ++i)
+    {
+        if (objs[i] != NULL)
+        {
+            objUpdate(objs[i], milliseconds);
+        }
+    }
+}
+
+/// @brief Advance this object by one fixed step, using it's vtable
+/// @param obj 
+/// @param seconds length of the step
+void objFixedUpdate(Object* obj, float seconds)
+{
     if (obj->vtable != NULL && obj->vtable->fixedUpdate != NULL)
     {
-        obj->vtable->fixedUpdate(obj, milliseconds);
+        obj->vtable->fixedUpdate(obj, seconds);
+        return;
+    }
+
+    objDefaultUpdate(obj, seconds);
+}
+
+/// @brief Deliver a scheduled wakeup, using it's vtable
+/// @param obj 
+void objWake(Object* obj)
+{
+    if (obj->vtable != NULL && obj->vtable->wake != NULL)
+    {
+        obj->vtable->wake(obj);
+    }
+}
+
+/// @brief Ask for this object's wake handler to be called once, after a delay. The request
+/// is dropped if the object is deinitialized first
+/// @param obj 
+/// @param milliseconds 
+/// @return false if no scheduler is enabled, or it is out of timers
+bool objWakeIn(Object* obj, uint32_t milliseconds)
+{
+    if (_scheduleFunc == NULL)
+    {
+        return false;
+    }
+    return _scheduleFunc(obj, milliseconds);
+}
+
+/// @brief Get the box the object currently occupies
+/// @param obj 
+/// @param box 
+/// @return false if the object's type doesn't declare bounds
+bool objGetBounds(const Object* obj, Bounds2D* box)
+{
+    if (obj->vtable == NULL || obj->vtable->getBounds == NULL)
+    {
+        return false;
+    }
+    obj->vtable->getBounds(obj, box);
+    return true;
+}
+
+/// @brief Where a ray enters the object. Types without an exact shape are their bounds box
+/// @param obj 
+/// @param origin 
+/// @param direction unit length
+/// @param maxDistance 
+/// @param distance set to the entry distance when there is a hit; 0 if the ray starts inside
+/// @return false on a miss, or if the type declares neither a shape nor bounds
+bool objRaycast(const Object* obj, Coord2D origin, Coord2D direction, float maxDistance, float* distance)
+{
+    if (obj->vtable != NULL && obj->vtable->raycast != NULL)
+    {
+        return obj->vtable->raycast(obj, origin, direction, maxDistance, distance);
+    }
+
+    Bounds2D box;
+    return objGetBounds(obj, &box) && broadphaseRayEntersBox(&box, origin, direction, maxDistance, distance);
+}
+
+/// @brief Whether a point is inside the object's exact shape, or its bounds if it has none
+/// @param obj 
+/// @param point 
+/// @return 
+bool objContainsPoint(const Object* obj, Coord2D point)
+{
+    // a ray going nowhere only hits if it starts inside
+    Coord2D anyDirection = { 1.0f, 0.0f };
+    float distance;
+    return objRaycast(obj, point, anyDirection, 0.0f, &distance);
+}
+
+/// @brief Whether the object is on one of the layers in the mask
+/// @param obj 
+/// @param mask OBJ_LAYER_BITs
+/// @return 
+bool objInLayers(const Object* obj, uint32_t mask)
+{
+    return (obj->category & mask) != 0;
+}
+
+/// @brief Whether two objects' filters let them collide
+/// @param a 
+/// @param b 
+/// @return 
+bool objShouldCollide(const Object* a, const Object* b)
+{
+    return (a->category & b->collideMask) != 0 && (b->category & a->collideMask) != 0;
+}
+
+/// @brief Override the layers an object is on & collides with. Broadphases that filter
+/// pairs pick the change up on their next update
+/// @param obj 
+/// @param category OBJ_LAYER_BITs
+/// @param collideMask OBJ_LAYER_BITs
+void objSetCollisionFilter(Object* obj, uint32_t category, uint32_t collideMask)
+{
+    obj->category = category;
+    obj->collideMask = collideMask;
+}
+
+/// @brief Advance a span of same-typed objects by one fixed step, in one call if the type supports it
+/// @param objs 
+/// @param count 
+/// @param seconds 
+void objFixedUpdateBatch(Object** objs, uint32_t count, float seconds)
+{
+    uint32_t first = _objFirstInBatch(objs, count);
+    if (first == count)
+    {
+        return;
+    }
+
+    ObjVtable* vtable = objs[first]->vtable;
+    if (vtable != NULL && vtable->fixedUpdateBatch != NULL)
+    {
+        vtable->fixedUpdateBatch(objs, count, seconds);
+        return;
+    }
+
+    for (uint32_t i = first; i < count; ++i)
+    {
+        if (objs[i] != NULL)
+        {
+            objFixedUpdate(objs[i], seconds);
+        }
+    }
+}
+
+/// @brief Semi-implicit Euler over the step: accelerate first, then move at the new velocity,
+/// which keeps bouncing & orbiting motion from gaining energy. Objects with an attached
+/// transform are integrated in bulk by their owner instead, so this is a no-op for them
+/// @param obj 
+/// @param seconds 
+void objDefaultUpdate(Object* obj, float seconds)
+{
+    if (obj->transform != OBJ_NO_TRANSFORM)
+    {
+        return;
     }
+
+    Real dt = realFromFloat(seconds);
+    obj->velocity.x += realMul(obj->acceleration.x, dt);
+    obj->velocity.y += realMul(obj->acceleration.y, dt);
+    obj->position.x += realMul(obj->velocity.x, dt);
+    obj->position.y += realMul(obj->velocity.y, dt);
 }
 
-void objDefaultUpdate(Object* obj, uint32_t milliseconds)
+/// @brief Current position, wherever it is stored
+/// @param obj 
+/// @return 
+Coord2D objGetPosition(const Object* obj)
+{
+    return realCoordToFloat(objGetRealPosition(obj));
+}
+
+/// @brief Set the position, wherever it is stored
+/// @param obj 
+/// @param pos 
+void objSetPosition(Object* obj, Coord2D pos)
 {
-    obj->position.x += obj->velocity.x;
-    obj->position.y += obj->velocity.y;
-}
\ No newline at end of file
+    objSetRealPosition(obj, realCoordFromFloat(pos));
+}
+
+/// @brief Current velocity, wherever it is stored
+/// @param obj 
+/// @return 
+Coord2D objGetVelocity(const Object* obj)
+{
+    return realCoordToFloat(objGetRealVelocity(obj));
+}
+
+/// @brief Set the velocity, wherever it is stored
+/// @param obj 
+/// @param vel 
+void objSetVelocity(Object* obj, Coord2D vel)
+{
+    objSetRealVelocity(obj, realCoordFromFloat(vel));
+}
+
+/// @brief Current acceleration, wherever it is stored
+/// @param obj 
+/// @return units per second per second
+Coord2D objGetAcceleration(const Object* obj)
+{
+    RealCoord2D accel = obj->acceleration;
+    if (obj->transform != OBJ_NO_TRANSFORM && _transforms != NULL)
+    {
+        accel.x = _transforms->accX[obj->transform];
+        accel.y = _transforms->accY[obj->transform];
+    }
+    return realCoordToFloat(accel);
+}
+
+/// @brief Set the acceleration (e.g. gravity, or a force over mass), wherever it is stored
+/// @param obj 
+/// @param accel units per second per second
+void objSetAcceleration(Object* obj, Coord2D accel)
+{
+    RealCoord2D realAccel = realCoordFromFloat(accel);
+    if (obj->transform != OBJ_NO_TRANSFORM && _transforms != NULL)
+    {
+        _transforms->accX[obj->transform] = realAccel.x;
+        _transforms->accY[obj->transform] = realAccel.y;
+        return;
+    }
+    obj->acceleration = realAccel;
+}
+
+/// @brief Position to draw at, blended between the previous & current fixed step
+/// @param obj 
+/// @param alpha 0 is the previous step, 1 the current one
+/// @return 
+Coord2D objGetDrawPosition(const Object* obj, float alpha)
+{
+    Coord2D prev = realCoordToFloat(objGetRealPrevPosition(obj));
+    Coord2D cur = objGetPosition(obj);
+
+    Coord2D pos = { prev.x + (cur.x - prev.x) * alpha, prev.y + (cur.y - prev.y) * alpha };
+    return pos;
+}
+
+/// @brief Current position in simulation units, wherever it is stored
+/// @param obj 
+/// @return 
+RealCoord2D objGetRealPosition(const Object* obj)
+{
+    if (obj->transform != OBJ_NO_TRANSFORM && _transforms != NULL)
+    {
+        RealCoord2D pos = { _transforms->posX[obj->transform], _transforms->posY[obj->transform] };
+        return pos;
+    }
+    return obj->position;
+}
+
+/// @brief Set the position in simulation units, wherever it is stored
+/// @param obj 
+/// @param pos 
+void objSetRealPosition(Object* obj, RealCoord2D pos)
+{
+    if (obj->transform != OBJ_NO_TRANSFORM && _transforms != NULL)
+    {
+        _transforms->posX[obj->transform] = pos.x;
+        _transforms->posY[obj->transform] = pos.y;
+        return;
+    }
+    obj->position = pos;
+}
+
+/// @brief Current velocity in simulation units, wherever it is stored
+/// @param obj 
+/// @return 
+RealCoord2D objGetRealVelocity(const Object* obj)
+{
+    if (obj->transform != OBJ_NO_TRANSFORM && _transforms != NULL)
+    {
+        RealCoord2D vel = { _transforms->velX[obj->transform], _transforms->velY[obj->transform] };
+        return vel;
+    }
+    return obj->velocity;
+}
+
+/// @brief Set the velocity in simulation units, wherever it is stored
+/// @param obj 
+/// @param vel 
+void objSetRealVelocity(Object* obj, RealCoord2D vel)
+{
+    if (obj->transform != OBJ_NO_TRANSFORM && _transforms != NULL)
+    {
+        _transforms->velX[obj->transform] = vel.x;
+        _transforms->velY[obj->transform] = vel.y;
+        return;
+    }
+    obj->velocity = vel;
+}
+
+/// @brief Position at the start of the current fixed step, in simulation units
+/// @param obj 
+/// @return 
+RealCoord2D objGetRealPrevPosition(const Object* obj)
+{
+    if (obj->transform != OBJ_NO_TRANSFORM && _transforms != NULL)
+    {
+        RealCoord2D prev = { _transforms->prevX[obj->transform], _transforms->prevY[obj->transform] };
+        return prev;
+    }
+    return obj->prevPosition;
+}
+
+/// @brief Find the first object in a batch span that wasn't removed mid-pass
+/// @param objs 
+/// @param count 
+/// @return count if every entry was removed
+static uint32_t _objFirstInBatch(Object** objs, uint32_t count)
+{
+    uint32_t i = 0;
+    while (i < count && objs[i] == NULL)
+    {
+        ++i;
+    }
+    return i;
+}
@@ -3,26 +3,188 @@
 #include <assert.h>
 #include "objmgr.h"
 #include "baseTypes.h"
+#include "transform.h"
+#include "timerwheel.h"
+#include "jobs.h"
+#include "aabbtree.h"
+
+// marks the end of the free slot chain
+#define OBJMGR_FREE_END UINT32_MAX
+// live index of a slot reserved by an add that waits for the current pass to end
+#define OBJMGR_PENDING UINT32_MAX
+// number of distinct object types (vtables) that can be batched per frame
+#define OBJMGR_MAX_TYPES 32
+// jobs per thread when a thread-safe type is updated across worker threads; a few each, since
+// per-object cost varies a lot by type (an emitter may hold thousands of particles)
+#define OBJMGR_JOBS_PER_THREAD 4
+// transforms per job when integrating across worker threads; a multiple of TRANSFORM_LANES
+#define OBJMGR_INTEGRATE_GRAIN 4096
+// default length of one fixed (physics) step
+#define OBJMGR_FIXED_STEP_MS ((uint32_t)FRAME_TIME_MS)
+// default integration & collision passes per fixed step
+#define OBJMGR_SUBSTEPS 1
+// most substeps a fixed step can be split into
+#define OBJMGR_MAX_SUBSTEPS 16
+// most fixed steps run per frame; past this, time is dropped rather than caught up
+#define OBJMGR_MAX_FIXED_STEPS 5
+// pending wakeups the timer wheel can hold, per object
+#define OBJMGR_TIMERS_PER_OBJECT 2
+// how far bounds may move before the tree has to be updated; a few fixed steps of a fast ball
+#define OBJMGR_BOUNDS_MARGIN 16.0f
+
+// FNV-1a parameters for the state hash
+#define OBJMGR_HASH_OFFSET 0xCBF29CE484222325ull
+#define OBJMGR_HASH_PRIME 0x100000001B3ull
+
+/// @brief A single storage slot; free slots are chained through nextFree
+typedef struct objmgr_slot_t {
+	Object* obj;
+	uint32_t nextFree;
+	uint32_t liveIndex;		// position of obj within the packed live array, or OBJMGR_PENDING
+	uint32_t generation;	// bumped on every removal, invalidating old handles
+	uint32_t proxy;			// broadphase proxy, for objects that declare bounds
+	uint32_t batchIndex;	// position of obj within the batch array, as of the last pass
+} ObjMgrSlot;
+
+typedef enum objmgr_cmd_type_t {
+	OBJMGR_CMD_ADD,
+	OBJMGR_CMD_REMOVE,
+	OBJMGR_CMD_DESTROY
+} ObjMgrCmdType;
+
+/// @brief A registration change that arrived while objects were being iterated. Only the
+/// handle is kept, since the object may be freed before the flush
+typedef struct objmgr_cmd_t {
+	ObjMgrCmdType type;
+	ObjHandle handle;
+	ObjDestroyFunc destroyFunc;
+} ObjMgrCmd;
+
+/// @brief A contiguous run of same-typed objects within the batch array
+typedef struct objmgr_bucket_t {
+	ObjVtable* vtable;
+	uint32_t start;
+	uint32_t count;
+} ObjMgrBucket;
+
+/// @brief Arguments shared by every chunk of a parallel batch update
+typedef struct objmgr_parallel_update_t {
+	Object** objs;
+	uint32_t milliseconds;
+} ObjMgrParallelUpdate;
+
+/// @brief Arguments shared by every chunk of a parallel integration
+typedef struct objmgr_parallel_integrate_t {
+	TransformStore* transforms;
+	float seconds;
+} ObjMgrParallelIntegrate;
 
 static struct objmgr_t {
-	Object** list;
+	ObjMgrSlot* list;
+	Object** live;			// packed array of the first count live objects
 	uint32_t max;
 	uint32_t count;
-} _objMgr = { NULL, 0, 0 };
+	uint32_t freeHead;
+	uint32_t deadCount;			// live entries nulled by removals mid-pass, packed away by the flush
+	TransformStore* transforms;	// optional; packed in the same order as live
+	TimerWheel* timers;			// scheduled wakeups, keyed by object handle
+	Broadphase* bounds;			// tree of every object that declares bounds; user data is the object
+
+	// live objects regrouped by vtable, rebuilt for each update & draw pass
+	Object** batch;
+	ObjMgrBucket buckets[OBJMGR_MAX_TYPES];
+	uint32_t bucketCount;
+
+	// changes deferred until the current update/draw pass is done
+	ObjMgrCmd* cmds;
+	uint32_t cmdCount;
+	uint32_t maxCmds;
+	uint32_t iterating;
+
+	// fixed step scheduling
+	uint32_t stepMs;		// length of a fixed step
+	uint32_t substeps;		// integration & collision passes per fixed step
+	uint32_t accumulator;	// frame time not yet simulated
+	uint32_t stepCount;		// fixed steps run since init
+	float alpha;			// accumulator as a fraction of a step, for draw interpolation
+} _objMgr = { NULL, NULL, 0, 0, OBJMGR_FREE_END, 0, NULL, NULL };
+
+static void _objMgrAddNow(Object* obj);
+static uint32_t _objMgrReserveSlot(Object* obj);
+static void _objMgrLinkSlot(uint32_t slot);
+static void _objMgrRemoveNow(Object* obj);
+static void _objMgrReleaseSlot(ObjHandle handle);
+static void _objMgrKillSlot(Object* obj);
+static void _objMgrRetireSlot(uint32_t slot);
+static void _objMgrFreeSlot(uint32_t slot);
+static void _objMgrPackLive();
+static void _objMgrQueue(ObjMgrCmdType type, ObjHandle handle, ObjDestroyFunc destroyFunc);
+static void _objMgrWake(void* context, uint32_t handle);
+static void _objMgrBeginIteration();
+static void _objMgrEndIteration();
+static void _objMgrFixedStep();
+static void _objMgrRefitBounds();
+static bool _objMgrBuildBuckets();
+static void _objMgrUpdateBucket(const ObjMgrBucket* bucket, uint32_t milliseconds);
+static void _objMgrUpdateRange(void* data, uint32_t begin, uint32_t end);
+static void _objMgrIntegrateRange(void* data, uint32_t begin, uint32_t end);
+static uint32_t _objMgrFindBucket(ObjVtable* vtable);
+static uint64_t _objMgrHashBytes(uint64_t hash, const void* data, size_t size);
 
 /// @brief Initialize the object manager
 /// @param maxObjects 
-void objMgrInit(uint32_t maxObjects)
+/// @param useTransformStore keep positions & velocities in SoA storage, integrated in bulk
+void objMgrInit(uint32_t maxObjects, bool useTransformStore)
 {
+	// slot indices must fit in a handle
+	assert(maxObjects <= OBJ_HANDLE_INDEX_MASK + 1);
+
 	// allocate the required space
-	_objMgr.list = malloc(maxObjects * sizeof(Object*));
-	if (_objMgr.list != NULL) {
-		// initialize as empty
-		ZeroMemory(_objMgr.list, maxObjects * sizeof(Object*));
+	_objMgr.list = malloc(maxObjects * sizeof(ObjMgrSlot));
+	_objMgr.live = malloc(maxObjects * sizeof(Object*));
+	_objMgr.batch = malloc(maxObjects * sizeof(Object*));
+	// every object can be added and removed within one pass
+	_objMgr.cmds = malloc(2 * maxObjects * sizeof(ObjMgrCmd));
+	if (_objMgr.list != NULL && _objMgr.live != NULL && _objMgr.batch != NULL && _objMgr.cmds != NULL) {
+		// initialize as empty, with every slot chained onto the free list
+		for (uint32_t i = 0; i < maxObjects; ++i)
+		{
+			_objMgr.list[i].obj = NULL;
+			_objMgr.list[i].nextFree = i + 1;
+			_objMgr.list[i].liveIndex = 0;
+			_objMgr.list[i].generation = 1;
+			_objMgr.list[i].proxy = BROADPHASE_INVALID_PROXY;
+			_objMgr.list[i].batchIndex = 0;
+		}
+		if (maxObjects > 0)
+		{
+			_objMgr.list[maxObjects - 1].nextFree = OBJMGR_FREE_END;
+		}
 		_objMgr.max = maxObjects;
 		_objMgr.count = 0;
+		_objMgr.freeHead = maxObjects > 0 ? 0 : OBJMGR_FREE_END;
+		_objMgr.deadCount = 0;
+		_objMgr.cmdCount = 0;
+		_objMgr.maxCmds = 2 * maxObjects;
+		_objMgr.iterating = 0;
+		_objMgr.stepMs = OBJMGR_FIXED_STEP_MS;
+		_objMgr.substeps = OBJMGR_SUBSTEPS;
+		_objMgr.accumulator = 0;
+		_objMgr.stepCount = 0;
+		_objMgr.alpha = 0.0f;
 	}
 
+	if (useTransformStore)
+	{
+		_objMgr.transforms = transformStoreNew(maxObjects);
+		objEnableTransforms(_objMgr.transforms);
+	}
+
+	_objMgr.timers = timerWheelNew(OBJMGR_TIMERS_PER_OBJECT * maxObjects);
+	objEnableTimers(objMgrWakeIn);
+
+	_objMgr.bounds = aabbTreeNew(OBJMGR_BOUNDS_MARGIN);
+
 	// setup registration, so all initialized objects are logged w/ the manager
 	objEnableRegistration(objMgrAdd, objMgrRemove);
 }
@@ -34,95 +196,821 @@ void objMgrShutdown()
 	objDisableRegistration();
 
 	// this isn't strictly required, but want to enforce proper cleanup
-	assert(_objMgr.count == 0);
+	assert(_objMgr.count == 0 && _objMgr.cmdCount == 0);
+
+	objDisableTransforms();
+	transformStoreDelete(_objMgr.transforms);
+	_objMgr.transforms = NULL;
+
+	objDisableTimers();
+	timerWheelDelete(_objMgr.timers);
+	_objMgr.timers = NULL;
+
+	broadphaseDelete(_objMgr.bounds);
+	_objMgr.bounds = NULL;
 
 	// objMgr doesn't own the objects, so just clean up self
 	free(_objMgr.list);
+	free(_objMgr.live);
+	free(_objMgr.batch);
+	free(_objMgr.cmds);
 	_objMgr.list = NULL;
-	_objMgr.max = _objMgr.count = 0;
+	_objMgr.live = NULL;
+	_objMgr.batch = NULL;
+	_objMgr.cmds = NULL;
+	_objMgr.bucketCount = 0;
+	_objMgr.cmdCount = _objMgr.maxCmds = 0;
+	_objMgr.max = _objMgr.count = _objMgr.deadCount = 0;
+	_objMgr.freeHead = OBJMGR_FREE_END;
 }
 
-/// @brief Add an object to be tracked by the manager
+/// @brief Add an object to be tracked by the manager. While objects are being
+/// updated or drawn, the object gets its slot (& so its handle) right away, but joins
+/// the live objects only once the pass completes
 /// @param obj 
 void objMgrAdd(Object* obj)
 {
-	for (uint32_t i = 0; i < _objMgr.max; ++i)
+	if (_objMgr.iterating > 0)
 	{
-		if (_objMgr.list[i] == NULL)
+		uint32_t slot = _objMgrReserveSlot(obj);
+		if (slot != OBJMGR_FREE_END)
 		{
-			_objMgr.list[i] = obj;
-			++_objMgr.count;
-			return;
+			_objMgrQueue(OBJMGR_CMD_ADD, objMgrGetHandle(obj), NULL);
 		}
+		return;
 	}
 
-	// out of space to add object!
-	assert(false);
+	_objMgrAddNow(obj);
 }
 
-/// @brief Remove an object from the manager's tracking
+/// @brief Remove an object from the manager's tracking. Called by objDeinit, right before
+/// the object is freed, so it must not happen to a live object while objects are being
+/// updated or drawn: the pass still holds it. Delete from callbacks through objMgrDestroy
+/// instead. Objects added during the current pass aren't held by it, so they can go at once.
+/// If a live one goes anyway, the pass skips it from then on
 /// @param obj 
 void objMgrRemove(Object* obj)
 {
-	for (uint32_t i = 0; i < _objMgr.max; ++i)
+	uint32_t slot = obj->mgrSlot;
+	bool pending = slot < _objMgr.max && _objMgr.list[slot].obj == obj && _objMgr.list[slot].liveIndex == OBJMGR_PENDING;
+
+	// removing mid-pass! use objMgrDestroy, which defers the free along with the removal
+	assert(_objMgr.iterating == 0 || pending);
+	if (_objMgr.iterating > 0 && !pending)
+	{
+		// the object is about to be freed, so the pass must not reach it again: its entries
+		// are nulled now, & the flush packs the live array & recycles the slot
+		_objMgrKillSlot(obj);
+		return;
+	}
+
+	// a pending object's queued add no longer resolves, so the flush skips it
+	_objMgrRemoveNow(obj);
+}
+
+/// @brief Get the generational handle for a tracked object
+/// @param obj 
+/// @return OBJ_INVALID_HANDLE if the object isn't tracked
+ObjHandle objMgrGetHandle(const Object* obj)
+{
+	uint32_t slot = obj->mgrSlot;
+	if (slot >= _objMgr.max || _objMgr.list[slot].obj != obj)
+	{
+		return OBJ_INVALID_HANDLE;
+	}
+	return (_objMgr.list[slot].generation << OBJ_HANDLE_INDEX_BITS) | slot;
+}
+
+/// @brief Look up the object a handle refers to. Objects added during the current pass
+/// resolve, though they won't be updated or drawn until the next one
+/// @param handle 
+/// @return NULL if the object has since been removed
+Object* objMgrResolve(ObjHandle handle)
+{
+	uint32_t slot = handle & OBJ_HANDLE_INDEX_MASK;
+	uint32_t generation = handle >> OBJ_HANDLE_INDEX_BITS;
+	if (handle == OBJ_INVALID_HANDLE || slot >= _objMgr.max || _objMgr.list[slot].generation != generation)
+	{
+		return NULL;
+	}
+	return _objMgr.list[slot].obj;
+}
+
+/// @brief Destroy the object behind a handle. Safe to call from update & collision
+/// callbacks: while objects are being iterated, the destroy is deferred until the pass completes
+/// @param handle 
+/// @param destroyFunc called with the object to free it (e.g. ballDelete); it is expected
+/// to deinit the object. If NULL, the object is only removed from tracking
+void objMgrDestroy(ObjHandle handle, ObjDestroyFunc destroyFunc)
+{
+	if (_objMgr.iterating > 0)
+	{
+		_objMgrQueue(OBJMGR_CMD_DESTROY, handle, destroyFunc);
+		return;
+	}
+
+	Object* obj = objMgrResolve(handle);
+	if (obj == NULL)
+	{
+		return;
+	}
+
+	if (destroyFunc != NULL)
+	{
+		destroyFunc(obj);
+	}
+	else
+	{
+		_objMgrRemoveNow(obj);
+	}
+}
+
+/// @brief Apply all deferred adds, removes & destroys, in the order they were requested.
+/// Called automatically when an update or draw pass completes
+void objMgrFlush()
+{
+	assert(_objMgr.iterating == 0);
+
+	// close the holes left by mid-pass removals first, since the commands below pack the
+	// live array by moving its last entry, which has to be a real object
+	if (_objMgr.deadCount > 0)
+	{
+		_objMgrPackLive();
+	}
+
+	// commands issued by destroy callbacks run immediately, since we're not iterating
+	for (uint32_t i = 0; i < _objMgr.cmdCount; ++i)
+	{
+		ObjMgrCmd* cmd = &_objMgr.cmds[i];
+		switch (cmd->type)
+		{
+		case OBJMGR_CMD_ADD:
+			// skipped if the object was removed (& likely freed) before the pass ended
+			if (objMgrResolve(cmd->handle) != NULL)
+			{
+				_objMgrLinkSlot(cmd->handle & OBJ_HANDLE_INDEX_MASK);
+			}
+			break;
+		case OBJMGR_CMD_REMOVE:
+			// the slot died mid-pass & its handle is already stale; only recycling is left
+			_objMgrFreeSlot(cmd->handle & OBJ_HANDLE_INDEX_MASK);
+			break;
+		case OBJMGR_CMD_DESTROY:
+			objMgrDestroy(cmd->handle, cmd->destroyFunc);
+			break;
+		}
+	}
+	_objMgr.cmdCount = 0;
+}
+
+/// @brief Schedule a call to the object's wake handler after a delay. Sleeping objects cost
+/// nothing per frame, and wakeups for objects removed in the meantime are dropped
+/// @param obj 
+/// @param milliseconds 
+/// @return false if the object isn't tracked, or the timer wheel is full
+bool objMgrWakeIn(Object* obj, uint32_t milliseconds)
+{
+	// objects added this pass already have their handle
+	ObjHandle handle = objMgrGetHandle(obj);
+	if (handle == OBJ_INVALID_HANDLE || _objMgr.timers == NULL)
+	{
+		return false;
+	}
+	return timerWheelSchedule(_objMgr.timers, milliseconds, _objMgrWake, NULL, handle);
+}
+
+/// @brief The broadphase tracking every object that declares bounds, for region, point & ray
+/// queries and overlapping pairs. Proxy user data is the Object*. Bounds are refit after
+/// each fixed step
+/// @return NULL if the manager isn't initialized
+Broadphase* objMgrGetBroadphase()
+{
+	return _objMgr.bounds;
+}
+
+/// @brief Timer callback; wakes the object if it is still around
+/// @param context 
+/// @param handle 
+static void _objMgrWake(void* context, uint32_t handle)
+{
+	Object* obj = objMgrResolve(handle);
+	if (obj != NULL)
+	{
+		objWake(obj);
+	}
+}
+
+/// @brief Start tracking an object immediately
+/// @param obj 
+static void _objMgrAddNow(Object* obj)
+{
+	uint32_t slot = _objMgrReserveSlot(obj);
+	if (slot != OBJMGR_FREE_END)
+	{
+		_objMgrLinkSlot(slot);
+	}
+}
+
+/// @brief Give an object a slot, & so a handle, without making it live yet
+/// @param obj 
+/// @return the slot, or OBJMGR_FREE_END if the manager is full
+static uint32_t _objMgrReserveSlot(Object* obj)
+{
+	// out of space to add object!
+	assert(_objMgr.freeHead != OBJMGR_FREE_END);
+	if (_objMgr.freeHead == OBJMGR_FREE_END)
+	{
+		return OBJMGR_FREE_END;
+	}
+
+	// pop the first free slot off the chain
+	uint32_t slot = _objMgr.freeHead;
+	_objMgr.freeHead = _objMgr.list[slot].nextFree;
+
+	_objMgr.list[slot].obj = obj;
+	_objMgr.list[slot].liveIndex = OBJMGR_PENDING;
+	_objMgr.list[slot].proxy = BROADPHASE_INVALID_PROXY;
+	obj->mgrSlot = slot;
+	return slot;
+}
+
+/// @brief Make a reserved slot's object live: updated, drawn & in the bounds tree
+/// @param slot 
+static void _objMgrLinkSlot(uint32_t slot)
+{
+	Object* obj = _objMgr.list[slot].obj;
+
+	// append to the end of the packed live array
+	_objMgr.list[slot].liveIndex = _objMgr.count;
+	_objMgr.live[_objMgr.count] = obj;
+	if (_objMgr.transforms != NULL)
+	{
+		transformStoreSet(_objMgr.transforms, _objMgr.count, obj->position, obj->velocity, obj->acceleration);
+		obj->transform = _objMgr.count;
+	}
+	++_objMgr.count;
+
+	// the transform is in place, so the bounds are where the object is
+	Bounds2D box;
+	if (_objMgr.bounds != NULL && objGetBounds(obj, &box))
+	{
+		_objMgr.list[slot].proxy = broadphaseAdd(_objMgr.bounds, &box, obj);
+	}
+}
+
+/// @brief Stop tracking an object immediately
+/// @param obj 
+static void _objMgrRemoveNow(Object* obj)
+{
+	uint32_t slot = obj->mgrSlot;
+
+	// could not find object to remove!
+	assert(slot < _objMgr.max && _objMgr.list[slot].obj == obj);
+	if (slot >= _objMgr.max || _objMgr.list[slot].obj != obj)
+	{
+		return;
+	}
+
+	// hand the transform back to the object, so it stays usable once untracked
+	if (_objMgr.transforms != NULL && _objMgr.list[slot].liveIndex != OBJMGR_PENDING)
+	{
+		obj->position = objGetRealPosition(obj);
+		obj->velocity = objGetRealVelocity(obj);
+		obj->acceleration.x = _objMgr.transforms->accX[obj->transform];
+		obj->acceleration.y = _objMgr.transforms->accY[obj->transform];
+		obj->prevPosition = objGetRealPrevPosition(obj);
+	}
+
+	_objMgrReleaseSlot(objMgrGetHandle(obj));
+	obj->transform = OBJ_NO_TRANSFORM;
+	obj->mgrSlot = OBJ_INVALID_SLOT;
+}
+
+/// @brief Drop a slot & recycle it, without touching the object it held (which may
+/// already be freed)
+/// @param handle 
+static void _objMgrReleaseSlot(ObjHandle handle)
+{
+	// stale handle, or the object was never tracked
+	if (objMgrResolve(handle) == NULL)
 	{
-		if (obj == _objMgr.list[i])
+		return;
+	}
+	uint32_t slot = handle & OBJ_HANDLE_INDEX_MASK;
+
+	if (_objMgr.list[slot].proxy != BROADPHASE_INVALID_PROXY)
+	{
+		broadphaseRemove(_objMgr.bounds, _objMgr.list[slot].proxy);
+		_objMgr.list[slot].proxy = BROADPHASE_INVALID_PROXY;
+	}
+
+	// fill the hole in the live array with the last live object, so it stays packed; a
+	// pending object never joined it
+	uint32_t liveIndex = _objMgr.list[slot].liveIndex;
+	uint32_t lastIndex = _objMgr.count - 1;
+	bool live = liveIndex != OBJMGR_PENDING;
+	if (live && liveIndex != lastIndex)
+	{
+		Object* last = _objMgr.live[lastIndex];
+		_objMgr.live[liveIndex] = last;
+		_objMgr.list[last->mgrSlot].liveIndex = liveIndex;
+		if (_objMgr.transforms != NULL)
 		{
-			// no need to free memory, so just clear the reference
-			_objMgr.list[i] = NULL;
-			--_objMgr.count;
-			return;
+			transformStoreMove(_objMgr.transforms, liveIndex, lastIndex);
+			last->transform = liveIndex;
 		}
 	}
 
+	// no need to free memory, so just clear the reference & recycle the slot
+	_objMgrRetireSlot(slot);
+	_objMgrFreeSlot(slot);
+	if (live)
+	{
+		--_objMgr.count;
+	}
+}
+
+/// @brief Take a live object out of the current pass at once, for a removal that couldn't
+/// wait: its handle goes stale & its live & batch entries are nulled, so iteration skips
+/// them. The slot stays out of the free chain until the flush, so it can't be reused mid-pass
+/// @param obj 
+static void _objMgrKillSlot(Object* obj)
+{
+	uint32_t slot = obj->mgrSlot;
+
 	// could not find object to remove!
-	assert(false);
+	assert(slot < _objMgr.max && _objMgr.list[slot].obj == obj);
+	if (slot >= _objMgr.max || _objMgr.list[slot].obj != obj)
+	{
+		return;
+	}
+	ObjHandle handle = objMgrGetHandle(obj);
+
+	// hand the transform back, as for any other removal
+	if (_objMgr.transforms != NULL)
+	{
+		obj->position = objGetRealPosition(obj);
+		obj->velocity = objGetRealVelocity(obj);
+		obj->acceleration.x = _objMgr.transforms->accX[obj->transform];
+		obj->acceleration.y = _objMgr.transforms->accY[obj->transform];
+		obj->prevPosition = objGetRealPrevPosition(obj);
+	}
+
+	if (_objMgr.list[slot].proxy != BROADPHASE_INVALID_PROXY)
+	{
+		broadphaseRemove(_objMgr.bounds, _objMgr.list[slot].proxy);
+		_objMgr.list[slot].proxy = BROADPHASE_INVALID_PROXY;
+	}
+
+	// the batch index is only current if the buckets were built since the object went live,
+	// so check it still points here
+	_objMgr.live[_objMgr.list[slot].liveIndex] = NULL;
+	uint32_t batchIndex = _objMgr.list[slot].batchIndex;
+	if (_objMgr.batch[batchIndex] == obj)
+	{
+		_objMgr.batch[batchIndex] = NULL;
+	}
+	++_objMgr.deadCount;
+
+	_objMgrRetireSlot(slot);
+	obj->transform = OBJ_NO_TRANSFORM;
+	obj->mgrSlot = OBJ_INVALID_SLOT;
+
+	_objMgrQueue(OBJMGR_CMD_REMOVE, handle, NULL);
 }
 
-/// @brief Draws all registered objects
+/// @brief Clear a slot's object & bump its generation, so handles to it stop resolving
+/// @param slot 
+static void _objMgrRetireSlot(uint32_t slot)
+{
+	_objMgr.list[slot].obj = NULL;
+	_objMgr.list[slot].generation = (_objMgr.list[slot].generation + 1) & OBJ_HANDLE_GENERATION_MASK;
+	if (_objMgr.list[slot].generation == 0)
+	{
+		// generation 0 is reserved, so that OBJ_INVALID_HANDLE never resolves
+		_objMgr.list[slot].generation = 1;
+	}
+}
+
+/// @brief Push a retired slot onto the free chain
+/// @param slot 
+static void _objMgrFreeSlot(uint32_t slot)
+{
+	_objMgr.list[slot].nextFree = _objMgr.freeHead;
+	_objMgr.freeHead = slot;
+}
+
+/// @brief Close the holes mid-pass removals left in the live array, filling each from the
+/// end the way a single removal does
+static void _objMgrPackLive()
+{
+	uint32_t i = 0;
+	while (i < _objMgr.count)
+	{
+		if (_objMgr.live[i] != NULL)
+		{
+			++i;
+			continue;
+		}
+
+		// the last entry may be dead too, in which case dropping it is all there is to do
+		uint32_t lastIndex = --_objMgr.count;
+		Object* last = _objMgr.live[lastIndex];
+		if (last != NULL && i != lastIndex)
+		{
+			_objMgr.live[i] = last;
+			_objMgr.list[last->mgrSlot].liveIndex = i;
+			if (_objMgr.transforms != NULL)
+			{
+				transformStoreMove(_objMgr.transforms, i, lastIndex);
+				last->transform = i;
+			}
+		}
+	}
+	_objMgr.deadCount = 0;
+}
+
+/// @brief Draws all registered objects, one batch per object type, interpolated
+/// between the last two fixed steps
 void objMgrDraw()
 {
-	for (uint32_t i = 0; i < _objMgr.max; ++i)
+	_objMgrBeginIteration();
+
+	// TODO - consider draw order?
+	if (!_objMgrBuildBuckets())
 	{
-		Object* obj = _objMgr.list[i];
-		if (obj != NULL)
+		for (uint32_t i = 0; i < _objMgr.count; ++i)
 		{
-			// TODO - consider draw order?
-			objDraw(obj);
+			// removed mid-pass
+			if (_objMgr.live[i] != NULL)
+			{
+				objDraw(_objMgr.live[i], _objMgr.alpha);
+			}
 		}
 	}
+	else
+	{
+		for (uint32_t b = 0; b < _objMgr.bucketCount; ++b)
+		{
+			ObjMgrBucket* bucket = &_objMgr.buckets[b];
+			objDrawBatch(_objMgr.batch + bucket->start, bucket->count, _objMgr.alpha);
+		}
+	}
+
+	_objMgrEndIteration();
 }
 
-/// @brief Updates all registered objects
+/// @brief Per-frame update of all registered objects, one batch per object type, after
+/// delivering any wakeups that came due. Movement & collisions happen in objMgrFixedUpdate
 /// @param milliseconds 
 void objMgrUpdate(uint32_t milliseconds)
 {
-	for (uint32_t i = 0; i < _objMgr.max; ++i)
+	_objMgrBeginIteration();
+
+	if (_objMgr.timers != NULL)
+	{
+		timerWheelAdvance(_objMgr.timers, milliseconds);
+	}
+
+	if (!_objMgrBuildBuckets())
+	{
+		for (uint32_t i = 0; i < _objMgr.count; ++i)
+		{
+			// removed mid-pass
+			if (_objMgr.live[i] != NULL)
+			{
+				objUpdate(_objMgr.live[i], milliseconds);
+			}
+		}
+	}
+	else
 	{
-		Object* obj = _objMgr.list[i];
-		if (obj != NULL)
+		for (uint32_t b = 0; b < _objMgr.bucketCount; ++b)
 		{
-			objUpdate(obj, milliseconds);
+			_objMgrUpdateBucket(&_objMgr.buckets[b], milliseconds);
 		}
 	}
+
+	_objMgrEndIteration();
 }
 
+/// @brief Advance the simulation by the elapsed frame time, in whole fixed steps.
+/// Leftover time carries over to the next frame & sets the draw interpolation alpha
+/// @param milliseconds 
 void objMgrFixedUpdate(uint32_t milliseconds)
 {
-	for (uint32_t i = 0; i < _objMgr.max; ++i)
+	_objMgr.accumulator += milliseconds;
+
+	uint32_t steps = 0;
+	while (_objMgr.accumulator >= _objMgr.stepMs && steps < OBJMGR_MAX_FIXED_STEPS)
+	{
+		_objMgrFixedStep();
+		_objMgr.accumulator -= _objMgr.stepMs;
+		++steps;
+		++_objMgr.stepCount;
+	}
+
+	// too far behind to catch up (e.g. a hitch or breakpoint); drop the backlog instead of
+	// spending ever more of each frame simulating
+	if (_objMgr.accumulator >= _objMgr.stepMs)
+	{
+		_objMgr.accumulator %= _objMgr.stepMs;
+	}
+
+	_objMgr.alpha = (float)_objMgr.accumulator / (float)_objMgr.stepMs;
+}
+
+/// @brief Change the fixed step rate. Movement is integrated over the real step length, so
+/// a longer step (e.g. on a loaded server) changes precision but not speeds
+/// @param milliseconds length of a fixed step
+/// @param substeps integration & collision passes within each step; more keeps fast
+/// objects from passing through each other at long step lengths
+void objMgrSetFixedStep(uint32_t milliseconds, uint32_t substeps)
+{
+	assert(milliseconds > 0 && substeps > 0 && substeps <= OBJMGR_MAX_SUBSTEPS);
+	if (milliseconds == 0 || substeps == 0 || substeps > OBJMGR_MAX_SUBSTEPS)
+	{
+		return;
+	}
+
+	_objMgr.stepMs = milliseconds;
+	_objMgr.substeps = substeps;
+}
+
+/// @brief Number of fixed steps simulated since init
+/// @return 
+uint32_t objMgrGetStepCount()
+{
+	return _objMgr.stepCount;
+}
+
+/// @brief Hash the simulation state: the exact bits of every tracked object's position &
+/// velocity, in manager order. Two runs (or builds) that hash alike after the same number of
+/// steps have simulated identically, which replays & lockstep depend on
+/// @return 
+uint64_t objMgrHashState()
+{
+	uint64_t hash = OBJMGR_HASH_OFFSET;
+	for (uint32_t i = 0; i < _objMgr.count; ++i)
+	{
+		RealCoord2D pos = objGetRealPosition(_objMgr.live[i]);
+		RealCoord2D vel = objGetRealVelocity(_objMgr.live[i]);
+		hash = _objMgrHashBytes(hash, &pos, sizeof(pos));
+		hash = _objMgrHashBytes(hash, &vel, sizeof(vel));
+	}
+	return hash;
+}
+
+/// @brief Fold bytes into an FNV-1a hash
+/// @param hash 
+/// @param data 
+/// @param size 
+/// @return 
+static uint64_t _objMgrHashBytes(uint64_t hash, const void* data, size_t size)
+{
+	const uint8_t* bytes = data;
+	for (size_t i = 0; i < size; ++i)
 	{
-		Object* obj = _objMgr.list[i];
-		if (!obj)
-			return;
-		
-		// Check if the object has to be updated
-		if (obj->nextUpdate > milliseconds)
+		hash ^= bytes[i];
+		hash *= OBJMGR_HASH_PRIME;
+	}
+	return hash;
+}
+
+/// @brief Record a registration change to apply once iteration completes
+/// @param type 
+/// @param handle 
+/// @param destroyFunc 
+static void _objMgrQueue(ObjMgrCmdType type, ObjHandle handle, ObjDestroyFunc destroyFunc)
+{
+	// out of space for deferred commands!
+	assert(_objMgr.cmdCount < _objMgr.maxCmds);
+	if (_objMgr.cmdCount >= _objMgr.maxCmds)
+	{
+		return;
+	}
+
+	ObjMgrCmd* cmd = &_objMgr.cmds[_objMgr.cmdCount++];
+	cmd->type = type;
+	cmd->handle = handle;
+	cmd->destroyFunc = destroyFunc;
+}
+
+/// @brief Mark the start of a pass over the live objects; registration changes get deferred
+static void _objMgrBeginIteration()
+{
+	++_objMgr.iterating;
+}
+
+/// @brief Mark the end of a pass over the live objects, flushing deferred changes
+/// once the outermost pass is done
+static void _objMgrEndIteration()
+{
+	assert(_objMgr.iterating > 0);
+	if (--_objMgr.iterating == 0)
+	{
+		objMgrFlush();
+	}
+}
+
+/// @brief Run a single fixed step over every registered object, as one or more substeps of
+/// integration followed by fixed updates (which is where collisions are resolved)
+static void _objMgrFixedStep()
+{
+	// remember where everything was, for draw interpolation
+	if (_objMgr.transforms != NULL)
+	{
+		transformStoreSnapshot(_objMgr.transforms, _objMgr.count);
+	}
+	else
+	{
+		for (uint32_t i = 0; i < _objMgr.count; ++i)
 		{
-			obj->nextUpdate -= milliseconds;
-			return;
+			Object* obj = _objMgr.live[i];
+			obj->prevPosition = obj->position;
 		}
-		objFixedUpdate(obj, milliseconds);
-		obj->nextUpdate = (uint32_t)(FRAME_TIME_MS);
 	}
+
+	_objMgrBeginIteration();
+
+	// registration changes are deferred, so the buckets hold for every substep
+	bool batched = _objMgrBuildBuckets();
+	float seconds = (float)_objMgr.stepMs / (1000.0f * (float)_objMgr.substeps);
+	for (uint32_t s = 0; s < _objMgr.substeps; ++s)
+	{
+		// integrate every stored transform in one pass, split across worker threads;
+		// objDefaultUpdate skips these objects
+		if (_objMgr.transforms != NULL)
+		{
+			ObjMgrParallelIntegrate args = { _objMgr.transforms, seconds };
+			jobsParallelFor(_objMgr.count, OBJMGR_INTEGRATE_GRAIN, _objMgrIntegrateRange, &args);
+		}
+
+		if (!batched)
+		{
+			for (uint32_t i = 0; i < _objMgr.count; ++i)
+			{
+				// removed mid-pass
+				if (_objMgr.live[i] != NULL)
+				{
+					objFixedUpdate(_objMgr.live[i], seconds);
+				}
+			}
+		}
+		else
+		{
+			for (uint32_t b = 0; b < _objMgr.bucketCount; ++b)
+			{
+				ObjMgrBucket* bucket = &_objMgr.buckets[b];
+				objFixedUpdateBatch(_objMgr.batch + bucket->start, bucket->count, seconds);
+			}
+		}
+	}
+
+	_objMgrRefitBounds();
+
+	_objMgrEndIteration();
 }
 
+/// @brief Bring the bounds tree up to date with where everything moved to. Objects still
+/// inside their fattened boxes cost a containment test; the rest are reinserted
+static void _objMgrRefitBounds()
+{
+	if (_objMgr.bounds == NULL)
+	{
+		return;
+	}
+
+	for (uint32_t i = 0; i < _objMgr.count; ++i)
+	{
+		Object* obj = _objMgr.live[i];
+		if (obj == NULL)
+		{
+			// removed mid-pass, along with its proxy
+			continue;
+		}
+		uint32_t proxy = _objMgr.list[obj->mgrSlot].proxy;
+		Bounds2D box;
+		if (proxy != BROADPHASE_INVALID_PROXY && objGetBounds(obj, &box))
+		{
+			broadphaseMove(_objMgr.bounds, proxy, &box);
+		}
+	}
+}
+
+/// @brief Update one type's span, split across worker threads if the type allows it
+/// @param bucket 
+/// @param milliseconds 
+static void _objMgrUpdateBucket(const ObjMgrBucket* bucket, uint32_t milliseconds)
+{
+	Object** objs = _objMgr.batch + bucket->start;
+
+	// types that only react to wakeups & fixed steps have nothing to do per frame
+	if (bucket->vtable != NULL && bucket->vtable->update == NULL && bucket->vtable->updateBatch == NULL)
+	{
+		return;
+	}
+
+	if (bucket->vtable == NULL || (bucket->vtable->flags & OBJ_FLAG_THREAD_SAFE_UPDATE) == 0)
+	{
+		objUpdateBatch(objs, bucket->count, milliseconds);
+		return;
+	}
+
+	uint32_t jobs = jobsGetThreadCount() * OBJMGR_JOBS_PER_THREAD;
+	uint32_t grain = (bucket->count + jobs - 1) / jobs;
+	ObjMgrParallelUpdate args = { objs, milliseconds };
+	jobsParallelFor(bucket->count, grain, _objMgrUpdateRange, &args);
+}
+
+/// @brief Job body for a parallel batch update
+/// @param data 
+/// @param begin 
+/// @param end 
+static void _objMgrUpdateRange(void* data, uint32_t begin, uint32_t end)
+{
+	ObjMgrParallelUpdate* args = data;
+	objUpdateBatch(args->objs + begin, end - begin, args->milliseconds);
+}
+
+/// @brief Job body for a parallel integration
+/// @param data 
+/// @param begin 
+/// @param end 
+static void _objMgrIntegrateRange(void* data, uint32_t begin, uint32_t end)
+{
+	ObjMgrParallelIntegrate* args = data;
+	transformIntegrateRange(args->transforms, begin, end, args->seconds);
+}
+
+/// @brief Regroup the live objects by vtable into contiguous spans of the batch array.
+/// Types keep the order they are first seen in, and objects keep their live order. Objects
+/// removed earlier in the pass (e.g. by a wakeup) are left out
+/// @return false if there were too many distinct types to batch
+static bool _objMgrBuildBuckets()
+{
+	_objMgr.bucketCount = 0;
+
+	// count the objects of each type
+	for (uint32_t i = 0; i < _objMgr.count; ++i)
+	{
+		if (_objMgr.live[i] == NULL)
+		{
+			continue;
+		}
+		uint32_t b = _objMgrFindBucket(_objMgr.live[i]->vtable);
+		if (b == OBJMGR_MAX_TYPES)
+		{
+			return false;
+		}
+		++_objMgr.buckets[b].count;
+	}
+
+	// lay the buckets out back to back, then reuse count as the fill cursor
+	uint32_t start = 0;
+	for (uint32_t b = 0; b < _objMgr.bucketCount; ++b)
+	{
+		_objMgr.buckets[b].start = start;
+		start += _objMgr.buckets[b].count;
+		_objMgr.buckets[b].count = 0;
+	}
+
+	for (uint32_t i = 0; i < _objMgr.count; ++i)
+	{
+		Object* obj = _objMgr.live[i];
+		if (obj == NULL)
+		{
+			continue;
+		}
+		ObjMgrBucket* bucket = &_objMgr.buckets[_objMgrFindBucket(obj->vtable)];
+		_objMgr.list[obj->mgrSlot].batchIndex = bucket->start + bucket->count;
+		_objMgr.batch[bucket->start + bucket->count++] = obj;
+	}
+
+	return true;
+}
+
+/// @brief Find the bucket for a vtable, claiming a new one if it hasn't been seen yet
+/// @param vtable 
+/// @return the bucket index, or OBJMGR_MAX_TYPES if the table is full
+static uint32_t _objMgrFindBucket(ObjVtable* vtable)
+{
+	for (uint32_t b = 0; b < _objMgr.bucketCount; ++b)
+	{
+		if (_objMgr.buckets[b].vtable == vtable)
+		{
+			return b;
+		}
+	}
+
+	if (_objMgr.bucketCount == OBJMGR_MAX_TYPES)
+	{
+		return OBJMGR_MAX_TYPES;
+	}
+
+	ObjMgrBucket* bucket = &_objMgr.buckets[_objMgr.bucketCount];
+	bucket->vtable = vtable;
+	bucket->start = 0;
+	bucket->count = 0;
+	return _objMgr.bucketCount++;
+}
\ No newline at end of file
@@ -0,0 +1,381 @@
+#include <Windows.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <math.h>
+#include <assert.h>
+#include <immintrin.h>
+#include "baseTypes.h"
+#include "particles.h"
+#include "render.h"
+
+#if defined(__AVX__)
+#define PARTICLE_USE_AVX
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLE_USE_SSE
+#endif
+
+// posX, posY, velX, velY, life, invLifetime, size, color
+#define PARTICLE_ARRAY_COUNT 8
+
+// particles are purely visual; they tick with the frame rather than the fixed step. An update
+// only touches the emitter's own arrays (spawning happens outside the update pass), so emitters
+// are updated in parallel
+static void _particleEmitterDraw(Object* obj, float alpha);
+static void _particleEmitterObjUpdate(Object* obj, uint32_t milliseconds);
+static ObjVtable _particleEmitterVtable = {
+    _particleEmitterDraw,
+    _particleEmitterObjUpdate,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    OBJ_FLAG_THREAD_SAFE_UPDATE,
+    OBJ_LAYER_DEFAULT
+};
+
+static void _particleEmitterAge(ParticleEmitter* emitter, float seconds);
+static void _particleEmitterCompact(ParticleEmitter* emitter);
+static void _particleEmitterMove(ParticleEmitter* emitter, uint32_t dstIndex, uint32_t srcIndex);
+static float _particleRandom(ParticleEmitter* emitter, float min, float max);
+static void _particleSetVertex(RenderVertex* vertex, float x, float y, float u, float v, uint32_t rgba);
+
+/// @brief Allocate an emitter & register it for drawing. All arrays share one aligned block,
+/// sized once here, so spawning never allocates
+/// @param capacity most particles alive at once
+/// @param texture GL texture name; 0 for flat colored quads
+/// @param gravity 
+/// @param drag fraction of velocity lost per second
+/// @return 
+ParticleEmitter* particleEmitterNew(uint32_t capacity, uint32_t texture, Coord2D gravity, float drag)
+{
+    ParticleEmitter* emitter = malloc(sizeof(ParticleEmitter));
+    if (emitter != NULL)
+    {
+        ZeroMemory(emitter, sizeof(ParticleEmitter));
+
+        // round up so every array starts on an aligned boundary
+        uint32_t padded = (capacity + PARTICLE_LANES - 1) & ~(uint32_t)(PARTICLE_LANES - 1);
+        size_t arrayBytes = padded * sizeof(float);
+
+        float* block = _aligned_malloc(PARTICLE_ARRAY_COUNT * arrayBytes, PARTICLE_ALIGNMENT);
+        if (block == NULL)
+        {
+            free(emitter);
+            return NULL;
+        }
+        ZeroMemory(block, PARTICLE_ARRAY_COUNT * arrayBytes);
+
+        emitter->posX = block;
+        emitter->posY = block + padded;
+        emitter->velX = block + 2 * padded;
+        emitter->velY = block + 3 * padded;
+        emitter->life = block + 4 * padded;
+        emitter->invLifetime = block + 5 * padded;
+        emitter->size = block + 6 * padded;
+        emitter->color = (uint32_t*)(block + 7 * padded);
+        emitter->capacity = padded;
+
+        emitter->texture = texture;
+        emitter->gravity = gravity;
+        emitter->drag = drag;
+        emitter->seed = 0x9E3779B9u ^ capacity;
+
+        Coord2D origin = { 0.0f, 0.0f };
+        objInit(&emitter->obj, &_particleEmitterVtable, origin, origin);
+    }
+    return emitter;
+}
+
+/// @brief Unregister an emitter & free its particles
+/// @param emitter 
+void particleEmitterDelete(ParticleEmitter* emitter)
+{
+    if (emitter != NULL)
+    {
+        objDeinit(&emitter->obj);
+        _aligned_free(emitter->posX);
+        free(emitter);
+    }
+}
+
+/// @brief Throw a burst of particles off a point. Whatever doesn't fit is dropped
+/// @param emitter 
+/// @param burst 
+/// @param point 
+/// @param normal direction the burst is centered on; need not be unit length
+void particleEmitterBurst(ParticleEmitter* emitter, const ParticleBurst* burst, Coord2D point, Coord2D normal)
+{
+    assert(burst->maxLife > 0.0f);
+
+    uint32_t count = burst->count;
+    if (emitter->count + count > emitter->capacity)
+    {
+        count = emitter->capacity - emitter->count;
+        emitter->dropped += burst->count - count;
+    }
+
+    float heading = atan2f(normal.y, normal.x);
+    for (uint32_t n = 0; n < count; ++n)
+    {
+        uint32_t i = emitter->count++;
+        float angle = heading + _particleRandom(emitter, -burst->spread, burst->spread);
+        float speed = _particleRandom(emitter, burst->minSpeed, burst->maxSpeed);
+        float life = _particleRandom(emitter, burst->minLife, burst->maxLife);
+        life = life > 0.0f ? life : burst->maxLife;
+
+        emitter->posX[i] = point.x;
+        emitter->posY[i] = point.y;
+        emitter->velX[i] = cosf(angle) * speed;
+        emitter->velY[i] = sinf(angle) * speed;
+        emitter->life[i] = life;
+        emitter->invLifetime[i] = 1.0f / life;
+        emitter->size[i] = _particleRandom(emitter, burst->minSize, burst->maxSize);
+        emitter->color[i] = burst->color;
+    }
+}
+
+/// @brief Kill every particle at once
+/// @param emitter 
+void particleEmitterClear(ParticleEmitter* emitter)
+{
+    emitter->count = 0;
+}
+
+/// @brief Semi-implicit Euler with drag over every particle, 8 (AVX) or 4 (SSE) at a time,
+/// then swap the ones that ran out of life off the end
+/// @param emitter 
+/// @param seconds 
+void particleEmitterUpdate(ParticleEmitter* emitter, float seconds)
+{
+    _particleEmitterAge(emitter, seconds);
+    _particleEmitterCompact(emitter);
+}
+
+/// @brief Reference implementation of particleEmitterUpdate
+/// @param emitter 
+/// @param seconds 
+void particleEmitterUpdateScalar(ParticleEmitter* emitter, float seconds)
+{
+    float keep = 1.0f - emitter->drag * seconds;
+    keep = keep > 0.0f ? keep : 0.0f;
+    float gx = emitter->gravity.x * seconds;
+    float gy = emitter->gravity.y * seconds;
+
+    for (uint32_t i = 0; i < emitter->count; ++i)
+    {
+        emitter->velX[i] = (emitter->velX[i] + gx) * keep;
+        emitter->velY[i] = (emitter->velY[i] + gy) * keep;
+        emitter->posX[i] += emitter->velX[i] * seconds;
+        emitter->posY[i] += emitter->velY[i] * seconds;
+        emitter->life[i] -= seconds;
+    }
+
+    uint32_t i = 0;
+    while (i < emitter->count)
+    {
+        if (emitter->life[i] <= 0.0f)
+        {
+            _particleEmitterMove(emitter, i, --emitter->count);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+/// @brief Record every live particle as a quad in one command, fading each out as it ages
+/// @param emitter 
+void particleEmitterDraw(const ParticleEmitter* emitter)
+{
+    if (emitter->count == 0)
+    {
+        return;
+    }
+
+    // written straight into the frame's vertex array
+    RenderVertex* vertices = renderQuads(RENDER_LAYER_EFFECTS, 0.0f, emitter->texture, 4 * emitter->count);
+    if (vertices == NULL)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < emitter->count; ++i)
+    {
+        float half = emitter->size[i] * 0.5f;
+        float fade = emitter->life[i] * emitter->invLifetime[i];
+        uint32_t alpha = (uint32_t)(fade * 255.0f) & 0xFF;
+        uint32_t rgb = emitter->color[i];
+        uint32_t rgba = ((rgb >> 16) & 0xFF) | (rgb & 0xFF00) | ((rgb & 0xFF) << 16) | (alpha << 24);
+
+        RenderVertex* quad = &vertices[4 * i];
+        float left = emitter->posX[i] - half;
+        float right = emitter->posX[i] + half;
+        float top = emitter->posY[i] - half;
+        float bottom = emitter->posY[i] + half;
+        _particleSetVertex(&quad[0], left, top, 0.0f, 1.0f, rgba);
+        _particleSetVertex(&quad[1], left, bottom, 0.0f, 0.0f, rgba);
+        _particleSetVertex(&quad[2], right, bottom, 1.0f, 0.0f, rgba);
+        _particleSetVertex(&quad[3], right, top, 1.0f, 1.0f, rgba);
+    }
+}
+
+/// @brief Object draw handler
+/// @param obj 
+/// @param alpha 
+static void _particleEmitterDraw(Object* obj, float alpha)
+{
+    particleEmitterDraw((ParticleEmitter*)obj);
+}
+
+/// @brief Object update handler
+/// @param obj 
+/// @param milliseconds 
+static void _particleEmitterObjUpdate(Object* obj, uint32_t milliseconds)
+{
+    particleEmitterUpdate((ParticleEmitter*)obj, milliseconds / 1000.0f);
+}
+
+/// @brief Integrate & age every live particle. The arrays are padded to whole registers, so
+/// the last one may run past count into slots nobody reads
+/// @param emitter 
+/// @param seconds 
+static void _particleEmitterAge(ParticleEmitter* emitter, float seconds)
+{
+    float keep = 1.0f - emitter->drag * seconds;
+    keep = keep > 0.0f ? keep : 0.0f;
+    float gx = emitter->gravity.x * seconds;
+    float gy = emitter->gravity.y * seconds;
+
+    uint32_t i = 0;
+    uint32_t count = emitter->count;
+
+    // mul + add rather than fma, so every path rounds identically to the scalar one
+#if defined(PARTICLE_USE_AVX)
+    __m256 step = _mm256_set1_ps(seconds);
+    __m256 drag = _mm256_set1_ps(keep);
+    __m256 pullX = _mm256_set1_ps(gx);
+    __m256 pullY = _mm256_set1_ps(gy);
+    for (; i < count; i += 8)
+    {
+        __m256 vx = _mm256_mul_ps(_mm256_add_ps(_mm256_load_ps(emitter->velX + i), pullX), drag);
+        __m256 vy = _mm256_mul_ps(_mm256_add_ps(_mm256_load_ps(emitter->velY + i), pullY), drag);
+        _mm256_store_ps(emitter->velX + i, vx);
+        _mm256_store_ps(emitter->velY + i, vy);
+        _mm256_store_ps(emitter->posX + i, _mm256_add_ps(_mm256_load_ps(emitter->posX + i), _mm256_mul_ps(vx, step)));
+        _mm256_store_ps(emitter->posY + i, _mm256_add_ps(_mm256_load_ps(emitter->posY + i), _mm256_mul_ps(vy, step)));
+        _mm256_store_ps(emitter->life + i, _mm256_sub_ps(_mm256_load_ps(emitter->life + i), step));
+    }
+#elif defined(PARTICLE_USE_SSE)
+    __m128 step = _mm_set1_ps(seconds);
+    __m128 drag = _mm_set1_ps(keep);
+    __m128 pullX = _mm_set1_ps(gx);
+    __m128 pullY = _mm_set1_ps(gy);
+    for (; i < count; i += 4)
+    {
+        __m128 vx = _mm_mul_ps(_mm_add_ps(_mm_load_ps(emitter->velX + i), pullX), drag);
+        __m128 vy = _mm_mul_ps(_mm_add_ps(_mm_load_ps(emitter->velY + i), pullY), drag);
+        _mm_store_ps(emitter->velX + i, vx);
+        _mm_store_ps(emitter->velY + i, vy);
+        _mm_store_ps(emitter->posX + i, _mm_add_ps(_mm_load_ps(emitter->posX + i), _mm_mul_ps(vx, step)));
+        _mm_store_ps(emitter->posY + i, _mm_add_ps(_mm_load_ps(emitter->posY + i), _mm_mul_ps(vy, step)));
+        _mm_store_ps(emitter->life + i, _mm_sub_ps(_mm_load_ps(emitter->life + i), step));
+    }
+#else
+    for (; i < count; ++i)
+    {
+        emitter->velX[i] = (emitter->velX[i] + gx) * keep;
+        emitter->velY[i] = (emitter->velY[i] + gy) * keep;
+        emitter->posX[i] += emitter->velX[i] * seconds;
+        emitter->posY[i] += emitter->velY[i] * seconds;
+        emitter->life[i] -= seconds;
+    }
+#endif
+}
+
+/// @brief Swap dead particles out with the last live one. Whole registers with nothing dead
+/// in them are skipped with one compare
+/// @param emitter 
+static void _particleEmitterCompact(ParticleEmitter* emitter)
+{
+    uint32_t i = 0;
+    while (i < emitter->count)
+    {
+#if defined(PARTICLE_USE_AVX)
+        if ((i & 7) == 0 && i + 8 <= emitter->count &&
+            _mm256_movemask_ps(_mm256_cmp_ps(_mm256_load_ps(emitter->life + i), _mm256_setzero_ps(), _CMP_LE_OQ)) == 0)
+        {
+            i += 8;
+            continue;
+        }
+#elif defined(PARTICLE_USE_SSE)
+        if ((i & 3) == 0 && i + 4 <= emitter->count &&
+            _mm_movemask_ps(_mm_cmple_ps(_mm_load_ps(emitter->life + i), _mm_setzero_ps())) == 0)
+        {
+            i += 4;
+            continue;
+        }
+#endif
+        if (emitter->life[i] <= 0.0f)
+        {
+            // the last particle is already aged, so it's checked again in its new place
+            _particleEmitterMove(emitter, i, --emitter->count);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+/// @brief Copy a particle from one index to another
+/// @param emitter 
+/// @param dstIndex 
+/// @param srcIndex 
+static void _particleEmitterMove(ParticleEmitter* emitter, uint32_t dstIndex, uint32_t srcIndex)
+{
+    emitter->posX[dstIndex] = emitter->posX[srcIndex];
+    emitter->posY[dstIndex] = emitter->posY[srcIndex];
+    emitter->velX[dstIndex] = emitter->velX[srcIndex];
+    emitter->velY[dstIndex] = emitter->velY[srcIndex];
+    emitter->life[dstIndex] = emitter->life[srcIndex];
+    emitter->invLifetime[dstIndex] = emitter->invLifetime[srcIndex];
+    emitter->size[dstIndex] = emitter->size[srcIndex];
+    emitter->color[dstIndex] = emitter->color[srcIndex];
+}
+
+/// @brief xorshift32 over the emitter's own seed
+/// @param emitter 
+/// @param min 
+/// @param max 
+/// @return a float in [min, max]
+static float _particleRandom(ParticleEmitter* emitter, float min, float max)
+{
+    uint32_t x = emitter->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    emitter->seed = x;
+    return min + (max - min) * ((x >> 8) * (1.0f / 16777216.0f));
+}
+
+/// @brief Fill in one corner of a quad
+/// @param vertex 
+/// @param x 
+/// @param y 
+/// @param u 
+/// @param v 
+/// @param rgba 
+static void _particleSetVertex(RenderVertex* vertex, float x, float y, float u, float v, uint32_t rgba)
+{
+    vertex->x = x;
+    vertex->y = y;
+    vertex->z = 0.0f;
+    vertex->u = u;
+    vertex->v = v;
+    vertex->rgba = rgba;
+}
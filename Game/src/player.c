@@ -14,6 +14,9 @@
 #include "input.h"
 
 #include "player.h"
+#include "pool.h"
+#include "spritebatch.h"
+#include "render.h"
 
 #define MAX_SPRITESHEETS 10
 #define MAX_DIRECTIONS 8
@@ -113,14 +116,27 @@ int currentDirection = DIR_SOUTH;
 // player related callbacks
 static PlayerCollideCB _playerCollideCB = NULL;
 
+// all players are allocated from here
+static Pool* _playerPool = NULL;
+static const uint32_t PLAYERS_PER_CHUNK = 4;
+
 // player update and draw pre-defs
 static void _playerUpdate(Object* obj, uint32_t milliseconds);
-static void _playerDraw(Object* obj);
-static void _playerFixedUpdate(Object* obj, uint32_t milliseconds);
+static void _playerDraw(Object* obj, float alpha);
+static void _playerFixedUpdate(Object* obj, float seconds);
+static void _playerGetBounds(const Object* obj, Bounds2D* box);
 static ObjVtable _playerVtable = {
 	_playerDraw,
 	_playerUpdate,
-	_playerFixedUpdate
+	_playerFixedUpdate,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	_playerGetBounds,
+	NULL,
+	0,
+	OBJ_LAYER_PLAYER
 };
 
 // player class private functions
@@ -134,6 +150,23 @@ static ObjVtable _playerVtable = {
 Player* createPlayerWithData(const char* jsonData);
 bool initPlayerTextures(Player* player);
 
+/// @brief One time creation of the player pool
+void playerInitPool()
+{
+	if (_playerPool == NULL)
+	{
+		_playerPool = POOL_NEW(Player, PLAYERS_PER_CHUNK);
+		assert(_playerPool != NULL);
+	}
+}
+
+/// @brief Release the player pool; all players must have been deleted
+void playerShutdownPool()
+{
+	poolDelete(_playerPool);
+	_playerPool = NULL;
+}
+
 void playerSetCollideCB(PlayerCollideCB cb)
 {
 	_playerCollideCB = cb;
@@ -173,6 +206,7 @@ void playerDelete(Player* player)
 {
 	objDeinit(&player->obj);
 	free(player->stats);
+	poolFree(_playerPool, player);
 }
 
 void updateAnimation(AnimationState* animationState, int maxFrames, uint32_t deltaTime)
@@ -210,7 +244,7 @@ void _playerUpdate(Object* obj, uint32_t milliseconds)
 	// however that is being done based on frame times for the animation
 }
 
-void _playerDraw(Object* obj)
+void _playerDraw(Object* obj, float alpha)
 {
 	Player* player = (Player*)obj; // cast to Player
 
@@ -218,24 +252,6 @@ void _playerDraw(Object* obj)
 	SpriteSheet* sheet = &player->spriteSheets[currentState];
 	SpriteDirection* dir = &sheet->directions[currentDirection];
 
-	// Get texture handle (however you manage textures)
-	// If you're using SOIL or stb_image, you'd load the texture once and store GLuint handle
-	GLuint textureHandle = sheet->textureHandle;
-
-	
-	glEnable(GL_TEXTURE_2D);
-	glBindTexture(GL_TEXTURE_2D, textureHandle);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-	glBegin(GL_TRIANGLE_STRIP);
-
-
-	// calculate the bounding box
-	GLfloat xPositionLeft = (obj->position.x - sheet->frameWidth / 2);
-	GLfloat xPositionRight = (obj->position.x + sheet->frameWidth / 2);
-	GLfloat yPositionTop = (obj->position.y - sheet->frameHeight / 2);
-	GLfloat yPositionBottom = (obj->position.y + sheet->frameHeight / 2);
-
 	// calculate UVs
 	GLfloat uPerFrame = (GLfloat)sheet->frameWidth / (GLfloat)sheet->textureWidth;
 	GLfloat vPerRow = (GLfloat)sheet->frameHeight / (GLfloat)sheet->textureHeight;
@@ -244,31 +260,23 @@ void _playerDraw(Object* obj)
 	GLfloat frameU = (GLfloat)(player->animState.currentFrame * uPerFrame);
 	GLfloat frameV = (GLfloat)(player->currDir * vPerRow);
 
-	// draw quad
-	glColor4ub(0xFF, 0xFF, 0xFF, 0xFF);
-
-	// TL
-	glTexCoord2f(frameU, frameV);
-	glVertex3f(xPositionLeft, yPositionTop, PLAYER_DRAW_DEPTH);
-
-	// BL
-	glTexCoord2f(frameU, frameV + vPerRow);
-	glVertex3f(xPositionLeft, yPositionBottom, PLAYER_DRAW_DEPTH);
-
-	// TR
-	glTexCoord2f(frameU + uPerFrame, frameV);
-	glVertex3f(xPositionRight, yPositionTop, PLAYER_DRAW_DEPTH);
-
-	// BR
-	glTexCoord2f(frameU + uPerFrame, frameV + vPerRow);
-	glVertex3f(xPositionRight, yPositionBottom, PLAYER_DRAW_DEPTH);
-
-	glEnd();
-
+	// queue the quad; the batcher draws it with everything else on this sheet
+	Sprite sprite;
+	sprite.center = objGetDrawPosition(obj, alpha);
+	sprite.size.x = (float)sheet->frameWidth;
+	sprite.size.y = (float)sheet->frameHeight;
+	sprite.uv.topLeft.x = frameU;
+	sprite.uv.topLeft.y = frameV;
+	sprite.uv.botRight.x = frameU + uPerFrame;
+	sprite.uv.botRight.y = frameV + vPerRow;
+	sprite.depth = PLAYER_DRAW_DEPTH;
+	sprite.color = 0xFFFFFFFF;
+	sprite.texture = sheet->textureHandle;
+	spriteBatchDraw(&sprite);
 }
 
 
-void _playerFixedUpdate(Object* obj, uint32_t milliseconds)
+void _playerFixedUpdate(Object* obj, float seconds)
 {
 	Player* player = (Player*)obj;
 #ifdef _DEBUG
@@ -279,6 +287,20 @@ void _playerFixedUpdate(Object* obj, uint32_t milliseconds)
 #endif // DEBUG
 }
 
+/// @brief The current animation frame's quad
+/// @param obj 
+/// @param box 
+static void _playerGetBounds(const Object* obj, Bounds2D* box)
+{
+	const Player* player = (const Player*)obj;
+	const SpriteSheet* sheet = &player->spriteSheets[currentState];
+	Coord2D pos = objGetPosition(obj);
+	box->topLeft.x = pos.x - sheet->frameWidth / 2;
+	box->topLeft.y = pos.y - sheet->frameHeight / 2;
+	box->botRight.x = pos.x + sheet->frameWidth / 2;
+	box->botRight.y = pos.y + sheet->frameHeight / 2;
+}
+
 Player* createPlayerWithData(const char* jsonData)
 {
 	cJSON* root = cJSON_Parse(jsonData);
@@ -294,7 +316,7 @@ Player* createPlayerWithData(const char* jsonData)
 		return NULL;
 	}
 
-	Player* player = (Player*)malloc(sizeof(Player));
+	Player* player = POOL_ALLOC(_playerPool, Player);
 	assert(player);
 	if (!player) return NULL;
 	memset(player, 0, sizeof(Player));
@@ -363,11 +385,9 @@ bool initPlayerTextures(Player* player)
 
 		if (sheet->textureHandle == 0)
 		{
-			sheet->textureHandle = SOIL_load_OGL_texture(
-				sheet->spriteSheetPath,
-				SOIL_LOAD_AUTO,
-				SOIL_CREATE_NEW_ID,
-				SOIL_FLAG_NTSC_SAFE_RGB | SOIL_FLAG_COMPRESS_TO_DXT);
+			// pixel art; filtering is set once at load rather than every draw
+			sheet->textureHandle = renderLoadTexture(sheet->spriteSheetPath,
+				SOIL_FLAG_NTSC_SAFE_RGB | SOIL_FLAG_COMPRESS_TO_DXT, RENDER_FILTER_NEAREST);
 
 			assert(sheet->textureHandle != 0);
 
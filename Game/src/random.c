@@ -1,28 +1,70 @@
 #include <stdlib.h>
 #include "random.h"
 
+// C rand() differs between runtimes, so the same seed gave different games on different
+// builds; this xorshift generator produces the same sequence everywhere
+#define RAND_DEFAULT_SEED 0x2545F491u
+
+static uint32_t _randState = RAND_DEFAULT_SEED;
+
+static uint32_t _randNext();
+
+/// @brief Restart the sequence, e.g. to replay a recorded game
+/// @param seed any value; 0 is replaced by the default seed, which xorshift can't leave
+void randSeed(uint32_t seed)
+{
+    _randState = seed != 0 ? seed : RAND_DEFAULT_SEED;
+}
+
 /// @brief Return a random floating point value in the specified range
 /// @param min 
 /// @param max 
 /// @return 
 float randGetFloat(float min, float max)
 {
-    int r = rand();
-    float rPct = (float)r/(float)RAND_MAX;
+    // 24 random bits fill a float's mantissa exactly
+    float rPct = (float)(_randNext() >> 8) * (1.0f / 16777216.0f);
 
     return (rPct * (max - min)) + min;
 }
 
+/// @brief Return a random simulation value in the specified range. In fixed point builds this
+/// is worked out in integers, so it can't vary with how the compiler rounds floats
+/// @param min 
+/// @param max 
+/// @return 
+Real randGetReal(float min, float max)
+{
+#ifdef GAME_FIXED_POINT
+    Fixed lo = fixedFromFloat(min);
+    Fixed hi = fixedFromFloat(max);
+    return lo + (Fixed)(((int64_t)(hi - lo) * (_randNext() >> 8)) >> 24);
+#else
+    return randGetFloat(min, max);
+#endif
+}
+
 /// @brief Return a random 32-bit value in the specified range
 /// @param min 
 /// @param max 
 /// @return 
 int32_t randGetInt(int32_t min, int32_t max)
 {
-    int r = rand();
+    uint32_t r = _randNext();
+
+    r %= (uint32_t)(max - min);
 
-    r %= (max - min);
-    r += min;
+    return (int32_t)r + min;
+}
 
-    return r;
-}
\ No newline at end of file
+/// @brief Advance the generator (xorshift32)
+/// @return 
+static uint32_t _randNext()
+{
+    uint32_t x = _randState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    _randState = x;
+    return x;
+}
@@ -0,0 +1,294 @@
+#include <Windows.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "baseTypes.h"
+#include "render.h"
+#include "circlerings.h"
+
+/// @brief A recorded command's place in the sort
+typedef struct render_sort_entry_t {
+    uint64_t    key;
+    uint32_t    index;      // into the command array; also keeps equal keys in record order
+} RenderSortEntry;
+
+static struct render_t {
+    RenderCommand*      commands;
+    RenderSortEntry*    entries;
+    uint32_t*           order;
+    uint32_t            count;
+    uint32_t            max;
+
+    RenderVertex*       vertices;
+    uint32_t            vertexCount;
+    uint32_t            maxVertices;
+
+    RenderBackend*      backend;
+    bool                recording;      // between BeginFrame & EndFrame
+    uint32_t            dropped;
+
+    RenderStats         stats;          // of the last finished frame
+} _render = { NULL, NULL, NULL, 0, 0, NULL, 0, 0, NULL, false, 0 };
+
+static RenderCommand* _renderPush(RenderLayer layer, float depth, uint32_t material);
+static int _renderCompareEntries(const void* a, const void* b);
+
+/// @brief Destroy a backend, using its vtable
+/// @param backend 
+void renderBackendDelete(RenderBackend* backend)
+{
+    if (backend != NULL && backend->vtable != NULL)
+    {
+        backend->vtable->destroy(backend);
+    }
+}
+
+/// @brief Allocate the command buffer
+/// @param maxCommands commands kept per frame; any more are dropped
+/// @param maxVertices quad vertices kept per frame
+void renderInit(uint32_t maxCommands, uint32_t maxVertices)
+{
+    _render.commands = malloc(maxCommands * sizeof(RenderCommand));
+    _render.entries = malloc(maxCommands * sizeof(RenderSortEntry));
+    _render.order = malloc(maxCommands * sizeof(uint32_t));
+    _render.vertices = malloc(maxVertices * sizeof(RenderVertex));
+    assert(_render.commands != NULL && _render.entries != NULL && _render.order != NULL && _render.vertices != NULL);
+
+    bool allocated = _render.commands != NULL && _render.entries != NULL && _render.order != NULL;
+    _render.max = allocated ? maxCommands : 0;
+    _render.maxVertices = _render.vertices != NULL ? maxVertices : 0;
+    _render.count = _render.vertexCount = _render.dropped = 0;
+    _render.recording = false;
+    ZeroMemory(&_render.stats, sizeof(RenderStats));
+
+    // backends share these to draw circles
+    circleRingsInit();
+}
+
+/// @brief Free the command buffer. The backend belongs to whoever set it
+void renderShutdown()
+{
+    free(_render.commands);
+    free(_render.entries);
+    free(_render.order);
+    free(_render.vertices);
+    _render.commands = NULL;
+    _render.entries = NULL;
+    _render.order = NULL;
+    _render.vertices = NULL;
+    _render.count = _render.max = 0;
+    _render.vertexCount = _render.maxVertices = 0;
+    _render.backend = NULL;
+    _render.recording = false;
+}
+
+/// @brief Choose what consumes each frame's commands
+/// @param backend NULL to discard them
+void renderSetBackend(RenderBackend* backend)
+{
+    _render.backend = backend;
+}
+
+/// @brief The backend frames are handed to
+/// @return 
+RenderBackend* renderGetBackend()
+{
+    return _render.backend;
+}
+
+/// @brief Start recording a frame
+void renderBeginFrame()
+{
+    // BeginFrame without an EndFrame!
+    assert(!_render.recording);
+    _render.recording = true;
+    _render.count = 0;
+    _render.vertexCount = 0;
+    _render.dropped = 0;
+}
+
+/// @brief Sort the frame's commands by key & hand them to the backend
+void renderEndFrame()
+{
+    // EndFrame without a BeginFrame!
+    assert(_render.recording);
+    _render.recording = false;
+
+    qsort(_render.entries, _render.count, sizeof(RenderSortEntry), _renderCompareEntries);
+    for (uint32_t i = 0; i < _render.count; ++i)
+    {
+        _render.order[i] = _render.entries[i].index;
+    }
+
+    if (_render.backend != NULL)
+    {
+        RenderFrame frame;
+        frame.commands = _render.commands;
+        frame.order = _render.order;
+        frame.count = _render.count;
+        frame.vertices = _render.vertices;
+        frame.vertexCount = _render.vertexCount;
+        _render.backend->vtable->execute(_render.backend, &frame);
+    }
+
+    _render.stats.commands = _render.count;
+    _render.stats.vertices = _render.vertexCount;
+    _render.stats.dropped = _render.dropped;
+}
+
+/// @brief What the last finished frame recorded
+/// @return 
+const RenderStats* renderGetStats()
+{
+    return &_render.stats;
+}
+
+/// @brief Load an image file as a texture the current backend can draw with. Sampling is
+/// set up here, once, rather than at each draw
+/// @param path 
+/// @param soilFlags SOIL_FLAG_s, as for SOIL_load_OGL_texture
+/// @param filter 
+/// @return the texture's name for Sprite & renderQuads, or 0 if it failed to load
+uint32_t renderLoadTexture(const char* path, uint32_t soilFlags, RenderFilter filter)
+{
+    // loading textures before there is a backend to own them!
+    assert(_render.backend != NULL);
+    if (_render.backend == NULL || _render.backend->vtable->loadTexture == NULL)
+    {
+        return 0;
+    }
+    return _render.backend->vtable->loadTexture(_render.backend, path, soilFlags, filter);
+}
+
+/// @brief Record a circle
+/// @param layer 
+/// @param depth 
+/// @param x center X
+/// @param y center Y
+/// @param radius 
+/// @param rgba see renderPackColor
+/// @param filled solid circle, if true, outline otherwise
+void renderCircle(RenderLayer layer, float depth, float x, float y, float radius, uint32_t rgba, bool filled)
+{
+    RenderCommand* command = _renderPush(layer, depth, RENDER_CMD_CIRCLE);
+    if (command != NULL)
+    {
+        command->type = RENDER_CMD_CIRCLE;
+        command->rgba = rgba;
+        command->params.circle.x = x;
+        command->params.circle.y = y;
+        command->params.circle.radius = radius;
+        command->params.circle.filled = filled;
+    }
+}
+
+/// @brief Record a line
+/// @param layer 
+/// @param depth 
+/// @param startX 
+/// @param startY 
+/// @param endX 
+/// @param endY 
+/// @param rgba see renderPackColor
+void renderLine(RenderLayer layer, float depth, float startX, float startY, float endX, float endY, uint32_t rgba)
+{
+    RenderCommand* command = _renderPush(layer, depth, RENDER_CMD_LINE);
+    if (command != NULL)
+    {
+        command->type = RENDER_CMD_LINE;
+        command->rgba = rgba;
+        command->params.line.startX = startX;
+        command->params.line.startY = startY;
+        command->params.line.endX = endX;
+        command->params.line.endY = endY;
+    }
+}
+
+/// @brief Record a run of quads sharing a texture. The caller fills in the vertices, which
+/// live in the frame's vertex array, so nothing is copied
+/// @param layer 
+/// @param depth sorts the run as a whole; each vertex keeps its own z
+/// @param texture GL texture name; 0 for flat colored quads
+/// @param vertexCount 4 per quad
+/// @return where to write the vertices, or NULL if the frame is out of room
+RenderVertex* renderQuads(RenderLayer layer, float depth, uint32_t texture, uint32_t vertexCount)
+{
+    assert(vertexCount % 4 == 0);
+    if (vertexCount > _render.maxVertices - _render.vertexCount)
+    {
+        ++_render.dropped;
+        return NULL;
+    }
+
+    // the material groups runs by texture, after the other command types
+    RenderCommand* command = _renderPush(layer, depth, RENDER_CMD_QUADS + texture);
+    if (command == NULL)
+    {
+        return NULL;
+    }
+
+    command->type = RENDER_CMD_QUADS;
+    command->rgba = 0;
+    command->params.quads.texture = texture;
+    command->params.quads.firstVertex = _render.vertexCount;
+    command->params.quads.vertexCount = vertexCount;
+
+    RenderVertex* vertices = &_render.vertices[_render.vertexCount];
+    _render.vertexCount += vertexCount;
+    return vertices;
+}
+
+/// @brief Build a sort key; commands run in ascending key order
+/// @param layer 
+/// @param depth -1 (furthest back) to 1, as glVertex3f z under the game's projection
+/// @param material groups commands that share state within a depth
+/// @return 
+uint64_t renderMakeKey(RenderLayer layer, float depth, uint32_t material)
+{
+    const uint32_t DEPTH_MAX = (1u << RENDER_KEY_DEPTH_BITS) - 1;
+
+    float unit = (depth + 1.0f) * 0.5f;
+    unit = unit > 0.0f ? (unit < 1.0f ? unit : 1.0f) : 0.0f;
+    uint64_t depthBits = (uint64_t)(unit * (float)DEPTH_MAX);
+
+    return ((uint64_t)layer << RENDER_KEY_LAYER_SHIFT) | (depthBits << RENDER_KEY_DEPTH_SHIFT) | material;
+}
+
+/// @brief Claim the next command slot & give it a key
+/// @param layer 
+/// @param depth 
+/// @param material 
+/// @return NULL if not recording or the frame is full
+static RenderCommand* _renderPush(RenderLayer layer, float depth, uint32_t material)
+{
+    // drawing outside BeginFrame/EndFrame!
+    assert(_render.recording);
+    if (!_render.recording)
+    {
+        return NULL;
+    }
+    if (_render.count >= _render.max)
+    {
+        ++_render.dropped;
+        return NULL;
+    }
+
+    uint32_t index = _render.count++;
+    _render.entries[index].key = renderMakeKey(layer, depth, material);
+    _render.entries[index].index = index;
+    return &_render.commands[index];
+}
+
+/// @brief qsort comparison on key, then record order
+/// @param a 
+/// @param b 
+/// @return 
+static int _renderCompareEntries(const void* a, const void* b)
+{
+    const RenderSortEntry* entryA = (const RenderSortEntry*)a;
+    const RenderSortEntry* entryB = (const RenderSortEntry*)b;
+    if (entryA->key != entryB->key)
+    {
+        return entryA->key < entryB->key ? -1 : 1;
+    }
+    return entryA->index < entryB->index ? -1 : (entryA->index > entryB->index ? 1 : 0);
+}
@@ -0,0 +1,261 @@
+#include <Windows.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include <gl/GL.h>
+#include <gl/GLU.h>
+#include "SOIL.h"
+#include "baseTypes.h"
+#include "rendergl.h"
+#include "circlerings.h"
+#include "glstate.h"
+#include "framework.h"
+
+/// @brief A circle corner, laid out for GL client arrays
+typedef struct render_gl_circle_vertex_t {
+    float       x, y;
+    uint32_t    rgba;       // bytes in r, g, b, a order
+} RenderGLCircleVertex;
+
+/// @brief Draws command buffers with fixed function OpenGL
+typedef struct render_gl_t {
+    RenderBackend   base;
+} RenderGL;
+
+static void _renderGLDelete(RenderBackend* backend);
+static void _renderGLExecute(RenderBackend* backend, const RenderFrame* frame);
+static uint32_t _renderGLLoadTexture(RenderBackend* backend, const char* path, uint32_t soilFlags, RenderFilter filter);
+static const RenderBackendVtable _renderGLVtable = {
+    _renderGLDelete,
+    _renderGLExecute,
+    _renderGLLoadTexture
+};
+
+static uint32_t _renderGLCircles(const RenderFrame* frame, uint32_t first);
+static void _renderGLCircleVertex(RenderGLCircleVertex* vertex, float x, float y, uint32_t rgba);
+static void _renderGLLine(const RenderCommand* command);
+static void _renderGLQuads(const RenderCommand* command, const RenderVertex* vertices);
+
+/// @brief Create the OpenGL backend; needs a current GL context when frames are executed
+/// @return 
+RenderBackend* renderGLNew()
+{
+    RenderGL* gl = malloc(sizeof(RenderGL));
+    if (gl != NULL)
+    {
+        gl->base.vtable = &_renderGLVtable;
+    }
+    return (RenderBackend*)gl;
+}
+
+/// @brief Free the backend
+/// @param backend 
+static void _renderGLDelete(RenderBackend* backend)
+{
+    free(backend);
+}
+
+/// @brief Issue the frame's commands in sorted order
+/// @param backend 
+/// @param frame 
+static void _renderGLExecute(RenderBackend* backend, const RenderFrame* frame)
+{
+    for (uint32_t i = 0; i < frame->count; ++i)
+    {
+        const RenderCommand* command = &frame->commands[frame->order[i]];
+        switch (command->type)
+        {
+        case RENDER_CMD_CIRCLE:
+            // circles share a material, so they sort next to each other; draw the run at once
+            i += _renderGLCircles(frame, i) - 1;
+            break;
+        case RENDER_CMD_LINE:
+            _renderGLLine(command);
+            break;
+        case RENDER_CMD_QUADS:
+            _renderGLQuads(command, frame->vertices);
+            break;
+        default:
+            // unknown command!
+            assert(false);
+            break;
+        }
+    }
+}
+
+/// @brief Upload an image through SOIL & set its filtering
+/// @param backend 
+/// @param path 
+/// @param soilFlags 
+/// @param filter 
+/// @return the GL texture name, or 0 on failure
+static uint32_t _renderGLLoadTexture(RenderBackend* backend, const char* path, uint32_t soilFlags, RenderFilter filter)
+{
+    GLuint texture = SOIL_load_OGL_texture(path, SOIL_LOAD_AUTO, SOIL_CREATE_NEW_ID, soilFlags);
+    if (texture != 0)
+    {
+        // SOIL leaves mipmapped textures trilinear; keep that unless asked for nearest
+        GLint minFilter = filter == RENDER_FILTER_NEAREST ? GL_NEAREST :
+            ((soilFlags & SOIL_FLAG_MIPMAPS) ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        GLint magFilter = filter == RENDER_FILTER_NEAREST ? GL_NEAREST : GL_LINEAR;
+        // SOIL bound the new texture behind the shadow state; binding it again keeps both agreed
+        glStateBindTexture(texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+    }
+    return texture;
+}
+
+/// @brief Draws a run of consecutive circle commands in one pass through client arrays:
+/// filled circles as triangle fans, outlines as three rings of line segments. Ring points
+/// come from circleRings, so no trig runs here
+/// @param frame 
+/// @param first index into the frame's order of the first circle
+/// @return how many commands were drawn
+static uint32_t _renderGLCircles(const RenderFrame* frame, uint32_t first)
+{
+    const float OUTLINE_SPREAD = 2.0f;
+
+    // size the run
+    uint32_t end = first;
+    uint32_t fillCount = 0;
+    uint32_t outlineCount = 0;
+    for (; end < frame->count; ++end)
+    {
+        const RenderCommand* command = &frame->commands[frame->order[end]];
+        if (command->type != RENDER_CMD_CIRCLE)
+        {
+            break;
+        }
+        if (command->params.circle.filled)
+        {
+            fillCount += 3 * circleRingsForRadius(command->params.circle.radius)->segments;
+        }
+        else
+        {
+            outlineCount += 6 * circleRingsForRadius(command->params.circle.radius + OUTLINE_SPREAD)->segments;
+        }
+    }
+
+    // only needed until the arrays are drawn, so it comes from the frame's scratch memory
+    RenderGLCircleVertex* vertices = FRAME_ALLOC(RenderGLCircleVertex, fillCount + outlineCount);
+    if (vertices == NULL)
+    {
+        return end - first;
+    }
+
+    RenderGLCircleVertex* fill = vertices;
+    RenderGLCircleVertex* outline = vertices + fillCount;
+    for (uint32_t i = first; i < end; ++i)
+    {
+        const RenderCommand* command = &frame->commands[frame->order[i]];
+        float x = command->params.circle.x;
+        float y = command->params.circle.y;
+        float radius = command->params.circle.radius;
+        uint32_t rgba = command->rgba;
+
+        if (command->params.circle.filled)
+        {
+            const CircleRing* ring = circleRingsForRadius(radius);
+            for (uint32_t s = 0; s < ring->segments; ++s)
+            {
+                // wound to face the viewer under the y down projection, so culling keeps them
+                _renderGLCircleVertex(fill++, x, y, rgba);
+                _renderGLCircleVertex(fill++, x + ring->x[s + 1] * radius, y + ring->y[s + 1] * radius, rgba);
+                _renderGLCircleVertex(fill++, x + ring->x[s] * radius, y + ring->y[s] * radius, rgba);
+            }
+        }
+        else
+        {
+            const CircleRing* ring = circleRingsForRadius(radius + OUTLINE_SPREAD);
+            for (int32_t step = -1; step <= 1; ++step)
+            {
+                float ringRadius = radius + step * OUTLINE_SPREAD;
+                for (uint32_t s = 0; s < ring->segments; ++s)
+                {
+                    _renderGLCircleVertex(outline++, x + ring->x[s] * ringRadius, y + ring->y[s] * ringRadius, rgba);
+                    _renderGLCircleVertex(outline++, x + ring->x[s + 1] * ringRadius, y + ring->y[s + 1] * ringRadius, rgba);
+                }
+            }
+        }
+    }
+
+    glStateDisable(GL_TEXTURE_2D);
+    glStateEnable(GL_BLEND);
+    glStateBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glStateEnableClientState(GL_VERTEX_ARRAY);
+    glStateEnableClientState(GL_COLOR_ARRAY);
+    glStateDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(RenderGLCircleVertex), &vertices->x);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(RenderGLCircleVertex), &vertices->rgba);
+    if (fillCount > 0)
+    {
+        glDrawArrays(GL_TRIANGLES, 0, fillCount);
+    }
+    if (outlineCount > 0)
+    {
+        glStateEnable(GL_LINE_SMOOTH);
+        glDrawArrays(GL_LINES, fillCount, outlineCount);
+    }
+
+    return end - first;
+}
+
+/// @brief Fill in a circle vertex
+/// @param vertex 
+/// @param x 
+/// @param y 
+/// @param rgba 
+static void _renderGLCircleVertex(RenderGLCircleVertex* vertex, float x, float y, uint32_t rgba)
+{
+    vertex->x = x;
+    vertex->y = y;
+    vertex->rgba = rgba;
+}
+
+/// @brief Draws a smoothed line
+/// @param command 
+static void _renderGLLine(const RenderCommand* command)
+{
+    const GLubyte* rgba = (const GLubyte*)&command->rgba;
+
+    glColor4ub(rgba[0], rgba[1], rgba[2], rgba[3]);
+    glStateEnable(GL_LINE_SMOOTH);
+    glStateDisable(GL_TEXTURE_2D);
+
+    glBegin(GL_LINE_STRIP);
+    glVertex2f(command->params.line.startX, command->params.line.startY);
+    glVertex2f(command->params.line.endX, command->params.line.endY);
+    glEnd();
+}
+
+/// @brief Draws a run of quads in one call through client arrays. Arrays are left enabled
+/// afterwards, so consecutive runs only change the pointers
+/// @param command 
+/// @param vertices the frame's vertex array
+static void _renderGLQuads(const RenderCommand* command, const RenderVertex* vertices)
+{
+    uint32_t texture = command->params.quads.texture;
+    const RenderVertex* first = &vertices[command->params.quads.firstVertex];
+
+    if (texture != 0)
+    {
+        glStateEnable(GL_TEXTURE_2D);
+        glStateBindTexture(texture);
+        glStateEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(RenderVertex), &first->u);
+    }
+    else
+    {
+        glStateDisable(GL_TEXTURE_2D);
+        glStateDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    }
+    glStateEnable(GL_BLEND);
+    glStateBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glStateEnableClientState(GL_VERTEX_ARRAY);
+    glStateEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(RenderVertex), &first->x);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(RenderVertex), &first->rgba);
+    glDrawArrays(GL_QUADS, 0, command->params.quads.vertexCount);
+}
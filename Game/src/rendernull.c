@@ -0,0 +1,145 @@
+#include <Windows.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include "baseTypes.h"
+#include "rendernull.h"
+
+/// @brief Checks & counts command buffers without drawing anything, so the CPU side of
+/// rendering can run & be profiled without a GPU or window
+typedef struct render_null_t {
+    RenderBackend   base;
+    RenderNullStats stats;
+    uint32_t        textureCount;   // names handed out so far
+} RenderNull;
+
+static void _renderNullDelete(RenderBackend* backend);
+static void _renderNullExecute(RenderBackend* backend, const RenderFrame* frame);
+static uint32_t _renderNullLoadTexture(RenderBackend* backend, const char* path, uint32_t soilFlags, RenderFilter filter);
+static const RenderBackendVtable _renderNullVtable = {
+    _renderNullDelete,
+    _renderNullExecute,
+    _renderNullLoadTexture
+};
+
+static bool _renderNullValidate(const RenderCommand* command, const RenderFrame* frame);
+
+/// @brief Create the null backend
+/// @return 
+RenderBackend* renderNullNew()
+{
+    RenderNull* renderer = malloc(sizeof(RenderNull));
+    if (renderer != NULL)
+    {
+        ZeroMemory(renderer, sizeof(RenderNull));
+        renderer->base.vtable = &_renderNullVtable;
+    }
+    return (RenderBackend*)renderer;
+}
+
+/// @brief Totals since creation or the last reset
+/// @param backend a null backend
+/// @return 
+const RenderNullStats* renderNullGetStats(const RenderBackend* backend)
+{
+    assert(backend->vtable == &_renderNullVtable);
+    return &((const RenderNull*)backend)->stats;
+}
+
+/// @brief Zero the totals
+/// @param backend a null backend
+void renderNullResetStats(RenderBackend* backend)
+{
+    assert(backend->vtable == &_renderNullVtable);
+    ZeroMemory(&((RenderNull*)backend)->stats, sizeof(RenderNullStats));
+}
+
+/// @brief Free the backend
+/// @param backend 
+static void _renderNullDelete(RenderBackend* backend)
+{
+    free(backend);
+}
+
+/// @brief Hand out a texture name without loading anything, so callers behave as they
+/// would with a real backend
+/// @param backend 
+/// @param path 
+/// @param soilFlags 
+/// @param filter 
+/// @return 
+static uint32_t _renderNullLoadTexture(RenderBackend* backend, const char* path, uint32_t soilFlags, RenderFilter filter)
+{
+    return ++((RenderNull*)backend)->textureCount;
+}
+
+/// @brief Validate & count every command of the frame, in sorted order
+/// @param backend 
+/// @param frame 
+static void _renderNullExecute(RenderBackend* backend, const RenderFrame* frame)
+{
+    RenderNullStats* stats = &((RenderNull*)backend)->stats;
+    ++stats->frames;
+
+    for (uint32_t i = 0; i < frame->count; ++i)
+    {
+        // the order must be a permutation of the recorded commands
+        uint32_t index = frame->order[i];
+        if (index >= frame->count)
+        {
+            ++stats->invalid;
+            continue;
+        }
+
+        const RenderCommand* command = &frame->commands[index];
+        if (!_renderNullValidate(command, frame))
+        {
+            ++stats->invalid;
+            continue;
+        }
+
+        ++stats->commands;
+        ++stats->commandsByType[command->type];
+        if (command->type == RENDER_CMD_QUADS)
+        {
+            stats->vertices += command->params.quads.vertexCount;
+        }
+    }
+}
+
+/// @brief Check a command is something the GL backend could draw
+/// @param command 
+/// @param frame 
+/// @return 
+static bool _renderNullValidate(const RenderCommand* command, const RenderFrame* frame)
+{
+    switch (command->type)
+    {
+    case RENDER_CMD_CIRCLE:
+        return isfinite(command->params.circle.x) && isfinite(command->params.circle.y) &&
+            isfinite(command->params.circle.radius) && command->params.circle.radius >= 0.0f;
+    case RENDER_CMD_LINE:
+        return isfinite(command->params.line.startX) && isfinite(command->params.line.startY) &&
+            isfinite(command->params.line.endX) && isfinite(command->params.line.endY);
+    case RENDER_CMD_QUADS:
+    {
+        uint32_t first = command->params.quads.firstVertex;
+        uint32_t count = command->params.quads.vertexCount;
+        if (count == 0 || count % 4 != 0 || first > frame->vertexCount || count > frame->vertexCount - first)
+        {
+            return false;
+        }
+        for (uint32_t v = first; v < first + count; ++v)
+        {
+            const RenderVertex* vertex = &frame->vertices[v];
+            if (!isfinite(vertex->x) || !isfinite(vertex->y) || !isfinite(vertex->z))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
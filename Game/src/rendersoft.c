@@ -0,0 +1,780 @@
+#include <Windows.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <assert.h>
+#include "SOIL.h"
+#include "baseTypes.h"
+#include "jobs.h"
+#include "rendersoft.h"
+#include "circlerings.h"
+
+// the frame is split into square tiles, each rasterized start to finish by one job
+#define RENDER_SOFT_TILE_SIZE 64
+
+/// @brief A texture's texels, stored bottom row first as GL would hold them
+typedef struct render_soft_texture_t {
+    uint32_t*       texels;     // bytes in r, g, b, a order
+    uint32_t        width;
+    uint32_t        height;
+    RenderFilter    filter;
+} RenderSoftTexture;
+
+/// @brief A half open rectangle, of pixels or tiles
+typedef struct render_soft_rect_t {
+    int32_t left, top, right, bottom;
+} RenderSoftRect;
+
+/// @brief One thing to rasterize: a command, or one quad of a quads command
+typedef struct render_soft_prim_t {
+    const RenderCommand*    command;
+    const RenderVertex*     quad;       // the quad's 4 vertices; NULL for circles & lines
+    RenderSoftRect          tiles;      // the tiles it may touch
+} RenderSoftPrim;
+
+/// @brief Draws command buffers into an RGBA framebuffer in memory, mirroring the GL
+/// backend's state: depth test LESS with depth writes, src-alpha blending & back face culling
+typedef struct render_soft_t {
+    RenderBackend       base;
+
+    uint32_t            width;
+    uint32_t            height;
+    uint32_t*           pixels;         // top row first; bytes in r, g, b, a order
+    float*              depth;          // 0 (near) to 1 (far)
+    uint32_t            clearColor;
+
+    RenderSoftTexture*  textures;       // texture name n is textures[n - 1]
+    uint32_t            textureCount;
+    uint32_t            maxTextures;
+
+    // per frame binning; prims are kept in sorted command order so every tile draws in it too
+    RenderSoftPrim*     prims;
+    uint32_t            primCount;
+    uint32_t            maxPrims;
+    uint32_t*           binPrims;       // prim indices, grouped by tile
+    uint32_t            maxBinPrims;
+    uint32_t*           binStarts;      // tileCount + 1 offsets into binPrims
+    uint32_t            tilesX;
+    uint32_t            tilesY;
+} RenderSoft;
+
+static void _renderSoftDelete(RenderBackend* backend);
+static void _renderSoftExecute(RenderBackend* backend, const RenderFrame* frame);
+static uint32_t _renderSoftLoadTexture(RenderBackend* backend, const char* path, uint32_t soilFlags, RenderFilter filter);
+static const RenderBackendVtable _renderSoftVtable = {
+    _renderSoftDelete,
+    _renderSoftExecute,
+    _renderSoftLoadTexture
+};
+
+static bool _renderSoftReserve(void** buffer, uint32_t* max, uint32_t needed, size_t elementSize);
+static void _renderSoftAddPrim(RenderSoft* soft, const RenderCommand* command, const RenderVertex* quad);
+static void _renderSoftTileRange(void* data, uint32_t begin, uint32_t end);
+static void _renderSoftCircle(RenderSoft* soft, const RenderCommand* command, const RenderSoftRect* clip);
+static void _renderSoftLine(RenderSoft* soft, float startX, float startY, float endX, float endY, uint32_t rgba, const RenderSoftRect* clip);
+static void _renderSoftQuad(RenderSoft* soft, const RenderCommand* command, const RenderVertex* quad, const RenderSoftRect* clip);
+static void _renderSoftPlot(RenderSoft* soft, int32_t x, int32_t y, float z, uint32_t rgba, const RenderSoftRect* clip);
+static uint32_t _renderSoftSample(const RenderSoftTexture* texture, float u, float v);
+
+/// @brief Blend src over dst with GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA on every channel
+/// @param src 
+/// @param dst 
+/// @return 
+static uint32_t _renderSoftBlend(uint32_t src, uint32_t dst)
+{
+    uint32_t alpha = src >> 24;
+    if (alpha == 0xFF)
+    {
+        return src;
+    }
+    // red & blue, then green & alpha, two channels per multiply; x / 255 rounds as
+    // (x + 128 + ((x + 128) >> 8)) >> 8
+    uint32_t inverse = 0xFF - alpha;
+    uint32_t rb = (src & 0x00FF00FF) * alpha + (dst & 0x00FF00FF) * inverse + 0x00800080;
+    uint32_t ga = ((src >> 8) & 0x00FF00FF) * alpha + ((dst >> 8) & 0x00FF00FF) * inverse + 0x00800080;
+    rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+    ga = ((ga + ((ga >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+    return rb | (ga << 8);
+}
+
+/// @brief Multiply two colors channel by channel, as GL_MODULATE does
+/// @param a 
+/// @param b 
+/// @return 
+static uint32_t _renderSoftModulate(uint32_t a, uint32_t b)
+{
+    uint32_t result = 0;
+    for (uint32_t shift = 0; shift < 32; shift += 8)
+    {
+        uint32_t product = ((a >> shift) & 0xFF) * ((b >> shift) & 0xFF);
+        result |= ((product + 127) / 0xFF) << shift;
+    }
+    return result;
+}
+
+/// @brief Create the software backend & its framebuffer
+/// @param width in pixels, matching the game's ortho projection
+/// @param height 
+/// @return 
+RenderBackend* renderSoftNew(uint32_t width, uint32_t height)
+{
+    RenderSoft* soft = malloc(sizeof(RenderSoft));
+    if (soft != NULL)
+    {
+        ZeroMemory(soft, sizeof(RenderSoft));
+        soft->base.vtable = &_renderSoftVtable;
+        soft->width = width;
+        soft->height = height;
+        soft->pixels = malloc(width * height * sizeof(uint32_t));
+        soft->depth = malloc(width * height * sizeof(float));
+        soft->tilesX = (width + RENDER_SOFT_TILE_SIZE - 1) / RENDER_SOFT_TILE_SIZE;
+        soft->tilesY = (height + RENDER_SOFT_TILE_SIZE - 1) / RENDER_SOFT_TILE_SIZE;
+        soft->binStarts = malloc((soft->tilesX * soft->tilesY + 1) * sizeof(uint32_t));
+        assert(soft->pixels != NULL && soft->depth != NULL && soft->binStarts != NULL);
+        if (soft->pixels == NULL || soft->depth == NULL || soft->binStarts == NULL)
+        {
+            _renderSoftDelete(&soft->base);
+            return NULL;
+        }
+        soft->clearColor = renderPackColor(0, 0, 0, 0);
+        ZeroMemory(soft->pixels, width * height * sizeof(uint32_t));
+    }
+    return (RenderBackend*)soft;
+}
+
+/// @brief Color the framebuffer is cleared to at the start of each frame
+/// @param backend a software backend
+/// @param rgba see renderPackColor
+void renderSoftSetClearColor(RenderBackend* backend, uint32_t rgba)
+{
+    assert(backend->vtable == &_renderSoftVtable);
+    ((RenderSoft*)backend)->clearColor = rgba;
+}
+
+/// @brief Add a texture from texels in memory
+/// @param backend a software backend
+/// @param rgba width * height texels, bytes in r, g, b, a order; the first row is at v = 0
+/// @param width 
+/// @param height 
+/// @param filter 
+/// @return the texture's name for Sprite & renderQuads, or 0 on failure
+uint32_t renderSoftAddTexture(RenderBackend* backend, const uint8_t* rgba, uint32_t width, uint32_t height, RenderFilter filter)
+{
+    assert(backend->vtable == &_renderSoftVtable);
+    RenderSoft* soft = (RenderSoft*)backend;
+    if (rgba == NULL || width == 0 || height == 0 ||
+        !_renderSoftReserve((void**)&soft->textures, &soft->maxTextures, soft->textureCount + 1, sizeof(RenderSoftTexture)))
+    {
+        return 0;
+    }
+
+    uint32_t* texels = malloc(width * height * sizeof(uint32_t));
+    if (texels == NULL)
+    {
+        return 0;
+    }
+    memcpy(texels, rgba, width * height * sizeof(uint32_t));
+
+    RenderSoftTexture* texture = &soft->textures[soft->textureCount++];
+    texture->texels = texels;
+    texture->width = width;
+    texture->height = height;
+    texture->filter = filter;
+    return soft->textureCount;
+}
+
+/// @brief The framebuffer as of the last executed frame
+/// @param backend a software backend
+/// @param width receives the width in pixels; may be NULL
+/// @param height receives the height in pixels; may be NULL
+/// @return width * height pixels, top row first, bytes in r, g, b, a order
+const uint32_t* renderSoftGetPixels(const RenderBackend* backend, uint32_t* width, uint32_t* height)
+{
+    assert(backend->vtable == &_renderSoftVtable);
+    const RenderSoft* soft = (const RenderSoft*)backend;
+    if (width != NULL)
+    {
+        *width = soft->width;
+    }
+    if (height != NULL)
+    {
+        *height = soft->height;
+    }
+    return soft->pixels;
+}
+
+/// @brief Save the framebuffer as a binary PPM, dropping alpha
+/// @param backend a software backend
+/// @param path 
+/// @return false if the file couldn't be written
+bool renderSoftWritePPM(const RenderBackend* backend, const char* path)
+{
+    assert(backend->vtable == &_renderSoftVtable);
+    const RenderSoft* soft = (const RenderSoft*)backend;
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    bool written = fprintf(file, "P6\n%u %u\n255\n", soft->width, soft->height) > 0;
+    uint8_t* row = malloc(soft->width * 3);
+    written = written && row != NULL;
+    for (uint32_t y = 0; written && y < soft->height; ++y)
+    {
+        const uint32_t* pixel = &soft->pixels[y * soft->width];
+        for (uint32_t x = 0; x < soft->width; ++x)
+        {
+            row[x * 3 + 0] = (uint8_t)(pixel[x]);
+            row[x * 3 + 1] = (uint8_t)(pixel[x] >> 8);
+            row[x * 3 + 2] = (uint8_t)(pixel[x] >> 16);
+        }
+        written = fwrite(row, 3, soft->width, file) == soft->width;
+    }
+    free(row);
+    return fclose(file) == 0 && written;
+}
+
+/// @brief Free the backend, its framebuffer & textures
+/// @param backend 
+static void _renderSoftDelete(RenderBackend* backend)
+{
+    RenderSoft* soft = (RenderSoft*)backend;
+    for (uint32_t i = 0; i < soft->textureCount; ++i)
+    {
+        free(soft->textures[i].texels);
+    }
+    free(soft->textures);
+    free(soft->prims);
+    free(soft->binPrims);
+    free(soft->binStarts);
+    free(soft->pixels);
+    free(soft->depth);
+    free(soft);
+}
+
+/// @brief Load an image through SOIL into memory, applying the flags that change texels
+/// @param backend 
+/// @param path 
+/// @param soilFlags SOIL_FLAG_INVERT_Y & SOIL_FLAG_NTSC_SAFE_RGB are honored; mipmaps &
+/// DXT compression only matter to the GPU
+/// @param filter 
+/// @return the texture's name, or 0 on failure
+static uint32_t _renderSoftLoadTexture(RenderBackend* backend, const char* path, uint32_t soilFlags, RenderFilter filter)
+{
+    int width, height, channels;
+    uint8_t* image = SOIL_load_image(path, &width, &height, &channels, SOIL_LOAD_RGBA);
+    if (image == NULL)
+    {
+        return 0;
+    }
+
+    // GL takes the first row as v = 0; SOIL flips the image first when asked to
+    if (soilFlags & SOIL_FLAG_INVERT_Y)
+    {
+        uint32_t* texels = (uint32_t*)image;
+        for (int top = 0, bottom = height - 1; top < bottom; ++top, --bottom)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                uint32_t swap = texels[top * width + x];
+                texels[top * width + x] = texels[bottom * width + x];
+                texels[bottom * width + x] = swap;
+            }
+        }
+    }
+    if (soilFlags & SOIL_FLAG_NTSC_SAFE_RGB)
+    {
+        // squeeze color into 16..235, as SOIL does
+        for (int i = 0; i < width * height; ++i)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                image[i * 4 + c] = (uint8_t)(16 + (image[i * 4 + c] * 219) / 255);
+            }
+        }
+    }
+
+    uint32_t texture = renderSoftAddTexture(backend, image, width, height, filter);
+    SOIL_free_image_data(image);
+    return texture;
+}
+
+/// @brief Bin the frame's primitives to tiles, then clear & rasterize the tiles in parallel
+/// @param backend 
+/// @param frame 
+static void _renderSoftExecute(RenderBackend* backend, const RenderFrame* frame)
+{
+    RenderSoft* soft = (RenderSoft*)backend;
+    uint32_t tileCount = soft->tilesX * soft->tilesY;
+
+    // split quad runs into single quads, so each can be binned to just the tiles it touches
+    uint32_t primCount = 0;
+    for (uint32_t i = 0; i < frame->count; ++i)
+    {
+        const RenderCommand* command = &frame->commands[frame->order[i]];
+        primCount += command->type == RENDER_CMD_QUADS ? command->params.quads.vertexCount / 4 : 1;
+    }
+    if (!_renderSoftReserve((void**)&soft->prims, &soft->maxPrims, primCount, sizeof(RenderSoftPrim)))
+    {
+        primCount = 0;
+    }
+
+    soft->primCount = 0;
+    for (uint32_t i = 0; i < frame->count && soft->primCount < primCount; ++i)
+    {
+        const RenderCommand* command = &frame->commands[frame->order[i]];
+        if (command->type == RENDER_CMD_QUADS)
+        {
+            const RenderVertex* vertices = &frame->vertices[command->params.quads.firstVertex];
+            for (uint32_t v = 0; v < command->params.quads.vertexCount; v += 4)
+            {
+                _renderSoftAddPrim(soft, command, &vertices[v]);
+            }
+        }
+        else
+        {
+            _renderSoftAddPrim(soft, command, NULL);
+        }
+    }
+
+    // count each tile's prims, turn the counts into offsets, then fill the bins in order
+    ZeroMemory(soft->binStarts, (tileCount + 1) * sizeof(uint32_t));
+    for (uint32_t i = 0; i < soft->primCount; ++i)
+    {
+        const RenderSoftRect* tiles = &soft->prims[i].tiles;
+        for (int32_t ty = tiles->top; ty < tiles->bottom; ++ty)
+        {
+            for (int32_t tx = tiles->left; tx < tiles->right; ++tx)
+            {
+                ++soft->binStarts[ty * soft->tilesX + tx + 1];
+            }
+        }
+    }
+    for (uint32_t t = 0; t < tileCount; ++t)
+    {
+        soft->binStarts[t + 1] += soft->binStarts[t];
+    }
+    if (!_renderSoftReserve((void**)&soft->binPrims, &soft->maxBinPrims, soft->binStarts[tileCount], sizeof(uint32_t)))
+    {
+        ZeroMemory(soft->binStarts, (tileCount + 1) * sizeof(uint32_t));
+    }
+    for (uint32_t i = 0; i < soft->primCount && soft->binStarts[tileCount] > 0; ++i)
+    {
+        const RenderSoftRect* tiles = &soft->prims[i].tiles;
+        for (int32_t ty = tiles->top; ty < tiles->bottom; ++ty)
+        {
+            for (int32_t tx = tiles->left; tx < tiles->right; ++tx)
+            {
+                // binStarts[t] runs ahead as tile t fills, ending where tile t + 1 starts
+                soft->binPrims[soft->binStarts[ty * soft->tilesX + tx]++] = i;
+            }
+        }
+    }
+    // after filling, binStarts[t] holds tile t's end; shift back to get the starts
+    memmove(&soft->binStarts[1], &soft->binStarts[0], tileCount * sizeof(uint32_t));
+    soft->binStarts[0] = 0;
+
+    jobsParallelFor(tileCount, 1, _renderSoftTileRange, soft);
+}
+
+/// @brief Grow a buffer to hold at least needed elements
+/// @param buffer 
+/// @param max current capacity, updated on growth
+/// @param needed 
+/// @param elementSize 
+/// @return false if it couldn't grow; the buffer is left as it was
+static bool _renderSoftReserve(void** buffer, uint32_t* max, uint32_t needed, size_t elementSize)
+{
+    if (needed <= *max)
+    {
+        return true;
+    }
+    uint32_t grown = *max > 0 ? *max : 64;
+    while (grown < needed)
+    {
+        grown *= 2;
+    }
+    void* resized = realloc(*buffer, grown * elementSize);
+    if (resized == NULL)
+    {
+        return false;
+    }
+    *buffer = resized;
+    *max = grown;
+    return true;
+}
+
+/// @brief Queue a prim along with the tiles it may touch; prims entirely off screen are dropped
+/// @param soft 
+/// @param command 
+/// @param quad the quad's 4 vertices, for quads commands
+static void _renderSoftAddPrim(RenderSoft* soft, const RenderCommand* command, const RenderVertex* quad)
+{
+    float minX, minY, maxX, maxY;
+    switch (command->type)
+    {
+    case RENDER_CMD_CIRCLE:
+    {
+        // outlines reach 2 pixels past the radius
+        float reach = command->params.circle.radius + 3.0f;
+        minX = command->params.circle.x - reach;
+        maxX = command->params.circle.x + reach;
+        minY = command->params.circle.y - reach;
+        maxY = command->params.circle.y + reach;
+        break;
+    }
+    case RENDER_CMD_LINE:
+        minX = fminf(command->params.line.startX, command->params.line.endX) - 1.0f;
+        maxX = fmaxf(command->params.line.startX, command->params.line.endX) + 1.0f;
+        minY = fminf(command->params.line.startY, command->params.line.endY) - 1.0f;
+        maxY = fmaxf(command->params.line.startY, command->params.line.endY) + 1.0f;
+        break;
+    case RENDER_CMD_QUADS:
+        minX = maxX = quad[0].x;
+        minY = maxY = quad[0].y;
+        for (uint32_t v = 1; v < 4; ++v)
+        {
+            minX = fminf(minX, quad[v].x);
+            maxX = fmaxf(maxX, quad[v].x);
+            minY = fminf(minY, quad[v].y);
+            maxY = fmaxf(maxY, quad[v].y);
+        }
+        break;
+    default:
+        // unknown command!
+        assert(false);
+        return;
+    }
+
+    // also rejects NaNs
+    if (!(maxX >= 0.0f && maxY >= 0.0f && minX < (float)soft->width && minY < (float)soft->height))
+    {
+        return;
+    }
+    minX = fmaxf(minX, 0.0f);
+    minY = fmaxf(minY, 0.0f);
+    maxX = fminf(maxX, (float)(soft->width - 1));
+    maxY = fminf(maxY, (float)(soft->height - 1));
+
+    RenderSoftPrim* prim = &soft->prims[soft->primCount++];
+    prim->command = command;
+    prim->quad = quad;
+    prim->tiles.left = (int32_t)minX / RENDER_SOFT_TILE_SIZE;
+    prim->tiles.top = (int32_t)minY / RENDER_SOFT_TILE_SIZE;
+    prim->tiles.right = (int32_t)maxX / RENDER_SOFT_TILE_SIZE + 1;
+    prim->tiles.bottom = (int32_t)maxY / RENDER_SOFT_TILE_SIZE + 1;
+}
+
+/// @brief Job body: clear & draw a range of tiles
+/// @param data the backend
+/// @param begin 
+/// @param end 
+static void _renderSoftTileRange(void* data, uint32_t begin, uint32_t end)
+{
+    RenderSoft* soft = data;
+    for (uint32_t tile = begin; tile < end; ++tile)
+    {
+        RenderSoftRect clip;
+        clip.left = (tile % soft->tilesX) * RENDER_SOFT_TILE_SIZE;
+        clip.top = (tile / soft->tilesX) * RENDER_SOFT_TILE_SIZE;
+        clip.right = clip.left + RENDER_SOFT_TILE_SIZE;
+        clip.bottom = clip.top + RENDER_SOFT_TILE_SIZE;
+        clip.right = clip.right < (int32_t)soft->width ? clip.right : (int32_t)soft->width;
+        clip.bottom = clip.bottom < (int32_t)soft->height ? clip.bottom : (int32_t)soft->height;
+
+        for (int32_t y = clip.top; y < clip.bottom; ++y)
+        {
+            for (int32_t x = clip.left; x < clip.right; ++x)
+            {
+                soft->pixels[y * soft->width + x] = soft->clearColor;
+                soft->depth[y * soft->width + x] = 1.0f;
+            }
+        }
+
+        for (uint32_t i = soft->binStarts[tile]; i < soft->binStarts[tile + 1]; ++i)
+        {
+            const RenderSoftPrim* prim = &soft->prims[soft->binPrims[i]];
+            switch (prim->command->type)
+            {
+            case RENDER_CMD_CIRCLE:
+                _renderSoftCircle(soft, prim->command, &clip);
+                break;
+            case RENDER_CMD_LINE:
+                _renderSoftLine(soft, prim->command->params.line.startX, prim->command->params.line.startY,
+                    prim->command->params.line.endX, prim->command->params.line.endY, prim->command->rgba, &clip);
+                break;
+            case RENDER_CMD_QUADS:
+                _renderSoftQuad(soft, prim->command, prim->quad, &clip);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+}
+
+/// @brief Draws a circle from the same rings as the GL backend: a disk if filled, else three
+/// rings of line segments
+/// @param soft 
+/// @param command 
+/// @param clip 
+static void _renderSoftCircle(RenderSoft* soft, const RenderCommand* command, const RenderSoftRect* clip)
+{
+    const float OUTLINE_SPREAD = 2.0f;
+
+    float radius = command->params.circle.radius;
+    float x = command->params.circle.x;
+    float y = command->params.circle.y;
+
+    if (!command->params.circle.filled)
+    {
+        const CircleRing* ring = circleRingsForRadius(radius + OUTLINE_SPREAD);
+        for (int32_t step = -1; step <= 1; ++step)
+        {
+            float ringRadius = radius + step * OUTLINE_SPREAD;
+            for (uint32_t s = 0; s < ring->segments; ++s)
+            {
+                _renderSoftLine(soft, x + ring->x[s] * ringRadius, y + ring->y[s] * ringRadius,
+                    x + ring->x[s + 1] * ringRadius, y + ring->y[s + 1] * ringRadius, command->rgba, clip);
+            }
+        }
+        return;
+    }
+
+    // pixel centers inside the radius; the GL fan's edges stay within a pixel of this
+    RenderSoftRect span;
+    span.left = (int32_t)floorf(fmaxf(x - radius, (float)clip->left));
+    span.right = (int32_t)ceilf(fminf(x + radius, (float)clip->right));
+    span.top = (int32_t)floorf(fmaxf(y - radius, (float)clip->top));
+    span.bottom = (int32_t)ceilf(fminf(y + radius, (float)clip->bottom));
+    float radiusSquared = radius * radius;
+    for (int32_t py = span.top; py < span.bottom; ++py)
+    {
+        float dy = (float)py + 0.5f - y;
+        for (int32_t px = span.left; px < span.right; ++px)
+        {
+            float dx = (float)px + 0.5f - x;
+            if (dx * dx + dy * dy < radiusSquared)
+            {
+                _renderSoftPlot(soft, px, py, 0.0f, command->rgba, clip);
+            }
+        }
+    }
+}
+
+/// @brief Draws a 1 pixel line, stepping along its longer axis
+/// @param soft 
+/// @param startX 
+/// @param startY 
+/// @param endX 
+/// @param endY 
+/// @param rgba 
+/// @param clip 
+static void _renderSoftLine(RenderSoft* soft, float startX, float startY, float endX, float endY, uint32_t rgba, const RenderSoftRect* clip)
+{
+    float x = startX;
+    float y = startY;
+    float dx = endX - x;
+    float dy = endY - y;
+    float length = fmaxf(fabsf(dx), fabsf(dy));
+    int32_t steps = (int32_t)ceilf(length);
+    if (steps > 0)
+    {
+        dx /= (float)steps;
+        dy /= (float)steps;
+    }
+
+    // GL leaves out the last pixel of a line
+    for (int32_t i = 0; i < steps; ++i)
+    {
+        _renderSoftPlot(soft, (int32_t)floorf(x), (int32_t)floorf(y), 0.0f, rgba, clip);
+        x += dx;
+        y += dy;
+    }
+}
+
+/// @brief Draws one quad of a quads command. Its corners run TL, BL, BR, TR so the quad is
+/// taken as a parallelogram: attributes are affine in the first, second & last corners
+/// @param soft 
+/// @param command 
+/// @param quad its 4 vertices
+/// @param clip 
+static void _renderSoftQuad(RenderSoft* soft, const RenderCommand* command, const RenderVertex* quad, const RenderSoftRect* clip)
+{
+    // twice the signed area, y down; GL culls quads that wind the other way
+    float area = 0.0f;
+    for (uint32_t v = 0; v < 4; ++v)
+    {
+        const RenderVertex* a = &quad[v];
+        const RenderVertex* b = &quad[(v + 1) & 3];
+        area += a->x * b->y - b->x * a->y;
+    }
+    if (area >= 0.0f)
+    {
+        return;
+    }
+
+    // edge functions, positive inside; pixels on an edge belong to top & left edges only
+    float edgeA[4], edgeB[4], edgeC[4];
+    bool topLeft[4];
+    for (uint32_t v = 0; v < 4; ++v)
+    {
+        const RenderVertex* a = &quad[v];
+        const RenderVertex* b = &quad[(v + 1) & 3];
+        edgeA[v] = b->y - a->y;
+        edgeB[v] = a->x - b->x;
+        edgeC[v] = -(edgeA[v] * a->x + edgeB[v] * a->y);
+        topLeft[v] = edgeA[v] > 0.0f || (edgeA[v] == 0.0f && edgeB[v] > 0.0f);
+    }
+
+    // p = v0 + s * (v3 - v0) + t * (v1 - v0)
+    float ax = quad[3].x - quad[0].x, ay = quad[3].y - quad[0].y;
+    float bx = quad[1].x - quad[0].x, by = quad[1].y - quad[0].y;
+    float det = ax * by - ay * bx;
+    if (fabsf(det) < 1e-12f)
+    {
+        return;
+    }
+    float invDet = 1.0f / det;
+
+    float minX = quad[0].x, maxX = quad[0].x, minY = quad[0].y, maxY = quad[0].y;
+    for (uint32_t v = 1; v < 4; ++v)
+    {
+        minX = fminf(minX, quad[v].x);
+        maxX = fmaxf(maxX, quad[v].x);
+        minY = fminf(minY, quad[v].y);
+        maxY = fmaxf(maxY, quad[v].y);
+    }
+    RenderSoftRect span;
+    span.left = (int32_t)floorf(fmaxf(minX, (float)clip->left));
+    span.right = (int32_t)ceilf(fminf(maxX + 1.0f, (float)clip->right));
+    span.top = (int32_t)floorf(fmaxf(minY, (float)clip->top));
+    span.bottom = (int32_t)ceilf(fminf(maxY + 1.0f, (float)clip->bottom));
+
+    uint32_t textureName = command->params.quads.texture;
+    const RenderSoftTexture* texture = textureName > 0 && textureName <= soft->textureCount ?
+        &soft->textures[textureName - 1] : NULL;
+    bool flat = quad[0].rgba == quad[1].rgba && quad[0].rgba == quad[3].rgba;
+
+    for (int32_t py = span.top; py < span.bottom; ++py)
+    {
+        float cy = (float)py + 0.5f;
+        float rowC[4];
+        for (uint32_t e = 0; e < 4; ++e)
+        {
+            rowC[e] = edgeB[e] * cy + edgeC[e];
+        }
+        for (int32_t px = span.left; px < span.right; ++px)
+        {
+            float cx = (float)px + 0.5f;
+            bool inside = true;
+            for (uint32_t e = 0; e < 4 && inside; ++e)
+            {
+                float value = edgeA[e] * cx + rowC[e];
+                inside = value > 0.0f || (value == 0.0f && topLeft[e]);
+            }
+            if (!inside)
+            {
+                continue;
+            }
+
+            float dx = cx - quad[0].x, dy = cy - quad[0].y;
+            float s = (dx * by - dy * bx) * invDet;
+            float t = (ax * dy - ay * dx) * invDet;
+
+            float z = quad[0].z + s * (quad[3].z - quad[0].z) + t * (quad[1].z - quad[0].z);
+            uint32_t rgba = quad[0].rgba;
+            if (!flat)
+            {
+                rgba = 0;
+                for (uint32_t shift = 0; shift < 32; shift += 8)
+                {
+                    float c0 = (float)((quad[0].rgba >> shift) & 0xFF);
+                    float c1 = (float)((quad[1].rgba >> shift) & 0xFF);
+                    float c3 = (float)((quad[3].rgba >> shift) & 0xFF);
+                    float c = c0 + s * (c3 - c0) + t * (c1 - c0);
+                    c = c > 0.0f ? (c < 255.0f ? c : 255.0f) : 0.0f;
+                    rgba |= (uint32_t)(c + 0.5f) << shift;
+                }
+            }
+            if (texture != NULL)
+            {
+                float u = quad[0].u + s * (quad[3].u - quad[0].u) + t * (quad[1].u - quad[0].u);
+                float v = quad[0].v + s * (quad[3].v - quad[0].v) + t * (quad[1].v - quad[0].v);
+                rgba = _renderSoftModulate(_renderSoftSample(texture, u, v), rgba);
+            }
+            _renderSoftPlot(soft, px, py, z, rgba, clip);
+        }
+    }
+}
+
+/// @brief Depth test, blend & write one pixel
+/// @param soft 
+/// @param x 
+/// @param y 
+/// @param z as glVertex3f z; -1 is furthest back
+/// @param rgba 
+/// @param clip 
+static void _renderSoftPlot(RenderSoft* soft, int32_t x, int32_t y, float z, uint32_t rgba, const RenderSoftRect* clip)
+{
+    if (x < clip->left || x >= clip->right || y < clip->top || y >= clip->bottom)
+    {
+        return;
+    }
+
+    // glOrtho(..., -1, 1) puts z = 1 at depth 0 and z = -1 at depth 1
+    uint32_t index = y * soft->width + x;
+    float depth = (1.0f - z) * 0.5f;
+    if (!(depth < soft->depth[index]))
+    {
+        return;
+    }
+    soft->depth[index] = depth;
+    soft->pixels[index] = _renderSoftBlend(rgba, soft->pixels[index]);
+}
+
+/// @brief Look up a texture with repeat wrapping
+/// @param texture 
+/// @param u 
+/// @param v 
+/// @return 
+static uint32_t _renderSoftSample(const RenderSoftTexture* texture, float u, float v)
+{
+    float x = u * (float)texture->width;
+    float y = v * (float)texture->height;
+    if (texture->filter == RENDER_FILTER_NEAREST)
+    {
+        int32_t tx = (int32_t)floorf(x) % (int32_t)texture->width;
+        int32_t ty = (int32_t)floorf(y) % (int32_t)texture->height;
+        tx += tx < 0 ? texture->width : 0;
+        ty += ty < 0 ? texture->height : 0;
+        return texture->texels[ty * texture->width + tx];
+    }
+
+    // bilinear between the four nearest texel centers
+    x -= 0.5f;
+    y -= 0.5f;
+    float fx = floorf(x), fy = floorf(y);
+    float wx = x - fx, wy = y - fy;
+    int32_t x0 = (int32_t)fx % (int32_t)texture->width;
+    int32_t y0 = (int32_t)fy % (int32_t)texture->height;
+    x0 += x0 < 0 ? texture->width : 0;
+    y0 += y0 < 0 ? texture->height : 0;
+    int32_t x1 = (x0 + 1) % texture->width;
+    int32_t y1 = (y0 + 1) % texture->height;
+
+    uint32_t t00 = texture->texels[y0 * texture->width + x0];
+    uint32_t t10 = texture->texels[y0 * texture->width + x1];
+    uint32_t t01 = texture->texels[y1 * texture->width + x0];
+    uint32_t t11 = texture->texels[y1 * texture->width + x1];
+    uint32_t result = 0;
+    for (uint32_t shift = 0; shift < 32; shift += 8)
+    {
+        float top = ((t00 >> shift) & 0xFF) * (1.0f - wx) + ((t10 >> shift) & 0xFF) * wx;
+        float bottom = ((t01 >> shift) & 0xFF) * (1.0f - wx) + ((t11 >> shift) & 0xFF) * wx;
+        result |= (uint32_t)(top * (1.0f - wy) + bottom * wy + 0.5f) << shift;
+    }
+    return result;
+}
@@ -0,0 +1,139 @@
+#include <Windows.h>
+#include <math.h>
+#include <assert.h>
+#include "baseTypes.h"
+#include "scene.h"
+#include "objmgr.h"
+
+/// @brief State shared with the broadphase callbacks while a query runs
+typedef struct scene_query_t {
+    const Broadphase*   broadphase;
+    uint32_t            mask;
+    Coord2D             origin;
+    Coord2D             direction;  // unit length, for rays
+
+    SceneHit*           hits;       // sorted nearest first
+    uint32_t            hitCount;
+    uint32_t            maxHits;
+} SceneQuery;
+
+static float _sceneRayHit(void* context, uint32_t proxy, float maxDistance);
+static bool _scenePointHit(void* context, uint32_t proxy);
+static void _sceneInsertHit(SceneQuery* query, Object* obj, float distance, Coord2D point);
+
+/// @brief Find the objects along a ray
+/// @param origin 
+/// @param direction need not be unit length
+/// @param maxDistance how far along the ray to look
+/// @param mask OBJ_LAYER_BITs of the objects to consider
+/// @param hits filled in nearest first
+/// @param maxHits 
+/// @return the number of hits written
+uint32_t sceneRaycast(Coord2D origin, Coord2D direction, float maxDistance, uint32_t mask, SceneHit* hits, uint32_t maxHits)
+{
+    const Broadphase* broadphase = objMgrGetBroadphase();
+    float length = sqrtf(direction.x * direction.x + direction.y * direction.y);
+    if (broadphase == NULL || length == 0.0f || maxHits == 0)
+    {
+        return 0;
+    }
+
+    SceneQuery query = { broadphase, mask, origin, { direction.x / length, direction.y / length }, hits, 0, maxHits };
+    broadphaseQueryRay(broadphase, origin, query.direction, maxDistance, _sceneRayHit, &query);
+    return query.hitCount;
+}
+
+/// @brief Find the objects under a point, e.g. to pick what the mouse is over
+/// @param point 
+/// @param mask OBJ_LAYER_BITs of the objects to consider
+/// @param hits filled in nearest center first
+/// @param maxHits 
+/// @return the number of hits written
+uint32_t scenePointQuery(Coord2D point, uint32_t mask, SceneHit* hits, uint32_t maxHits)
+{
+    const Broadphase* broadphase = objMgrGetBroadphase();
+    if (broadphase == NULL || maxHits == 0)
+    {
+        return 0;
+    }
+
+    SceneQuery query = { broadphase, mask, point, { 0.0f, 0.0f }, hits, 0, maxHits };
+    broadphaseQueryPoint(broadphase, point, _scenePointHit, &query);
+    return query.hitCount;
+}
+
+/// @brief Test a candidate against its object's exact shape; the broadphase's boxes are padded
+/// @param context 
+/// @param proxy 
+/// @param maxDistance 
+/// @return the distance to clip the rest of the ray to
+static float _sceneRayHit(void* context, uint32_t proxy, float maxDistance)
+{
+    SceneQuery* query = (SceneQuery*)context;
+    Object* obj = broadphaseGetUserData(query->broadphase, proxy);
+
+    float distance;
+    if (!objInLayers(obj, query->mask) || !objRaycast(obj, query->origin, query->direction, maxDistance, &distance))
+    {
+        return maxDistance;
+    }
+
+    Coord2D point = { query->origin.x + query->direction.x * distance, query->origin.y + query->direction.y * distance };
+    _sceneInsertHit(query, obj, distance, point);
+
+    // once the array is full, anything beyond its farthest hit can't get in
+    return query->hitCount == query->maxHits ? query->hits[query->hitCount - 1].distance : maxDistance;
+}
+
+/// @brief Test a candidate against its object's exact shape; the broadphase's boxes are padded
+/// @param context 
+/// @param proxy 
+/// @return true to keep looking
+static bool _scenePointHit(void* context, uint32_t proxy)
+{
+    SceneQuery* query = (SceneQuery*)context;
+    Object* obj = broadphaseGetUserData(query->broadphase, proxy);
+
+    Bounds2D box;
+    Coord2D point = query->origin;
+    if (!objInLayers(obj, query->mask) || !objContainsPoint(obj, point) || !objGetBounds(obj, &box))
+    {
+        return true;
+    }
+
+    Coord2D center = boundsGetCenter(&box);
+    float dx = center.x - point.x;
+    float dy = center.y - point.y;
+    _sceneInsertHit(query, obj, sqrtf(dx * dx + dy * dy), point);
+    return true;
+}
+
+/// @brief Insertion sort a hit into place, dropping the farthest if the array is full
+/// @param query 
+/// @param obj 
+/// @param distance 
+/// @param point 
+static void _sceneInsertHit(SceneQuery* query, Object* obj, float distance, Coord2D point)
+{
+    uint32_t i = query->hitCount;
+    if (i == query->maxHits)
+    {
+        if (distance >= query->hits[i - 1].distance)
+        {
+            return;
+        }
+        --i;
+    }
+    else
+    {
+        ++query->hitCount;
+    }
+
+    for (; i > 0 && query->hits[i - 1].distance > distance; --i)
+    {
+        query->hits[i] = query->hits[i - 1];
+    }
+    query->hits[i].obj = obj;
+    query->hits[i].distance = distance;
+    query->hits[i].point = point;
+}
@@ -1,13 +1,8 @@
 #include <windows.h>											// Header File For Windows
-#include <math.h>
 #include <stdio.h>
-#include <gl\gl.h>												// Header File For The OpenGL32 Library
-#include <gl\glu.h>												// Header File For The GLu32 Library
-#include "glut.h"
 
 #include "baseTypes.h"
-
-const float DEG2RAD = 3.14159f/180.0f;
+#include "render.h"
 
 /// @brief Draws a circle to the screen w/ the given properties
 /// @param radius 
@@ -19,35 +14,7 @@ const float DEG2RAD = 3.14159f/180.0f;
 /// @param filled solid circle, if true, outline otherwise
 void shapeDrawCircle(float radius, float x, float y, uint8_t r, uint8_t g, uint8_t b, bool filled)
 {	
-	glEnable(GL_POINT_SMOOTH);
-	glDisable(GL_TEXTURE_2D);
-	if(!filled)
-	{
-		glColor4ub(r, g, b, 0xFF);
-		// Set the point size
-		glPointSize(1.0);
-		glBegin(GL_POINTS);
-		float radiusMax = radius + 2.0f;
-		float radiusMin = radius - 2.0f;
-		for (int i=0; i < 360; i+=3)
-		{
-			float degInRad = i*DEG2RAD;
-			glVertex2f(x + (cos(degInRad)*radius),y + (sin(degInRad)*radius));
-			glVertex2f(x + (cos(degInRad)*radiusMax),y + (sin(degInRad)*radiusMax));
-			glVertex2f(x + (cos(degInRad)*radiusMin),y + (sin(degInRad)*radiusMin));
-		}
-		glEnd();
-	}
-	else
-	{
-	    glColor4ub(r, g, b, 0xFF);
-		glEnable(GL_BLEND); 
-	    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); 
-		glPointSize(radius * 2);
-		glBegin(GL_POINTS);
-		glVertex2f(x, y);
-		glEnd();
-	}
+	renderCircle(RENDER_LAYER_WORLD, 0.0f, x, y, radius, renderPackColor(r, g, b, 0xFF), filled);
 }
 
 /// @brief Draws a line to the screen with the given properties
@@ -60,14 +27,5 @@ void shapeDrawCircle(float radius, float x, float y, uint8_t r, uint8_t g, uint8
 /// @param b blue
 void shapeDrawLine(float startX, float startY, float endX, float endY, uint8_t r, uint8_t g, uint8_t b)
 {
-	glColor3ub(r, g, b);
-	// Draw filtered lines
-	glEnable(GL_LINE_SMOOTH);
-	glDisable(GL_TEXTURE_2D);
-
-	glBegin(GL_LINE_STRIP);
-		glVertex2f(startX, startY);
-		glVertex2f(endX, endY);
-	glEnd();
-
+	renderLine(RENDER_LAYER_WORLD, 0.0f, startX, startY, endX, endY, renderPackColor(r, g, b, 0xFF));
 }
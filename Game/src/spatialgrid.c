@@ -0,0 +1,224 @@
+#include <Windows.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include "baseTypes.h"
+#include "spatialgrid.h"
+
+// fewest hash buckets the grid will use
+#define SPATIAL_GRID_MIN_BUCKETS 64
+
+/// @brief One cell covered by a proxy; proxies spanning several cells get one of these each
+typedef struct grid_cell_ref_t {
+    uint32_t    proxy;
+    int32_t     cellX;
+    int32_t     cellY;
+    uint32_t    bucket;
+} GridCellRef;
+
+/// @brief Uniform grid of square cells over unbounded space, stored as a hash of the occupied
+/// cells. It is rebuilt from the proxies on every query: the cell references are counting-sorted
+/// by bucket, so each bucket's occupants end up contiguous in memory
+typedef struct spatial_grid_t {
+    Broadphase      base;
+
+    float           cellSize;
+    float           invCellSize;
+
+    GridCellRef*    refs;       // in insertion order
+    uint32_t        refCapacity;
+    GridCellRef*    sorted;     // grouped by bucket
+    uint32_t        sortedCapacity;
+
+    uint32_t*       bucketStart;    // first sorted ref of each bucket, plus an end marker
+    uint32_t        bucketCapacity;
+} SpatialGrid;
+
+// the broadphase vtable for grids; proxies are only read when finding pairs
+static void _spatialGridDelete(Broadphase* broadphase);
+static void _spatialGridFindPairs(Broadphase* broadphase);
+static const BroadphaseVtable _spatialGridVtable = {
+    _spatialGridDelete,
+    NULL,
+    NULL,
+    NULL,
+    _spatialGridFindPairs
+};
+
+static void _spatialGridGetCells(const SpatialGrid* grid, const Bounds2D* box, int32_t* x0, int32_t* y0, int32_t* x1, int32_t* y1);
+static uint32_t _spatialGridHash(int32_t cellX, int32_t cellY, uint32_t mask);
+
+/// @brief Create an empty grid broadphase
+/// @param cellSize width & height of a cell; around the diameter of a typical proxy works well
+/// @return 
+Broadphase* spatialGridNew(float cellSize)
+{
+    assert(cellSize > 0.0f);
+
+    SpatialGrid* grid = malloc(sizeof(SpatialGrid));
+    if (grid != NULL)
+    {
+        ZeroMemory(grid, sizeof(SpatialGrid));
+        broadphaseInit(&grid->base, &_spatialGridVtable);
+        grid->cellSize = cellSize;
+        grid->invCellSize = 1.0f / cellSize;
+    }
+    return (Broadphase*)grid;
+}
+
+/// @brief Free the grid & all of its buffers
+/// @param broadphase 
+static void _spatialGridDelete(Broadphase* broadphase)
+{
+    SpatialGrid* grid = (SpatialGrid*)broadphase;
+
+    broadphaseDeinit(&grid->base);
+    free(grid->refs);
+    free(grid->sorted);
+    free(grid->bucketStart);
+    free(grid);
+}
+
+/// @brief Rebuild the grid from the proxies & report every overlapping pair once
+/// @param broadphase 
+static void _spatialGridFindPairs(Broadphase* broadphase)
+{
+    SpatialGrid* grid = (SpatialGrid*)broadphase;
+    const BroadphaseProxy* proxies = grid->base.proxies;
+
+    // how many cells does everything touch?
+    uint32_t refCount = 0;
+    for (uint32_t i = 0; i < grid->base.proxyCount; ++i)
+    {
+        if (!proxies[i].active)
+        {
+            continue;
+        }
+        int32_t x0, y0, x1, y1;
+        _spatialGridGetCells(grid, &proxies[i].box, &x0, &y0, &x1, &y1);
+        refCount += (uint32_t)((x1 - x0 + 1) * (y1 - y0 + 1));
+    }
+
+    // keep the table at most half full, so few distinct cells share a bucket
+    uint32_t bucketCount = SPATIAL_GRID_MIN_BUCKETS;
+    while (bucketCount < 2 * refCount)
+    {
+        bucketCount <<= 1;
+    }
+
+    if (!broadphaseReserve((void**)&grid->refs, &grid->refCapacity, refCount, sizeof(GridCellRef)) ||
+        !broadphaseReserve((void**)&grid->sorted, &grid->sortedCapacity, refCount, sizeof(GridCellRef)) ||
+        !broadphaseReserve((void**)&grid->bucketStart, &grid->bucketCapacity, bucketCount + 1, sizeof(uint32_t)))
+    {
+        return;
+    }
+
+    // reference each covered cell & count the references per bucket
+    ZeroMemory(grid->bucketStart, (bucketCount + 1) * sizeof(uint32_t));
+    uint32_t mask = bucketCount - 1;
+    uint32_t r = 0;
+    for (uint32_t i = 0; i < grid->base.proxyCount; ++i)
+    {
+        if (!proxies[i].active)
+        {
+            continue;
+        }
+        int32_t x0, y0, x1, y1;
+        _spatialGridGetCells(grid, &proxies[i].box, &x0, &y0, &x1, &y1);
+        for (int32_t y = y0; y <= y1; ++y)
+        {
+            for (int32_t x = x0; x <= x1; ++x)
+            {
+                GridCellRef* ref = &grid->refs[r++];
+                ref->proxy = i;
+                ref->cellX = x;
+                ref->cellY = y;
+                ref->bucket = _spatialGridHash(x, y, mask);
+                ++grid->bucketStart[ref->bucket + 1];
+            }
+        }
+    }
+
+    // counting sort: prefix sum the counts into start offsets, then scatter
+    for (uint32_t b = 0; b < bucketCount; ++b)
+    {
+        grid->bucketStart[b + 1] += grid->bucketStart[b];
+    }
+    for (uint32_t i = 0; i < refCount; ++i)
+    {
+        grid->sorted[grid->bucketStart[grid->refs[i].bucket]++] = grid->refs[i];
+    }
+    // scattering advanced each start to the next bucket's; shift them back
+    for (uint32_t b = bucketCount; b > 0; --b)
+    {
+        grid->bucketStart[b] = grid->bucketStart[b - 1];
+    }
+    grid->bucketStart[0] = 0;
+
+    // test everything sharing a cell
+    for (uint32_t b = 0; b < bucketCount; ++b)
+    {
+        uint32_t end = grid->bucketStart[b + 1];
+        for (uint32_t i = grid->bucketStart[b]; i < end; ++i)
+        {
+            const GridCellRef* refA = &grid->sorted[i];
+            const Bounds2D* boxA = &proxies[refA->proxy].box;
+
+            for (uint32_t j = i + 1; j < end; ++j)
+            {
+                const GridCellRef* refB = &grid->sorted[j];
+                if (refA->cellX != refB->cellX || refA->cellY != refB->cellY)
+                {
+                    // a different cell that happens to hash to the same bucket
+                    continue;
+                }
+
+                const Bounds2D* boxB = &proxies[refB->proxy].box;
+                if (!boundsOverlap(boxA, boxB))
+                {
+                    continue;
+                }
+
+                // boxes sharing several cells meet in all of them; only report the pair from
+                // the cell holding the top left corner of their overlap
+                float cornerX = boxA->topLeft.x > boxB->topLeft.x ? boxA->topLeft.x : boxB->topLeft.x;
+                float cornerY = boxA->topLeft.y > boxB->topLeft.y ? boxA->topLeft.y : boxB->topLeft.y;
+                if ((int32_t)floorf(cornerX * grid->invCellSize) != refA->cellX ||
+                    (int32_t)floorf(cornerY * grid->invCellSize) != refA->cellY)
+                {
+                    continue;
+                }
+
+                if (!broadphaseAddPair(&grid->base, refA->proxy, refB->proxy))
+                {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+/// @brief Range of cells a box covers, inclusive
+/// @param grid 
+/// @param box 
+/// @param x0 
+/// @param y0 
+/// @param x1 
+/// @param y1 
+static void _spatialGridGetCells(const SpatialGrid* grid, const Bounds2D* box, int32_t* x0, int32_t* y0, int32_t* x1, int32_t* y1)
+{
+    *x0 = (int32_t)floorf(box->topLeft.x * grid->invCellSize);
+    *y0 = (int32_t)floorf(box->topLeft.y * grid->invCellSize);
+    *x1 = (int32_t)floorf(box->botRight.x * grid->invCellSize);
+    *y1 = (int32_t)floorf(box->botRight.y * grid->invCellSize);
+}
+
+/// @brief Bucket for a cell
+/// @param cellX 
+/// @param cellY 
+/// @param mask bucket count - 1
+/// @return 
+static uint32_t _spatialGridHash(int32_t cellX, int32_t cellY, uint32_t mask)
+{
+    return (((uint32_t)cellX * 73856093u) ^ ((uint32_t)cellY * 19349663u)) & mask;
+}
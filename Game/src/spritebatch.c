@@ -0,0 +1,217 @@
+#include <Windows.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "baseTypes.h"
+#include "spritebatch.h"
+
+/// @brief Where a queued sprite goes in the sorted order
+typedef struct sprite_sort_key_t {
+    uint64_t    key;        // texture in the high half, depth in the low half
+    uint32_t    index;      // into the queue; also keeps equal keys in submission order
+} SpriteSortKey;
+
+static struct sprite_batch_t {
+    Sprite*         queue;
+    SpriteSortKey*  keys;
+    RenderVertex*   vertices;
+    uint32_t        count;
+    uint32_t        max;
+    bool            drawing;    // between Begin & End
+
+    SpriteBatchSubmitFunc submit;
+    void*           submitContext;
+
+    SpriteBatchStats stats;
+} _spriteBatch = { NULL, NULL, NULL, 0, 0, false, spriteBatchSubmitRender, NULL };
+
+static uint32_t _spriteBatchDepthBits(float depth);
+static int _spriteBatchCompareKeys(const void* a, const void* b);
+static void _spriteBatchEmitQuad(const Sprite* sprite, RenderVertex* quad);
+
+/// @brief Allocate the sprite queue & vertex stream
+/// @param maxSprites sprites queued before the batcher has to flush early
+void spriteBatchInit(uint32_t maxSprites)
+{
+    _spriteBatch.queue = malloc(maxSprites * sizeof(Sprite));
+    _spriteBatch.keys = malloc(maxSprites * sizeof(SpriteSortKey));
+    _spriteBatch.vertices = malloc(4 * maxSprites * sizeof(RenderVertex));
+    assert(_spriteBatch.queue != NULL && _spriteBatch.keys != NULL && _spriteBatch.vertices != NULL);
+
+    bool allocated = _spriteBatch.queue != NULL && _spriteBatch.keys != NULL && _spriteBatch.vertices != NULL;
+    _spriteBatch.max = allocated ? maxSprites : 0;
+    _spriteBatch.count = 0;
+    _spriteBatch.drawing = false;
+    ZeroMemory(&_spriteBatch.stats, sizeof(SpriteBatchStats));
+}
+
+/// @brief Free the queue; anything still queued is discarded
+void spriteBatchShutdown()
+{
+    free(_spriteBatch.queue);
+    free(_spriteBatch.keys);
+    free(_spriteBatch.vertices);
+    _spriteBatch.queue = NULL;
+    _spriteBatch.keys = NULL;
+    _spriteBatch.vertices = NULL;
+    _spriteBatch.count = _spriteBatch.max = 0;
+    _spriteBatch.drawing = false;
+}
+
+/// @brief Route batches somewhere other than the command buffer, e.g. to inspect the batching
+/// @param func NULL to go back to spriteBatchSubmitRender
+/// @param context handed back to func
+void spriteBatchSetSubmit(SpriteBatchSubmitFunc func, void* context)
+{
+    _spriteBatch.submit = func != NULL ? func : spriteBatchSubmitRender;
+    _spriteBatch.submitContext = func != NULL ? context : NULL;
+}
+
+/// @brief Start collecting a frame's sprites, resetting the stats
+void spriteBatchBegin()
+{
+    // Begin without an End!
+    assert(!_spriteBatch.drawing);
+    _spriteBatch.drawing = true;
+    _spriteBatch.count = 0;
+    ZeroMemory(&_spriteBatch.stats, sizeof(SpriteBatchStats));
+}
+
+/// @brief Queue a sprite. Nothing is drawn until the queue fills or spriteBatchEnd
+/// @param sprite 
+void spriteBatchDraw(const Sprite* sprite)
+{
+    // drawing a sprite outside Begin/End!
+    assert(_spriteBatch.drawing);
+    if (!_spriteBatch.drawing || _spriteBatch.max == 0)
+    {
+        return;
+    }
+
+    if (_spriteBatch.count == _spriteBatch.max)
+    {
+        spriteBatchFlush();
+    }
+
+    uint32_t index = _spriteBatch.count++;
+    _spriteBatch.queue[index] = *sprite;
+    _spriteBatch.keys[index].key = ((uint64_t)sprite->texture << 32) | _spriteBatchDepthBits(sprite->depth);
+    _spriteBatch.keys[index].index = index;
+    ++_spriteBatch.stats.sprites;
+}
+
+/// @brief Sort what's queued by texture then depth, & submit one batch per texture
+void spriteBatchFlush()
+{
+    uint32_t count = _spriteBatch.count;
+    if (count == 0)
+    {
+        return;
+    }
+
+    qsort(_spriteBatch.keys, count, sizeof(SpriteSortKey), _spriteBatchCompareKeys);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        _spriteBatchEmitQuad(&_spriteBatch.queue[_spriteBatch.keys[i].index], &_spriteBatch.vertices[4 * i]);
+    }
+
+    uint32_t runStart = 0;
+    for (uint32_t i = 1; i <= count; ++i)
+    {
+        uint32_t texture = _spriteBatch.queue[_spriteBatch.keys[runStart].index].texture;
+        if (i == count || _spriteBatch.queue[_spriteBatch.keys[i].index].texture != texture)
+        {
+            _spriteBatch.submit(_spriteBatch.submitContext, texture,
+                &_spriteBatch.vertices[4 * runStart], 4 * (i - runStart));
+            ++_spriteBatch.stats.batches;
+            runStart = i;
+        }
+    }
+
+    ++_spriteBatch.stats.flushes;
+    _spriteBatch.count = 0;
+}
+
+/// @brief Draw everything queued since spriteBatchBegin
+void spriteBatchEnd()
+{
+    // End without a Begin!
+    assert(_spriteBatch.drawing);
+    spriteBatchFlush();
+    _spriteBatch.drawing = false;
+}
+
+/// @brief Counters since the last spriteBatchBegin
+/// @return 
+const SpriteBatchStats* spriteBatchGetStats()
+{
+    return &_spriteBatch.stats;
+}
+
+/// @brief Record a run of quads sharing a texture as one command, keyed on its furthest back sprite
+/// @param context unused
+/// @param texture 
+/// @param vertices 
+/// @param vertexCount 
+void spriteBatchSubmitRender(void* context, uint32_t texture, const RenderVertex* vertices, uint32_t vertexCount)
+{
+    RenderVertex* recorded = renderQuads(RENDER_LAYER_SPRITES, vertices[0].z, texture, vertexCount);
+    if (recorded != NULL)
+    {
+        memcpy(recorded, vertices, vertexCount * sizeof(RenderVertex));
+    }
+}
+
+/// @brief Map a depth onto an unsigned integer that sorts the same way
+/// @param depth 
+/// @return 
+static uint32_t _spriteBatchDepthBits(float depth)
+{
+    uint32_t bits;
+    memcpy(&bits, &depth, sizeof(bits));
+    // negatives sort backwards as raw bits, so flip them all; positives just go above them
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+}
+
+/// @brief qsort comparison on sort key, then queue order
+/// @param a 
+/// @param b 
+/// @return 
+static int _spriteBatchCompareKeys(const void* a, const void* b)
+{
+    const SpriteSortKey* keyA = (const SpriteSortKey*)a;
+    const SpriteSortKey* keyB = (const SpriteSortKey*)b;
+    if (keyA->key != keyB->key)
+    {
+        return keyA->key < keyB->key ? -1 : 1;
+    }
+    return keyA->index < keyB->index ? -1 : (keyA->index > keyB->index ? 1 : 0);
+}
+
+/// @brief Write the four corners of a sprite, in the same winding the immediate mode quads used
+/// @param sprite 
+/// @param quad 
+static void _spriteBatchEmitQuad(const Sprite* sprite, RenderVertex* quad)
+{
+    float left = sprite->center.x - sprite->size.x / 2;
+    float right = sprite->center.x + sprite->size.x / 2;
+    float top = sprite->center.y - sprite->size.y / 2;
+    float bottom = sprite->center.y + sprite->size.y / 2;
+
+    uint32_t argb = sprite->color;
+    uint32_t rgba = ((argb >> 16) & 0xFF) | (argb & 0xFF00) | ((argb & 0xFF) << 16) | (argb & 0xFF000000);
+
+    const float xs[4] = { left, left, right, right };
+    const float ys[4] = { top, bottom, bottom, top };
+    const float us[4] = { sprite->uv.topLeft.x, sprite->uv.topLeft.x, sprite->uv.botRight.x, sprite->uv.botRight.x };
+    const float vs[4] = { sprite->uv.topLeft.y, sprite->uv.botRight.y, sprite->uv.botRight.y, sprite->uv.topLeft.y };
+    for (uint32_t corner = 0; corner < 4; ++corner)
+    {
+        quad[corner].x = xs[corner];
+        quad[corner].y = ys[corner];
+        quad[corner].z = sprite->depth;
+        quad[corner].u = us[corner];
+        quad[corner].v = vs[corner];
+        quad[corner].rgba = rgba;
+    }
+}
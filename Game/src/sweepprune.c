@@ -0,0 +1,373 @@
+#include <Windows.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "baseTypes.h"
+#include "sweepprune.h"
+
+// an unused slot in the pair set
+#define SWEEP_PAIR_EMPTY UINT64_MAX
+// smallest pair set; always a power of two
+#define SWEEP_MIN_PAIR_SLOTS 64
+
+/// @brief One end of a proxy's x interval
+typedef struct sweep_endpoint_t {
+    float       value;
+    uint32_t    proxy;
+    uint32_t    isMax;
+} SweepEndpoint;
+
+/// @brief Sweep & prune on the x axis. Endpoints stay sorted between queries, so when things
+/// only move a little, the insertion sort that restores the order does little work. Every swap
+/// of a min & a max endpoint starts or ends an x overlap, which is tracked in a hash set of
+/// pairs; queries then only need a y test on that set
+typedef struct sweep_prune_t {
+    Broadphase      base;
+
+    SweepEndpoint*  endpoints;
+    uint32_t        endpointCount;
+    uint32_t        endpointCapacity;
+
+    // pairs overlapping on x, keyed by (low id << 32 | high id); open addressing, linear probing
+    uint64_t*       pairSet;
+    uint32_t        pairSlots;
+    uint32_t        pairSetCount;
+    // removed proxies whose pairs are still in the set; purged before the next add or query
+    uint32_t        stalePairs;
+} SweepPrune;
+
+// the broadphase vtable for sweep & prune; moves are picked up when pairs are next found
+static void _sweepPruneDelete(Broadphase* broadphase);
+static bool _sweepPruneAdd(Broadphase* broadphase, uint32_t proxy);
+static void _sweepPruneRemove(Broadphase* broadphase, uint32_t proxy);
+static void _sweepPruneFindPairs(Broadphase* broadphase);
+static const BroadphaseVtable _sweepPruneVtable = {
+    _sweepPruneDelete,
+    _sweepPruneAdd,
+    NULL,
+    _sweepPruneRemove,
+    _sweepPruneFindPairs
+};
+
+static void _sweepPruneSort(SweepPrune* sap);
+static void _sweepPrunePurge(SweepPrune* sap, uint32_t reused);
+static uint64_t _sweepPairKey(uint32_t a, uint32_t b);
+static uint32_t _sweepPairHome(uint64_t key, uint32_t mask);
+static bool _sweepPairInsert(SweepPrune* sap, uint64_t key);
+static void _sweepPairRemoveAt(SweepPrune* sap, uint32_t slot);
+static void _sweepPairRemove(SweepPrune* sap, uint64_t key);
+static bool _sweepPairGrow(SweepPrune* sap);
+
+/// @brief Create an empty sweep & prune broadphase
+/// @return 
+Broadphase* sweepPruneNew()
+{
+    SweepPrune* sap = malloc(sizeof(SweepPrune));
+    if (sap != NULL)
+    {
+        ZeroMemory(sap, sizeof(SweepPrune));
+        broadphaseInit(&sap->base, &_sweepPruneVtable);
+    }
+    return (Broadphase*)sap;
+}
+
+/// @brief Free the broadphase & all of its buffers
+/// @param broadphase 
+static void _sweepPruneDelete(Broadphase* broadphase)
+{
+    SweepPrune* sap = (SweepPrune*)broadphase;
+
+    broadphaseDeinit(&sap->base);
+    free(sap->endpoints);
+    free(sap->pairSet);
+    free(sap);
+}
+
+/// @brief Append the new proxy's endpoints; the next sort moves them into place, and the
+/// swaps on the way there record its overlaps
+/// @param broadphase 
+/// @param proxy 
+/// @return false if out of memory
+static bool _sweepPruneAdd(Broadphase* broadphase, uint32_t proxy)
+{
+    SweepPrune* sap = (SweepPrune*)broadphase;
+    // the id may be a removed proxy's, so its old pairs have to go first
+    _sweepPrunePurge(sap, proxy);
+    if (!broadphaseReserve((void**)&sap->endpoints, &sap->endpointCapacity, sap->endpointCount + 2, sizeof(SweepEndpoint)))
+    {
+        return false;
+    }
+
+    const Bounds2D* box = &sap->base.proxies[proxy].box;
+    SweepEndpoint* min = &sap->endpoints[sap->endpointCount++];
+    min->value = box->topLeft.x;
+    min->proxy = proxy;
+    min->isMax = 0;
+    SweepEndpoint* max = &sap->endpoints[sap->endpointCount++];
+    max->value = box->botRight.x;
+    max->proxy = proxy;
+    max->isMax = 1;
+    return true;
+}
+
+/// @brief Drop the proxy's endpoints. Its pairs stay in the set until the next purge, so
+/// removing many proxies in a row doesn't pass over the whole set for each
+/// @param broadphase 
+/// @param proxy 
+static void _sweepPruneRemove(Broadphase* broadphase, uint32_t proxy)
+{
+    SweepPrune* sap = (SweepPrune*)broadphase;
+
+    // close the gaps, keeping everything else in order
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < sap->endpointCount; ++i)
+    {
+        if (sap->endpoints[i].proxy != proxy)
+        {
+            sap->endpoints[kept++] = sap->endpoints[i];
+        }
+    }
+    sap->endpointCount = kept;
+    ++sap->stalePairs;
+}
+
+/// @brief Bring the sort order up to date, then report the x overlaps that also overlap on y
+/// @param broadphase 
+static void _sweepPruneFindPairs(Broadphase* broadphase)
+{
+    SweepPrune* sap = (SweepPrune*)broadphase;
+    const BroadphaseProxy* proxies = sap->base.proxies;
+
+    _sweepPrunePurge(sap, BROADPHASE_INVALID_PROXY);
+    _sweepPruneSort(sap);
+
+    for (uint32_t slot = 0; slot < sap->pairSlots; ++slot)
+    {
+        uint64_t key = sap->pairSet[slot];
+        if (key == SWEEP_PAIR_EMPTY)
+        {
+            continue;
+        }
+
+        uint32_t a = (uint32_t)(key >> 32);
+        uint32_t b = (uint32_t)key;
+        const Bounds2D* boxA = &proxies[a].box;
+        const Bounds2D* boxB = &proxies[b].box;
+        if (boxA->botRight.y < boxB->topLeft.y || boxB->botRight.y < boxA->topLeft.y)
+        {
+            continue;
+        }
+
+        if (!broadphaseAddPair(&sap->base, a, b))
+        {
+            return;
+        }
+    }
+}
+
+/// @brief Refresh the endpoint values, then insertion sort them. Mins sort ahead of maxes at
+/// the same value, so touching intervals count as overlapping
+/// @param sap 
+static void _sweepPruneSort(SweepPrune* sap)
+{
+    const BroadphaseProxy* proxies = sap->base.proxies;
+    SweepEndpoint* endpoints = sap->endpoints;
+
+    for (uint32_t i = 0; i < sap->endpointCount; ++i)
+    {
+        const Bounds2D* box = &proxies[endpoints[i].proxy].box;
+        endpoints[i].value = endpoints[i].isMax ? box->botRight.x : box->topLeft.x;
+    }
+
+    for (uint32_t i = 1; i < sap->endpointCount; ++i)
+    {
+        SweepEndpoint key = endpoints[i];
+        uint32_t j = i;
+        while (j > 0)
+        {
+            SweepEndpoint* prev = &endpoints[j - 1];
+            if (prev->value < key.value || (prev->value == key.value && (prev->isMax <= key.isMax)))
+            {
+                break;
+            }
+
+            // key moves left past prev
+            if (prev->proxy != key.proxy && prev->isMax != key.isMax)
+            {
+                uint64_t pairKey = _sweepPairKey(prev->proxy, key.proxy);
+                if (key.isMax)
+                {
+                    // key's max is now left of prev's min
+                    _sweepPairRemove(sap, pairKey);
+                }
+                else
+                {
+                    // key's min is now left of prev's max
+                    _sweepPairInsert(sap, pairKey);
+                }
+            }
+
+            endpoints[j] = *prev;
+            --j;
+        }
+        endpoints[j] = key;
+    }
+}
+
+/// @brief Drop every pair with a removed proxy in it, in one pass over the set
+/// @param sap 
+/// @param reused a proxy just added again, whose pairs are all stale, or BROADPHASE_INVALID_PROXY
+static void _sweepPrunePurge(SweepPrune* sap, uint32_t reused)
+{
+    if (sap->stalePairs == 0)
+    {
+        return;
+    }
+
+    const BroadphaseProxy* proxies = sap->base.proxies;
+    // removing shifts later entries back into this slot, so only advance past survivors
+    for (uint32_t slot = 0; slot < sap->pairSlots; )
+    {
+        uint64_t key = sap->pairSet[slot];
+        uint32_t a = (uint32_t)(key >> 32);
+        uint32_t b = (uint32_t)key;
+        if (key != SWEEP_PAIR_EMPTY && (!proxies[a].active || !proxies[b].active || a == reused || b == reused))
+        {
+            _sweepPairRemoveAt(sap, slot);
+        }
+        else
+        {
+            ++slot;
+        }
+    }
+    sap->stalePairs = 0;
+}
+
+/// @brief Pair set key; the same for either order of a & b
+/// @param a 
+/// @param b 
+/// @return 
+static uint64_t _sweepPairKey(uint32_t a, uint32_t b)
+{
+    return a < b ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+}
+
+/// @brief Slot a key would ideally occupy
+/// @param key 
+/// @param mask 
+/// @return 
+static uint32_t _sweepPairHome(uint64_t key, uint32_t mask)
+{
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
+
+/// @brief Add a pair to the set, if it isn't there already
+/// @param sap 
+/// @param key 
+/// @return false if the set could not grow
+static bool _sweepPairInsert(SweepPrune* sap, uint64_t key)
+{
+    // stay at most half full, so probe chains stay short
+    if (2 * (sap->pairSetCount + 1) > sap->pairSlots && !_sweepPairGrow(sap))
+    {
+        return false;
+    }
+
+    uint32_t mask = sap->pairSlots - 1;
+    uint32_t slot = _sweepPairHome(key, mask);
+    while (sap->pairSet[slot] != SWEEP_PAIR_EMPTY)
+    {
+        if (sap->pairSet[slot] == key)
+        {
+            return true;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    sap->pairSet[slot] = key;
+    ++sap->pairSetCount;
+    return true;
+}
+
+/// @brief Remove a pair from the set, if present
+/// @param sap 
+/// @param key 
+static void _sweepPairRemove(SweepPrune* sap, uint64_t key)
+{
+    if (sap->pairSlots == 0)
+    {
+        return;
+    }
+
+    uint32_t mask = sap->pairSlots - 1;
+    uint32_t slot = _sweepPairHome(key, mask);
+    while (sap->pairSet[slot] != SWEEP_PAIR_EMPTY)
+    {
+        if (sap->pairSet[slot] == key)
+        {
+            _sweepPairRemoveAt(sap, slot);
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+/// @brief Empty a slot, shifting later members of its probe chain back so no tombstones are needed
+/// @param sap 
+/// @param slot 
+static void _sweepPairRemoveAt(SweepPrune* sap, uint32_t slot)
+{
+    uint32_t mask = sap->pairSlots - 1;
+    uint32_t hole = slot;
+    uint32_t next = (hole + 1) & mask;
+    while (sap->pairSet[next] != SWEEP_PAIR_EMPTY)
+    {
+        // an entry can fill the hole if its home isn't cyclically between the hole & itself
+        uint32_t home = _sweepPairHome(sap->pairSet[next], mask);
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            sap->pairSet[hole] = sap->pairSet[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+
+    sap->pairSet[hole] = SWEEP_PAIR_EMPTY;
+    --sap->pairSetCount;
+}
+
+/// @brief Double the pair set & rehash everything into it
+/// @param sap 
+/// @return false if out of memory
+static bool _sweepPairGrow(SweepPrune* sap)
+{
+    uint32_t slots = sap->pairSlots > 0 ? 2 * sap->pairSlots : SWEEP_MIN_PAIR_SLOTS;
+    uint64_t* grown = malloc(slots * sizeof(uint64_t));
+    // out of memory for the pair set!
+    assert(grown != NULL);
+    if (grown == NULL)
+    {
+        return false;
+    }
+    memset(grown, 0xFF, slots * sizeof(uint64_t));
+
+    uint32_t mask = slots - 1;
+    for (uint32_t i = 0; i < sap->pairSlots; ++i)
+    {
+        uint64_t key = sap->pairSet[i];
+        if (key != SWEEP_PAIR_EMPTY)
+        {
+            uint32_t slot = _sweepPairHome(key, mask);
+            while (grown[slot] != SWEEP_PAIR_EMPTY)
+            {
+                slot = (slot + 1) & mask;
+            }
+            grown[slot] = key;
+        }
+    }
+
+    free(sap->pairSet);
+    sap->pairSet = grown;
+    sap->pairSlots = slots;
+    return true;
+}
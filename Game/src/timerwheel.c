@@ -0,0 +1,212 @@
+#include <Windows.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "baseTypes.h"
+#include "timerwheel.h"
+
+// marks the end of a slot's timer chain (and of the free chain)
+#define TIMER_NONE UINT32_MAX
+#define TIMER_SLOT_MASK (TIMER_WHEEL_SLOTS - 1)
+
+/// @brief A scheduled timer; chained into a wheel slot, or onto the free list
+typedef struct timer_node_t {
+    uint32_t    deadline;   // tick the timer is due on
+    uint32_t    next;
+    TimerFunc   func;
+    void*       context;
+    uint32_t    data;
+} TimerNode;
+
+/// @brief Level 0 holds timers due within the next TIMER_WHEEL_SLOTS ticks, one slot per tick.
+/// Each level up covers TIMER_WHEEL_SLOTS times the span of the one below, and its timers are
+/// cascaded down a level each time the level below wraps around
+struct timer_wheel_t {
+    TimerNode*  nodes;
+    uint32_t    maxTimers;
+    uint32_t    freeHead;
+    uint32_t    pending;
+
+    uint32_t    now;        // current tick, in milliseconds
+    uint32_t    slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+};
+
+static void _timerWheelInsert(TimerWheel* wheel, uint32_t index);
+static void _timerWheelCascade(TimerWheel* wheel, uint32_t level);
+static void _timerWheelExpire(TimerWheel* wheel, uint32_t slot);
+
+/// @brief Create a timer wheel with a fixed number of timers
+/// @param maxTimers 
+/// @return 
+TimerWheel* timerWheelNew(uint32_t maxTimers)
+{
+    TimerWheel* wheel = malloc(sizeof(TimerWheel));
+    if (wheel != NULL)
+    {
+        ZeroMemory(wheel, sizeof(TimerWheel));
+        wheel->nodes = malloc(maxTimers * sizeof(TimerNode));
+        if (wheel->nodes == NULL)
+        {
+            free(wheel);
+            return NULL;
+        }
+
+        // chain every timer onto the free list
+        for (uint32_t i = 0; i < maxTimers; ++i)
+        {
+            wheel->nodes[i].next = i + 1;
+        }
+        if (maxTimers > 0)
+        {
+            wheel->nodes[maxTimers - 1].next = TIMER_NONE;
+        }
+        wheel->maxTimers = maxTimers;
+        wheel->freeHead = maxTimers > 0 ? 0 : TIMER_NONE;
+
+        for (uint32_t level = 0; level < TIMER_WHEEL_LEVELS; ++level)
+        {
+            for (uint32_t slot = 0; slot < TIMER_WHEEL_SLOTS; ++slot)
+            {
+                wheel->slots[level][slot] = TIMER_NONE;
+            }
+        }
+    }
+    return wheel;
+}
+
+/// @brief Free the wheel. Pending timers are dropped without firing
+/// @param wheel 
+void timerWheelDelete(TimerWheel* wheel)
+{
+    if (wheel != NULL)
+    {
+        free(wheel->nodes);
+        free(wheel);
+    }
+}
+
+/// @brief Schedule func to be called once, after the given delay has elapsed
+/// @param wheel 
+/// @param milliseconds delay; 0 fires on the next tick
+/// @param func 
+/// @param context 
+/// @param data 
+/// @return false if every timer is in use
+bool timerWheelSchedule(TimerWheel* wheel, uint32_t milliseconds, TimerFunc func, void* context, uint32_t data)
+{
+    // out of timers!
+    assert(wheel->freeHead != TIMER_NONE);
+    if (wheel->freeHead == TIMER_NONE)
+    {
+        return false;
+    }
+
+    if (milliseconds == 0)
+    {
+        milliseconds = 1;
+    }
+    if (milliseconds > TIMER_WHEEL_MAX_DELAY)
+    {
+        milliseconds = TIMER_WHEEL_MAX_DELAY;
+    }
+
+    uint32_t index = wheel->freeHead;
+    TimerNode* node = &wheel->nodes[index];
+    wheel->freeHead = node->next;
+
+    node->deadline = wheel->now + milliseconds;
+    node->func = func;
+    node->context = context;
+    node->data = data;
+    _timerWheelInsert(wheel, index);
+    ++wheel->pending;
+    return true;
+}
+
+/// @brief Move time forward, firing every timer that comes due. Each tick only touches its own
+/// slot, so idle timers cost nothing until they expire or cascade
+/// @param wheel 
+/// @param milliseconds 
+void timerWheelAdvance(TimerWheel* wheel, uint32_t milliseconds)
+{
+    for (uint32_t i = 0; i < milliseconds; ++i)
+    {
+        ++wheel->now;
+
+        // whenever a level wraps around, pull the next slot of the level above down into it
+        uint32_t slot = wheel->now & TIMER_SLOT_MASK;
+        for (uint32_t level = 1; level < TIMER_WHEEL_LEVELS && slot == 0; ++level)
+        {
+            slot = (wheel->now >> (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_SLOT_MASK;
+            _timerWheelCascade(wheel, level);
+        }
+
+        _timerWheelExpire(wheel, wheel->now & TIMER_SLOT_MASK);
+    }
+}
+
+/// @brief Number of timers waiting to fire
+/// @param wheel 
+/// @return 
+uint32_t timerWheelGetPending(const TimerWheel* wheel)
+{
+    return wheel->pending;
+}
+
+/// @brief Link a timer into the slot for its deadline, on the coarsest level it needs
+/// @param wheel 
+/// @param index 
+static void _timerWheelInsert(TimerWheel* wheel, uint32_t index)
+{
+    TimerNode* node = &wheel->nodes[index];
+    uint32_t delta = node->deadline - wheel->now;
+
+    uint32_t level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= (1u << ((level + 1) * TIMER_WHEEL_SLOT_BITS)))
+    {
+        ++level;
+    }
+
+    uint32_t slot = (node->deadline >> (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_SLOT_MASK;
+    node->next = wheel->slots[level][slot];
+    wheel->slots[level][slot] = index;
+}
+
+/// @brief Redistribute the current slot of a level onto the levels below it
+/// @param wheel 
+/// @param level 
+static void _timerWheelCascade(TimerWheel* wheel, uint32_t level)
+{
+    uint32_t slot = (wheel->now >> (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_SLOT_MASK;
+    uint32_t index = wheel->slots[level][slot];
+    wheel->slots[level][slot] = TIMER_NONE;
+
+    while (index != TIMER_NONE)
+    {
+        uint32_t next = wheel->nodes[index].next;
+        _timerWheelInsert(wheel, index);
+        index = next;
+    }
+}
+
+/// @brief Fire & recycle every timer in a level 0 slot
+/// @param wheel 
+/// @param slot 
+static void _timerWheelExpire(TimerWheel* wheel, uint32_t slot)
+{
+    // detach the chain first, so callbacks can safely schedule new timers
+    uint32_t index = wheel->slots[0][slot];
+    wheel->slots[0][slot] = TIMER_NONE;
+
+    while (index != TIMER_NONE)
+    {
+        TimerNode node = wheel->nodes[index];
+
+        // recycle before firing, so the callback can reuse the timer
+        wheel->nodes[index].next = wheel->freeHead;
+        wheel->freeHead = index;
+        --wheel->pending;
+
+        node.func(node.context, node.data);
+        index = node.next;
+    }
+}
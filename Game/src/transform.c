@@ -0,0 +1,191 @@
+#include <Windows.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+#include <immintrin.h>
+#include "baseTypes.h"
+#include "transform.h"
+
+#if defined(GAME_FIXED_POINT)
+// Q16.16 products need a 64 bit intermediate & a shift; left to the scalar loop
+#elif defined(__AVX__)
+#define TRANSFORM_USE_AVX
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRANSFORM_USE_SSE
+#endif
+
+// posX, posY, velX, velY, accX, accY, prevX, prevY
+#define TRANSFORM_ARRAY_COUNT 8
+
+/// @brief Allocate a transform store. All arrays share one aligned block
+/// @param capacity 
+/// @return 
+TransformStore* transformStoreNew(uint32_t capacity)
+{
+    TransformStore* store = malloc(sizeof(TransformStore));
+    if (store != NULL)
+    {
+        // round up so every array starts on an aligned boundary
+        uint32_t padded = (capacity + TRANSFORM_LANES - 1) & ~(uint32_t)(TRANSFORM_LANES - 1);
+        size_t arrayBytes = padded * sizeof(Real);
+
+        Real* block = _aligned_malloc(TRANSFORM_ARRAY_COUNT * arrayBytes, TRANSFORM_ALIGNMENT);
+        if (block == NULL)
+        {
+            free(store);
+            return NULL;
+        }
+        ZeroMemory(block, TRANSFORM_ARRAY_COUNT * arrayBytes);
+
+        store->posX = block;
+        store->posY = block + padded;
+        store->velX = block + 2 * padded;
+        store->velY = block + 3 * padded;
+        store->accX = block + 4 * padded;
+        store->accY = block + 5 * padded;
+        store->prevX = block + 6 * padded;
+        store->prevY = block + 7 * padded;
+        store->capacity = padded;
+    }
+    return store;
+}
+
+/// @brief Free up the store and its arrays
+/// @param store 
+void transformStoreDelete(TransformStore* store)
+{
+    if (store != NULL)
+    {
+        _aligned_free(store->posX);
+        free(store);
+    }
+}
+
+/// @brief Write a transform into the store. The previous position is set to match,
+/// so a newly added object doesn't interpolate in from elsewhere
+/// @param store 
+/// @param index 
+/// @param pos 
+/// @param vel 
+/// @param accel 
+void transformStoreSet(TransformStore* store, uint32_t index, RealCoord2D pos, RealCoord2D vel, RealCoord2D accel)
+{
+    assert(index < store->capacity);
+    store->posX[index] = pos.x;
+    store->posY[index] = pos.y;
+    store->velX[index] = vel.x;
+    store->velY[index] = vel.y;
+    store->accX[index] = accel.x;
+    store->accY[index] = accel.y;
+    store->prevX[index] = pos.x;
+    store->prevY[index] = pos.y;
+}
+
+/// @brief Copy a transform from one index to another (used to keep the store packed)
+/// @param store 
+/// @param dstIndex 
+/// @param srcIndex 
+void transformStoreMove(TransformStore* store, uint32_t dstIndex, uint32_t srcIndex)
+{
+    assert(dstIndex < store->capacity && srcIndex < store->capacity);
+    store->posX[dstIndex] = store->posX[srcIndex];
+    store->posY[dstIndex] = store->posY[srcIndex];
+    store->velX[dstIndex] = store->velX[srcIndex];
+    store->velY[dstIndex] = store->velY[srcIndex];
+    store->accX[dstIndex] = store->accX[srcIndex];
+    store->accY[dstIndex] = store->accY[srcIndex];
+    store->prevX[dstIndex] = store->prevX[srcIndex];
+    store->prevY[dstIndex] = store->prevY[srcIndex];
+}
+
+/// @brief Remember the current positions of the first count transforms, ahead of a fixed step
+/// @param store 
+/// @param count 
+void transformStoreSnapshot(TransformStore* store, uint32_t count)
+{
+    assert(count <= store->capacity);
+    memcpy(store->prevX, store->posX, count * sizeof(Real));
+    memcpy(store->prevY, store->posY, count * sizeof(Real));
+}
+
+/// @brief Semi-implicit Euler over every transform, 8 (AVX) or 4 (SSE) at a time: velocity
+/// picks up the acceleration first, then position moves at the new velocity
+/// @param store 
+/// @param count 
+/// @param dt seconds
+void transformIntegrate(TransformStore* store, uint32_t count, float dt)
+{
+    transformIntegrateRange(store, 0, count, dt);
+}
+
+/// @brief transformIntegrate over the transforms in [begin, end). Ranges that don't overlap
+/// can be integrated on different threads
+/// @param store 
+/// @param begin must be a multiple of TRANSFORM_LANES, so the loads stay aligned
+/// @param end 
+/// @param dt seconds
+void transformIntegrateRange(TransformStore* store, uint32_t begin, uint32_t end, float dt)
+{
+    assert(begin % TRANSFORM_LANES == 0 && end <= store->capacity);
+    uint32_t i = begin;
+
+    // mul + add rather than fma, so every path rounds identically to the scalar one
+#if defined(TRANSFORM_USE_AVX)
+    __m256 step = _mm256_set1_ps(dt);
+    for (; i + 8 <= end; i += 8)
+    {
+        __m256 px = _mm256_load_ps(store->posX + i);
+        __m256 py = _mm256_load_ps(store->posY + i);
+        __m256 ax = _mm256_load_ps(store->accX + i);
+        __m256 ay = _mm256_load_ps(store->accY + i);
+        __m256 vx = _mm256_add_ps(_mm256_load_ps(store->velX + i), _mm256_mul_ps(ax, step));
+        __m256 vy = _mm256_add_ps(_mm256_load_ps(store->velY + i), _mm256_mul_ps(ay, step));
+        _mm256_store_ps(store->velX + i, vx);
+        _mm256_store_ps(store->velY + i, vy);
+        _mm256_store_ps(store->posX + i, _mm256_add_ps(px, _mm256_mul_ps(vx, step)));
+        _mm256_store_ps(store->posY + i, _mm256_add_ps(py, _mm256_mul_ps(vy, step)));
+    }
+#elif defined(TRANSFORM_USE_SSE)
+    __m128 step = _mm_set1_ps(dt);
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 px = _mm_load_ps(store->posX + i);
+        __m128 py = _mm_load_ps(store->posY + i);
+        __m128 ax = _mm_load_ps(store->accX + i);
+        __m128 ay = _mm_load_ps(store->accY + i);
+        __m128 vx = _mm_add_ps(_mm_load_ps(store->velX + i), _mm_mul_ps(ax, step));
+        __m128 vy = _mm_add_ps(_mm_load_ps(store->velY + i), _mm_mul_ps(ay, step));
+        _mm_store_ps(store->velX + i, vx);
+        _mm_store_ps(store->velY + i, vy);
+        _mm_store_ps(store->posX + i, _mm_add_ps(px, _mm_mul_ps(vx, step)));
+        _mm_store_ps(store->posY + i, _mm_add_ps(py, _mm_mul_ps(vy, step)));
+    }
+#endif
+
+    // remainder that doesn't fill a whole register
+    Real realDt = realFromFloat(dt);
+    for (; i < end; ++i)
+    {
+        store->velX[i] += realMul(store->accX[i], realDt);
+        store->velY[i] += realMul(store->accY[i], realDt);
+        store->posX[i] += realMul(store->velX[i], realDt);
+        store->posY[i] += realMul(store->velY[i], realDt);
+    }
+}
+
+/// @brief Reference implementation of transformIntegrate
+/// @param store 
+/// @param count 
+/// @param dt 
+void transformIntegrateScalar(TransformStore* store, uint32_t count, float dt)
+{
+    Real realDt = realFromFloat(dt);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        store->velX[i] += realMul(store->accX[i], realDt);
+        store->velY[i] += realMul(store->accY[i], realDt);
+        store->posX[i] += realMul(store->velX[i], realDt);
+        store->posY[i] += realMul(store->velY[i], realDt);
+    }
+}
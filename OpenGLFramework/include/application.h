@@ -23,11 +23,15 @@ void appSetWidth(Application* app, uint32_t width);
 void appSetHeight(Application* app, uint32_t height);
 void appSetBitsPerPixel(Application* app, uint32_t bpp);
 void appSetMaxSounds(Application* app, uint32_t maxSounds);
+void appSetFrameArenaSize(Application* app, uint32_t bytes);
+void appSetWorkerThreads(Application* app, uint32_t workerThreads);
 
 uint32_t appGetWidth(const Application* app);
 uint32_t appGetHeight(const Application* app);
 uint32_t appGetBitsPerPixel(const Application* app);
 uint32_t appGetMaxSounds(const Application* app);
+uint32_t appGetFrameArenaSize(const Application* app);
+uint32_t appGetWorkerThreads(const Application* app);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,29 @@
+#pragma once
+#include "baseTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ARENA_DEFAULT_ALIGNMENT 16
+
+typedef struct arena_t Arena;
+
+/// @brief Snapshot of an arena's memory use
+typedef struct arena_stats_t {
+    size_t      capacity;
+    size_t      used;           // bytes handed out since the last reset
+    size_t      highWater;      // most bytes ever in use between resets
+    uint32_t    failedAllocs;   // requests that did not fit
+} ArenaStats;
+
+Arena* arenaNew(size_t capacity);
+void arenaDelete(Arena* arena);
+
+void* arenaAlloc(Arena* arena, size_t size, size_t alignment);
+void arenaReset(Arena* arena);
+void arenaGetStats(const Arena* arena, ArenaStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,6 @@
 #pragma once
 #include "application.h"
+#include "arena.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -15,6 +16,11 @@ void fwSendTerminate(GLWindow* window);
 void fwSendFullscreen(GLWindow* window, bool fullscreen);
 bool fwChangeResolution(GLWindow* window, uint32_t width, uint32_t height, uint32_t bitsPerPixel);
 
+// the per-frame arena, reset at the start of every fwUpdateWindow;
+// allocations are only valid until the end of the current frame
+Arena* fwGetFrameArena();
+#define FRAME_ALLOC(type, count) ((type*)arenaAlloc(fwGetFrameArena(), sizeof(type) * (count), ARENA_DEFAULT_ALIGNMENT))
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+#include <Windows.h>
+#include <gl/GL.h>
+#include "baseTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief GL calls made through the shadow state over a frame
+typedef struct gl_state_stats_t {
+    uint32_t    issued;     // reached GL
+    uint32_t    elided;     // skipped, as GL already had that state
+} GLStateStats;
+
+void glStateInvalidate();
+void glStateBeginFrame();
+const GLStateStats* glStateGetFrameStats();
+
+void glStateEnable(GLenum cap);
+void glStateDisable(GLenum cap);
+void glStateEnableClientState(GLenum array);
+void glStateDisableClientState(GLenum array);
+void glStateBindTexture(GLuint texture);
+void glStateBlendFunc(GLenum source, GLenum destination);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,22 @@
+#pragma once
+#include "baseTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// upper bound on worker threads, regardless of core count
+#define JOBS_MAX_WORKERS 32
+
+// processes the half-open index range [begin, end)
+typedef void (*JobRangeFunc)(void* data, uint32_t begin, uint32_t end);
+
+bool jobsInit(uint32_t workerThreads);
+void jobsShutdown();
+uint32_t jobsGetThreadCount();
+
+void jobsParallelFor(uint32_t count, uint32_t grainSize, JobRangeFunc func, void* data);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+#include "baseTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// chunks & elements are aligned to this, so no element straddles a cache line boundary it doesn't need to
+#define POOL_CACHE_LINE 64
+
+typedef struct pool_t Pool;
+
+/// @brief Snapshot of a pool's memory use
+typedef struct pool_stats_t {
+    const char* name;
+    uint32_t    elementSize;    // stride, after rounding up to the cache line
+    uint32_t    chunkCount;
+    uint32_t    capacity;       // elements across all chunks
+    uint32_t    used;
+    uint32_t    highWater;      // most elements ever in use at once
+    uint32_t    emptyChunks;    // chunks with no elements in use
+    float       occupancy;      // used / capacity
+    float       fragmentation;  // free elements stranded in partially used chunks / capacity
+} PoolStats;
+
+Pool* poolNew(const char* name, size_t elementSize, uint32_t elementsPerChunk);
+void poolDelete(Pool* pool);
+
+void* poolAlloc(Pool* pool);
+void poolFree(Pool* pool, void* element);
+
+void poolGetStats(Pool* pool, PoolStats* stats);
+void poolLogAllStats();
+
+// send every pool's allocations straight to malloc & free, for comparing against plain
+// allocation; only while no pool has elements in use
+void poolSetPassthrough(bool passthrough);
+
+// typed helpers, so each object type can declare its pool by struct
+#define POOL_NEW(type, elementsPerChunk) poolNew(#type, sizeof(type), (elementsPerChunk))
+#define POOL_ALLOC(pool, type) ((type*)poolAlloc(pool))
+
+#ifdef __cplusplus
+}
+#endif
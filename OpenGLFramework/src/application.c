@@ -16,6 +16,12 @@ struct application_t {
 
     // audio
     uint32_t    maxSounds;
+
+    // memory
+    uint32_t    frameArenaSize;
+
+    // threading; 0 means one worker per additional core
+    uint32_t    workerThreads;
 };
 
 /// @brief Create an instance of an application with default settings
@@ -28,6 +34,8 @@ Application* appNew(HINSTANCE instance, const char* title, AppDrawFunc drawFunc,
     const uint32_t DEFAULT_HEIGHT = 768;
     const uint32_t DEFAULT_BPP = 24;
     const uint32_t DEFAULT_MAXSOUNDS = 20;
+    const uint32_t DEFAULT_FRAME_ARENA_SIZE = 1024 * 1024;
+    const uint32_t DEFAULT_WORKER_THREADS = 0;
 
     Application* app = malloc(sizeof(Application));
     if (app != NULL) {
@@ -40,6 +48,8 @@ Application* appNew(HINSTANCE instance, const char* title, AppDrawFunc drawFunc,
         app->height = DEFAULT_HEIGHT;
         app->bpp = DEFAULT_BPP;
         app->maxSounds = DEFAULT_MAXSOUNDS;
+        app->frameArenaSize = DEFAULT_FRAME_ARENA_SIZE;
+        app->workerThreads = DEFAULT_WORKER_THREADS;
     }
 
     return app;
@@ -80,6 +90,8 @@ void appSetWidth(Application* app, uint32_t width) { app->width = width; }
 void appSetHeight(Application* app, uint32_t height) { app->height = height; }
 void appSetBitsPerPixel(Application* app, uint32_t bpp) { app->bpp = bpp; }
 void appSetMaxSounds(Application* app, uint32_t maxSounds) { app->maxSounds = maxSounds; }
+void appSetFrameArenaSize(Application* app, uint32_t bytes) { app->frameArenaSize = bytes; }
+void appSetWorkerThreads(Application* app, uint32_t workerThreads) { app->workerThreads = workerThreads; }
 
 /*
  * Getters for various application fields
@@ -90,3 +102,5 @@ uint32_t appGetWidth(const Application* app) { return app->width; }
 uint32_t appGetHeight(const Application* app) { return app->height; }
 uint32_t appGetBitsPerPixel(const Application* app) { return app->bpp; }
 uint32_t appGetMaxSounds(const Application* app) { return app->maxSounds; }
+uint32_t appGetFrameArenaSize(const Application* app) { return app->frameArenaSize; }
+uint32_t appGetWorkerThreads(const Application* app) { return app->workerThreads; }
@@ -0,0 +1,98 @@
+#include <Windows.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+#include "arena.h"
+
+// debug builds fill released memory with this, so stale frame pointers are easy to spot
+#define ARENA_POISON 0xDD
+
+struct arena_t {
+    uint8_t*    base;
+    size_t      capacity;
+    size_t      offset;
+    size_t      highWater;
+    uint32_t    failedAllocs;
+};
+
+/// @brief Create a linear allocator over a single fixed block
+/// @param capacity 
+/// @return 
+Arena* arenaNew(size_t capacity)
+{
+    Arena* arena = malloc(sizeof(Arena));
+    if (arena != NULL)
+    {
+        ZeroMemory(arena, sizeof(Arena));
+        arena->base = _aligned_malloc(capacity, ARENA_DEFAULT_ALIGNMENT);
+        if (arena->base == NULL)
+        {
+            free(arena);
+            return NULL;
+        }
+        arena->capacity = capacity;
+#ifdef _DEBUG
+        memset(arena->base, ARENA_POISON, capacity);
+#endif
+    }
+    return arena;
+}
+
+/// @brief Free the arena and its block
+/// @param arena 
+void arenaDelete(Arena* arena)
+{
+    if (arena != NULL)
+    {
+        _aligned_free(arena->base);
+        free(arena);
+    }
+}
+
+/// @brief Bump-allocate from the arena. There is no individual free; see arenaReset
+/// @param arena 
+/// @param size 
+/// @param alignment must be a power of two
+/// @return NULL if the request does not fit
+void* arenaAlloc(Arena* arena, size_t size, size_t alignment)
+{
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+    size_t start = (arena->offset + alignment - 1) & ~(alignment - 1);
+    if (start + size > arena->capacity)
+    {
+        // arena is too small for this frame's scratch memory!
+        ++arena->failedAllocs;
+        assert(false);
+        return NULL;
+    }
+
+    arena->offset = start + size;
+    if (arena->offset > arena->highWater)
+    {
+        arena->highWater = arena->offset;
+    }
+    return arena->base + start;
+}
+
+/// @brief Release everything allocated from the arena at once
+/// @param arena 
+void arenaReset(Arena* arena)
+{
+#ifdef _DEBUG
+    memset(arena->base, ARENA_POISON, arena->offset);
+#endif
+    arena->offset = 0;
+}
+
+/// @brief Retrieve usage numbers for the arena
+/// @param arena 
+/// @param stats 
+void arenaGetStats(const Arena* arena, ArenaStats* stats)
+{
+    stats->capacity = arena->capacity;
+    stats->used = arena->offset;
+    stats->highWater = arena->highWater;
+    stats->failedAllocs = arena->failedAllocs;
+}
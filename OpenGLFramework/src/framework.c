@@ -7,6 +7,8 @@
 #include "openglDraw.h"
 #include "input.h"
 #include "sound.h"
+#include "arena.h"
+#include "jobs.h"
 
 // Application Define Message For Toggling
 #define WM_TOGGLEFULLSCREEN (WM_USER+1)
@@ -21,6 +23,9 @@
 
 static const char CLASS_NAME[] = "OpenGL Application";
 
+// scratch memory for the current frame
+static Arena* _frameArena = NULL;
+
 typedef struct gl_window_t {						// Contains Information Vital To A Window
 	Application*		app;
 
@@ -66,6 +71,8 @@ GLWindow* fwInitWindow(Application* app)
 	// initialize core systems
 	soundInit(appGetMaxSounds(app));
 	inputInit();
+	_frameArena = arenaNew(appGetFrameArenaSize(app));
+	jobsInit(appGetWorkerThreads(app));
 
 	// Register A Class For Our Window To Use
 	if (!_registerWindowClass(app))
@@ -92,6 +99,12 @@ GLWindow* fwInitWindow(Application* app)
 
 bool fwUpdateWindow(GLWindow* window)
 {
+	// everything allocated from the frame arena last iteration is released
+	if (_frameArena != NULL)
+	{
+		arenaReset(_frameArena);
+	}
+
 	// --- Windows message pump ---
 	MSG msg;
 	if (PeekMessage(&msg, window->hWnd, 0, 0, PM_REMOVE) != 0)
@@ -145,8 +158,28 @@ void fwShutdownWindow(GLWindow* window)
 	// UnRegister Window Class
 	UnregisterClass(CLASS_NAME, inst);
 
+	jobsShutdown();
 	inputShutdown();
 	soundShutdown();
+
+#ifdef _DEBUG
+	if (_frameArena != NULL)
+	{
+		ArenaStats stats;
+		arenaGetStats(_frameArena, &stats);
+		printf("frame arena high-water mark: %zu of %zu bytes, %u failed allocations\n",
+			stats.highWater, stats.capacity, stats.failedAllocs);
+	}
+#endif
+	arenaDelete(_frameArena);
+	_frameArena = NULL;
+}
+
+/// @brief Access the per-frame scratch arena
+/// @return 
+Arena* fwGetFrameArena()
+{
+	return _frameArena;
 }
 
 /// @brief Sends a message to terminate the application
@@ -0,0 +1,178 @@
+#include <Windows.h>
+#include <gl/GL.h>
+#include <assert.h>
+#include "glstate.h"
+
+// shadow values; zero means unknown, so the first call of each kind always reaches GL
+#define GL_STATE_UNKNOWN 0
+#define GL_STATE_DISABLED 1
+#define GL_STATE_ENABLED 2
+
+// capabilities & client arrays the shadow state tracks; anything else goes straight to GL
+static const GLenum _glStateCaps[] = {
+    GL_TEXTURE_2D, GL_BLEND, GL_LINE_SMOOTH, GL_DEPTH_TEST, GL_CULL_FACE
+};
+static const GLenum _glStateArrays[] = {
+    GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY
+};
+#define GL_STATE_CAP_COUNT (sizeof(_glStateCaps) / sizeof(_glStateCaps[0]))
+#define GL_STATE_ARRAY_COUNT (sizeof(_glStateArrays) / sizeof(_glStateArrays[0]))
+
+static struct gl_state_t {
+    uint8_t         caps[GL_STATE_CAP_COUNT];       // GL_STATE_ values
+    uint8_t         arrays[GL_STATE_ARRAY_COUNT];
+    GLuint          texture;
+    bool            textureKnown;
+    GLenum          blendSource;
+    GLenum          blendDestination;
+    bool            blendKnown;
+
+    GLStateStats    frame;          // counting the current frame
+    GLStateStats    lastFrame;
+} _glState = { 0 };
+
+static bool _glStateSet(uint8_t* shadow, bool enable);
+static int32_t _glStateFind(const GLenum* list, uint32_t count, GLenum value);
+
+/// @brief Forget what GL is thought to hold, so every call reaches GL again. Needed after
+/// a new context, or anything that changes this state without going through here
+void glStateInvalidate()
+{
+    for (uint32_t i = 0; i < GL_STATE_CAP_COUNT; ++i)
+    {
+        _glState.caps[i] = GL_STATE_UNKNOWN;
+    }
+    for (uint32_t i = 0; i < GL_STATE_ARRAY_COUNT; ++i)
+    {
+        _glState.arrays[i] = GL_STATE_UNKNOWN;
+    }
+    _glState.textureKnown = false;
+    _glState.blendKnown = false;
+}
+
+/// @brief Close the previous frame's counts & start new ones
+void glStateBeginFrame()
+{
+    _glState.lastFrame = _glState.frame;
+    _glState.frame.issued = _glState.frame.elided = 0;
+}
+
+/// @brief Calls issued & elided over the last whole frame
+/// @return 
+const GLStateStats* glStateGetFrameStats()
+{
+    return &_glState.lastFrame;
+}
+
+/// @brief glEnable, skipped if the capability is tracked & already enabled
+/// @param cap 
+void glStateEnable(GLenum cap)
+{
+    int32_t index = _glStateFind(_glStateCaps, GL_STATE_CAP_COUNT, cap);
+    if (_glStateSet(index >= 0 ? &_glState.caps[index] : NULL, true))
+    {
+        glEnable(cap);
+    }
+}
+
+/// @brief glDisable, skipped if the capability is tracked & already disabled
+/// @param cap 
+void glStateDisable(GLenum cap)
+{
+    int32_t index = _glStateFind(_glStateCaps, GL_STATE_CAP_COUNT, cap);
+    if (_glStateSet(index >= 0 ? &_glState.caps[index] : NULL, false))
+    {
+        glDisable(cap);
+    }
+}
+
+/// @brief glEnableClientState, skipped if the array is tracked & already enabled
+/// @param array 
+void glStateEnableClientState(GLenum array)
+{
+    int32_t index = _glStateFind(_glStateArrays, GL_STATE_ARRAY_COUNT, array);
+    if (_glStateSet(index >= 0 ? &_glState.arrays[index] : NULL, true))
+    {
+        glEnableClientState(array);
+    }
+}
+
+/// @brief glDisableClientState, skipped if the array is tracked & already disabled
+/// @param array 
+void glStateDisableClientState(GLenum array)
+{
+    int32_t index = _glStateFind(_glStateArrays, GL_STATE_ARRAY_COUNT, array);
+    if (_glStateSet(index >= 0 ? &_glState.arrays[index] : NULL, false))
+    {
+        glDisableClientState(array);
+    }
+}
+
+/// @brief glBindTexture on GL_TEXTURE_2D, skipped if the texture is already bound
+/// @param texture 
+void glStateBindTexture(GLuint texture)
+{
+    if (_glState.textureKnown && _glState.texture == texture)
+    {
+        ++_glState.frame.elided;
+        return;
+    }
+    ++_glState.frame.issued;
+    _glState.texture = texture;
+    _glState.textureKnown = true;
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+/// @brief glBlendFunc, skipped if the factors are already set
+/// @param source 
+/// @param destination 
+void glStateBlendFunc(GLenum source, GLenum destination)
+{
+    if (_glState.blendKnown && _glState.blendSource == source && _glState.blendDestination == destination)
+    {
+        ++_glState.frame.elided;
+        return;
+    }
+    ++_glState.frame.issued;
+    _glState.blendSource = source;
+    _glState.blendDestination = destination;
+    _glState.blendKnown = true;
+    glBlendFunc(source, destination);
+}
+
+/// @brief Update an on/off state & count the call
+/// @param shadow the tracked state, or NULL if untracked
+/// @param enable 
+/// @return true if GL needs the call
+static bool _glStateSet(uint8_t* shadow, bool enable)
+{
+    uint8_t value = enable ? GL_STATE_ENABLED : GL_STATE_DISABLED;
+    if (shadow != NULL && *shadow == value)
+    {
+        ++_glState.frame.elided;
+        return false;
+    }
+    ++_glState.frame.issued;
+    if (shadow != NULL)
+    {
+        *shadow = value;
+    }
+    return true;
+}
+
+/// @brief Linear search of a short list of enums
+/// @param list 
+/// @param count 
+/// @param value 
+/// @return the index, or -1 if not found
+static int32_t _glStateFind(const GLenum* list, uint32_t count, GLenum value)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (list[i] == value)
+        {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,306 @@
+#include <stdlib.h>
+#include <assert.h>
+#include "jobs.h"
+#include "jobsthread.h"
+
+// per-worker deque capacity; must be a power of two
+#define JOBS_DEQUE_SIZE 1024
+#define JOBS_DEQUE_MASK (JOBS_DEQUE_SIZE - 1)
+
+/// @brief One chunk of a parallel for
+typedef struct job_t {
+    JobRangeFunc    func;
+    void*           data;
+    uint32_t        begin;
+    uint32_t        end;
+    JobsCounter*    remaining;  // chunks of the owning parallel for still to finish
+} Job;
+
+/// @brief Owner pushes & pops at the bottom, thieves steal from the top
+typedef struct job_deque_t {
+    JobsLock    lock;
+    uint32_t    top;
+    uint32_t    bottom;
+    Job         jobs[JOBS_DEQUE_SIZE];
+} JobDeque;
+
+static struct jobs_t {
+    JobDeque*           deques;         // one per thread; [0] belongs to the thread that called jobsInit
+    JobsThread          workers[JOBS_MAX_WORKERS];
+    uint32_t            workerCount;    // threads actually started
+    uint32_t            threadCount;    // deques: requested workers + the calling thread
+
+    JobsCounter         pending;        // jobs queued but not yet taken
+    JobsCounter         shutdown;
+    JobsLock            sleepLock;
+    JobsCondition       wake;
+} _jobs = { NULL };
+
+// which deque the current thread owns
+static JOBS_THREAD_LOCAL uint32_t _jobsThreadIndex = 0;
+
+static JOBS_THREAD_FUNC(_jobsWorkerMain);
+static bool _jobsPush(JobDeque* deque, const Job* job);
+static bool _jobsPop(JobDeque* deque, Job* job);
+static bool _jobsSteal(JobDeque* deque, Job* job);
+static bool _jobsFind(uint32_t self, Job* job);
+static void _jobsRun(const Job* job);
+
+/// @brief Start the worker threads
+/// @param workerThreads number of threads in addition to the caller; 0 picks one per remaining core
+/// @return 
+bool jobsInit(uint32_t workerThreads)
+{
+    if (workerThreads == 0)
+    {
+        uint32_t cores = jobsGetCoreCount();
+        workerThreads = cores > 1 ? cores - 1 : 0;
+    }
+    if (workerThreads > JOBS_MAX_WORKERS)
+    {
+        workerThreads = JOBS_MAX_WORKERS;
+    }
+
+    _jobs.deques = malloc((workerThreads + 1) * sizeof(JobDeque));
+    if (_jobs.deques == NULL)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i <= workerThreads; ++i)
+    {
+        jobsLockInit(&_jobs.deques[i].lock);
+        _jobs.deques[i].top = _jobs.deques[i].bottom = 0;
+    }
+
+    jobsLockInit(&_jobs.sleepLock);
+    jobsConditionInit(&_jobs.wake);
+    jobsCounterStore(&_jobs.pending, 0);
+    jobsCounterStore(&_jobs.shutdown, 0);
+    _jobs.workerCount = 0;
+    _jobsThreadIndex = 0;
+
+    // fixed before any worker starts reading it; if a thread fails to start, its
+    // deque simply has no owner and other threads steal everything dealt to it
+    _jobs.threadCount = workerThreads + 1;
+
+    for (uint32_t i = 0; i < workerThreads; ++i)
+    {
+        if (jobsThreadStart(&_jobs.workers[_jobs.workerCount], _jobsWorkerMain, (void*)(uintptr_t)(i + 1)))
+        {
+            ++_jobs.workerCount;
+        }
+    }
+    return true;
+}
+
+/// @brief Stop & join the worker threads
+void jobsShutdown()
+{
+    if (_jobs.deques == NULL)
+    {
+        return;
+    }
+
+    jobsLockAcquire(&_jobs.sleepLock);
+    jobsCounterStore(&_jobs.shutdown, 1);
+    jobsLockRelease(&_jobs.sleepLock);
+    jobsConditionWakeAll(&_jobs.wake);
+
+    for (uint32_t i = 0; i < _jobs.workerCount; ++i)
+    {
+        jobsThreadJoin(_jobs.workers[i]);
+    }
+
+    for (uint32_t i = 0; i < _jobs.threadCount; ++i)
+    {
+        jobsLockDestroy(&_jobs.deques[i].lock);
+    }
+    jobsLockDestroy(&_jobs.sleepLock);
+    jobsConditionDestroy(&_jobs.wake);
+
+    free(_jobs.deques);
+    _jobs.deques = NULL;
+    _jobs.workerCount = _jobs.threadCount = 0;
+}
+
+/// @brief Number of threads that run jobs, including the caller of jobsParallelFor
+/// @return 
+uint32_t jobsGetThreadCount()
+{
+    return _jobs.workerCount + 1;
+}
+
+/// @brief Run func over [0, count) in chunks of grainSize, spread across all threads.
+/// The caller helps process chunks and returns once every chunk has finished
+/// @param count 
+/// @param grainSize 
+/// @param func 
+/// @param data 
+void jobsParallelFor(uint32_t count, uint32_t grainSize, JobRangeFunc func, void* data)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    if (grainSize == 0)
+    {
+        grainSize = 1;
+    }
+
+    // not worth splitting up
+    if (_jobs.workerCount == 0 || count <= grainSize)
+    {
+        func(data, 0, count);
+        return;
+    }
+
+    uint32_t chunks = (count + grainSize - 1) / grainSize;
+    JobsCounter remaining;
+    jobsCounterStore(&remaining, (int32_t)chunks);
+    uint32_t self = _jobsThreadIndex;
+
+    // deal the chunks round robin, so every worker starts with local work
+    int32_t queued = 0;
+    for (uint32_t c = 0; c < chunks; ++c)
+    {
+        uint32_t end = (c + 1) * grainSize < count ? (c + 1) * grainSize : count;
+        Job job = { func, data, c * grainSize, end, &remaining };
+        if (_jobsPush(&_jobs.deques[(self + c) % _jobs.threadCount], &job))
+        {
+            ++queued;
+        }
+        else
+        {
+            // deque is full, so just do it now
+            _jobsRun(&job);
+        }
+    }
+
+    // pending is only raised under the sleep lock, so a worker can't miss the wakeup
+    jobsLockAcquire(&_jobs.sleepLock);
+    jobsCounterAdd(&_jobs.pending, queued);
+    jobsLockRelease(&_jobs.sleepLock);
+    jobsConditionWakeAll(&_jobs.wake);
+
+    // help out until our chunks are done, including any a worker is still running
+    while (jobsCounterLoad(&remaining) > 0)
+    {
+        Job job;
+        if (_jobsFind(self, &job))
+        {
+            _jobsRun(&job);
+        }
+        else
+        {
+            jobsPause();
+        }
+    }
+}
+
+/// @brief Worker loop: run local work, steal when out, sleep when there's nothing anywhere
+/// @param param the deque index owned by this worker
+/// @return 
+static JOBS_THREAD_FUNC(_jobsWorkerMain)
+{
+    uint32_t self = (uint32_t)(uintptr_t)param;
+    _jobsThreadIndex = self;
+
+    while (!jobsCounterLoad(&_jobs.shutdown))
+    {
+        Job job;
+        if (_jobsFind(self, &job))
+        {
+            _jobsRun(&job);
+            continue;
+        }
+
+        jobsLockAcquire(&_jobs.sleepLock);
+        while (!jobsCounterLoad(&_jobs.shutdown) && jobsCounterLoad(&_jobs.pending) <= 0)
+        {
+            jobsConditionWait(&_jobs.wake, &_jobs.sleepLock);
+        }
+        jobsLockRelease(&_jobs.sleepLock);
+    }
+    return JOBS_THREAD_RETURN;
+}
+
+/// @brief Owner-side push
+/// @param deque 
+/// @param job 
+/// @return false if the deque is full
+static bool _jobsPush(JobDeque* deque, const Job* job)
+{
+    bool pushed = false;
+    jobsLockAcquire(&deque->lock);
+    if (deque->bottom - deque->top < JOBS_DEQUE_SIZE)
+    {
+        deque->jobs[deque->bottom & JOBS_DEQUE_MASK] = *job;
+        ++deque->bottom;
+        pushed = true;
+    }
+    jobsLockRelease(&deque->lock);
+    return pushed;
+}
+
+/// @brief Owner-side pop of the most recently pushed job
+/// @param deque 
+/// @param job 
+/// @return 
+static bool _jobsPop(JobDeque* deque, Job* job)
+{
+    bool popped = false;
+    jobsLockAcquire(&deque->lock);
+    if (deque->bottom != deque->top)
+    {
+        --deque->bottom;
+        *job = deque->jobs[deque->bottom & JOBS_DEQUE_MASK];
+        popped = true;
+    }
+    jobsLockRelease(&deque->lock);
+    return popped;
+}
+
+/// @brief Thief-side steal of the oldest job
+/// @param deque 
+/// @param job 
+/// @return 
+static bool _jobsSteal(JobDeque* deque, Job* job)
+{
+    bool stolen = false;
+    jobsLockAcquire(&deque->lock);
+    if (deque->bottom != deque->top)
+    {
+        *job = deque->jobs[deque->top & JOBS_DEQUE_MASK];
+        ++deque->top;
+        stolen = true;
+    }
+    jobsLockRelease(&deque->lock);
+    return stolen;
+}
+
+/// @brief Take a job from our own deque, or failing that, steal one from another thread
+/// @param self 
+/// @param job 
+/// @return 
+static bool _jobsFind(uint32_t self, Job* job)
+{
+    bool found = _jobsPop(&_jobs.deques[self], job);
+    for (uint32_t i = 1; !found && i < _jobs.threadCount; ++i)
+    {
+        found = _jobsSteal(&_jobs.deques[(self + i) % _jobs.threadCount], job);
+    }
+
+    if (found)
+    {
+        jobsCounterAdd(&_jobs.pending, -1);
+    }
+    return found;
+}
+
+/// @brief Run a job and mark its chunk finished
+/// @param job 
+static void _jobsRun(const Job* job)
+{
+    job->func(job->data, job->begin, job->end);
+    jobsCounterAdd(job->remaining, -1);
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include "baseTypes.h"
+
+// The threads, locks, atomics & thread-local storage the job system is built on: Win32 on
+// Windows, pthreads & C11 atomics everywhere else. jobs.c only talks to these
+
+#ifdef _WIN32
+
+#include <Windows.h>
+
+typedef HANDLE JobsThread;
+typedef SRWLOCK JobsLock;
+typedef CONDITION_VARIABLE JobsCondition;
+typedef volatile LONG JobsCounter;
+
+// thread entry points are declared as JOBS_THREAD_FUNC(name) & return JOBS_THREAD_RETURN
+#define JOBS_THREAD_FUNC(name) DWORD WINAPI name(LPVOID param)
+#define JOBS_THREAD_RETURN 0
+typedef LPTHREAD_START_ROUTINE JobsThreadFunc;
+
+#define JOBS_THREAD_LOCAL __declspec(thread)
+
+/// @brief Start a thread
+/// @param thread 
+/// @param func 
+/// @param param 
+/// @return false if the thread couldn't be created
+inline bool jobsThreadStart(JobsThread* thread, JobsThreadFunc func, void* param)
+{
+    *thread = CreateThread(NULL, 0, func, param, 0, NULL);
+    return *thread != NULL;
+}
+
+/// @brief Wait for a thread to exit & release it
+/// @param thread 
+inline void jobsThreadJoin(JobsThread thread)
+{
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+/// @brief Number of logical processors
+/// @return 
+inline uint32_t jobsGetCoreCount()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors;
+}
+
+inline void jobsLockInit(JobsLock* lock) { InitializeSRWLock(lock); }
+inline void jobsLockDestroy(JobsLock* lock) { (void)lock; }
+inline void jobsLockAcquire(JobsLock* lock) { AcquireSRWLockExclusive(lock); }
+inline void jobsLockRelease(JobsLock* lock) { ReleaseSRWLockExclusive(lock); }
+
+inline void jobsConditionInit(JobsCondition* condition) { InitializeConditionVariable(condition); }
+inline void jobsConditionDestroy(JobsCondition* condition) { (void)condition; }
+inline void jobsConditionWait(JobsCondition* condition, JobsLock* lock) { SleepConditionVariableSRW(condition, lock, INFINITE, 0); }
+inline void jobsConditionWakeAll(JobsCondition* condition) { WakeAllConditionVariable(condition); }
+
+inline void jobsCounterStore(JobsCounter* counter, int32_t value) { InterlockedExchange(counter, value); }
+inline int32_t jobsCounterLoad(JobsCounter* counter) { return InterlockedCompareExchange(counter, 0, 0); }
+inline int32_t jobsCounterAdd(JobsCounter* counter, int32_t value) { return InterlockedExchangeAdd(counter, value) + value; }
+
+// spin-wait hint, while waiting on another thread
+inline void jobsPause() { YieldProcessor(); }
+
+#else
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+typedef pthread_t JobsThread;
+typedef pthread_mutex_t JobsLock;
+typedef pthread_cond_t JobsCondition;
+typedef atomic_int JobsCounter;
+
+#define JOBS_THREAD_FUNC(name) void* name(void* param)
+#define JOBS_THREAD_RETURN NULL
+typedef void* (*JobsThreadFunc)(void*);
+
+#define JOBS_THREAD_LOCAL _Thread_local
+
+inline bool jobsThreadStart(JobsThread* thread, JobsThreadFunc func, void* param)
+{
+    return pthread_create(thread, NULL, func, param) == 0;
+}
+
+inline void jobsThreadJoin(JobsThread thread)
+{
+    pthread_join(thread, NULL);
+}
+
+inline uint32_t jobsGetCoreCount()
+{
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? (uint32_t)cores : 1;
+}
+
+inline void jobsLockInit(JobsLock* lock) { pthread_mutex_init(lock, NULL); }
+inline void jobsLockDestroy(JobsLock* lock) { pthread_mutex_destroy(lock); }
+inline void jobsLockAcquire(JobsLock* lock) { pthread_mutex_lock(lock); }
+inline void jobsLockRelease(JobsLock* lock) { pthread_mutex_unlock(lock); }
+
+inline void jobsConditionInit(JobsCondition* condition) { pthread_cond_init(condition, NULL); }
+inline void jobsConditionDestroy(JobsCondition* condition) { pthread_cond_destroy(condition); }
+inline void jobsConditionWait(JobsCondition* condition, JobsLock* lock) { pthread_cond_wait(condition, lock); }
+inline void jobsConditionWakeAll(JobsCondition* condition) { pthread_cond_broadcast(condition); }
+
+inline void jobsCounterStore(JobsCounter* counter, int32_t value) { atomic_store(counter, value); }
+inline int32_t jobsCounterLoad(JobsCounter* counter) { return atomic_load(counter); }
+inline int32_t jobsCounterAdd(JobsCounter* counter, int32_t value) { return atomic_fetch_add(counter, value) + value; }
+
+inline void jobsPause() { sched_yield(); }
+
+#endif
@@ -2,6 +2,7 @@
 #include <Windows.h>
 #include <gl/GL.h>
 #include <gl/GLU.h>
+#include "glstate.h"
 
 /// @brief Initialize the Open GL rendering system
 /// @param backRed 
@@ -12,16 +13,19 @@ inline void glDrawInit(float backRed, float backGreen, float backBlue)
 	glClearColor(backRed, backGreen, backBlue, 0.0f);			// Background Color
 	glClearDepth(1.0f);											// Depth Buffer Setup
 	glDepthFunc(GL_LESS);										// Type Of Depth Testing
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);			// Enable Alpha Blending
-	glEnable(GL_DEPTH_TEST);									// Enable Depth Testing
-	glEnable(GL_BLEND);											// Enable Blending
-	glEnable(GL_TEXTURE_2D);									// Enable Texture Mapping
-	glEnable(GL_CULL_FACE);										// Remove Back Face
+	glStateInvalidate();										// New Context, Nothing Shadowed Yet
+	glStateBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);		// Enable Alpha Blending
+	glStateEnable(GL_DEPTH_TEST);								// Enable Depth Testing
+	glStateEnable(GL_BLEND);									// Enable Blending
+	glStateEnable(GL_TEXTURE_2D);								// Enable Texture Mapping
+	glStateEnable(GL_CULL_FACE);								// Remove Back Face
 }
 
 /// @brief Begin drawing GL primitives for the current frame
 inline void glDrawStart()
 {
+	// Count GL state calls per frame
+	glStateBeginFrame();
 	// Clear the window
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	// Set the modelview matrix to be the identity matrix
@@ -0,0 +1,283 @@
+#include <Windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <malloc.h>
+#include <assert.h>
+#include "pool.h"
+
+/// @brief Header at the start of every chunk; elements follow on the next cache line
+typedef struct pool_chunk_t {
+    struct pool_chunk_t*    next;
+    uint8_t*                elements;
+    uint32_t                freeTally;  // scratch space for poolGetStats
+} PoolChunk;
+
+/// @brief Free elements are chained through their own storage
+typedef struct pool_free_node_t {
+    struct pool_free_node_t* next;
+} PoolFreeNode;
+
+struct pool_t {
+    const char*     name;
+    size_t          elementSize;
+    size_t          stride;
+    uint32_t        perChunk;
+
+    PoolChunk*      chunks;
+    PoolFreeNode*   freeList;
+
+    uint32_t        chunkCount;
+    uint32_t        used;
+    uint32_t        highWater;
+
+    Pool*           nextPool;   // registry of all live pools, for reporting
+};
+
+static Pool* _pools = NULL;
+static bool _poolPassthrough = false;
+
+static bool _poolGrow(Pool* pool);
+static PoolChunk* _poolFindChunk(const Pool* pool, const void* element);
+
+/// @brief Create a pool of fixed-size elements that grows a chunk at a time
+/// @param name used when reporting stats
+/// @param elementSize 
+/// @param elementsPerChunk 
+/// @return 
+Pool* poolNew(const char* name, size_t elementSize, uint32_t elementsPerChunk)
+{
+    assert(elementsPerChunk > 0);
+
+    Pool* pool = malloc(sizeof(Pool));
+    if (pool != NULL)
+    {
+        ZeroMemory(pool, sizeof(Pool));
+        pool->name = name;
+        pool->elementSize = elementSize;
+        pool->perChunk = elementsPerChunk;
+
+        // free elements must be able to hold the free list link
+        size_t size = elementSize < sizeof(PoolFreeNode) ? sizeof(PoolFreeNode) : elementSize;
+        pool->stride = (size + POOL_CACHE_LINE - 1) & ~(size_t)(POOL_CACHE_LINE - 1);
+
+        pool->nextPool = _pools;
+        _pools = pool;
+    }
+    return pool;
+}
+
+/// @brief Release every chunk. Any elements still allocated become invalid
+/// @param pool 
+void poolDelete(Pool* pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+
+    // unlink from the registry
+    Pool** link = &_pools;
+    while (*link != NULL && *link != pool)
+    {
+        link = &(*link)->nextPool;
+    }
+    if (*link != NULL)
+    {
+        *link = pool->nextPool;
+    }
+
+    PoolChunk* chunk = pool->chunks;
+    while (chunk != NULL)
+    {
+        PoolChunk* next = chunk->next;
+        _aligned_free(chunk);
+        chunk = next;
+    }
+    free(pool);
+}
+
+/// @brief Take an element from the pool, growing it if there are none free
+/// @param pool 
+/// @return NULL if a new chunk could not be allocated
+void* poolAlloc(Pool* pool)
+{
+    void* element;
+    if (_poolPassthrough)
+    {
+        element = malloc(pool->elementSize);
+        if (element == NULL)
+        {
+            return NULL;
+        }
+    }
+    else
+    {
+        if (pool->freeList == NULL && !_poolGrow(pool))
+        {
+            return NULL;
+        }
+
+        PoolFreeNode* node = pool->freeList;
+        pool->freeList = node->next;
+        element = node;
+    }
+
+    ++pool->used;
+    if (pool->used > pool->highWater)
+    {
+        pool->highWater = pool->used;
+    }
+    return element;
+}
+
+/// @brief Return an element to the pool
+/// @param pool 
+/// @param element 
+void poolFree(Pool* pool, void* element)
+{
+    if (element == NULL)
+    {
+        return;
+    }
+
+    if (_poolPassthrough)
+    {
+        assert(pool->used > 0);
+        free(element);
+        --pool->used;
+        return;
+    }
+
+#ifdef _DEBUG
+    // freeing an element that didn't come from this pool!
+    assert(_poolFindChunk(pool, element) != NULL);
+#endif
+    assert(pool->used > 0);
+
+    PoolFreeNode* node = element;
+    node->next = pool->freeList;
+    pool->freeList = node;
+    --pool->used;
+}
+
+/// @brief Gather occupancy & fragmentation numbers. Walks the free list, so intended
+/// for reporting rather than per-frame use
+/// @param pool 
+/// @param stats 
+void poolGetStats(Pool* pool, PoolStats* stats)
+{
+    ZeroMemory(stats, sizeof(PoolStats));
+    stats->name = pool->name;
+    stats->elementSize = (uint32_t)pool->stride;
+    stats->chunkCount = pool->chunkCount;
+    stats->capacity = pool->chunkCount * pool->perChunk;
+    stats->used = pool->used;
+    stats->highWater = pool->highWater;
+
+    // attribute every free element to its chunk
+    for (PoolChunk* chunk = pool->chunks; chunk != NULL; chunk = chunk->next)
+    {
+        chunk->freeTally = 0;
+    }
+    for (PoolFreeNode* node = pool->freeList; node != NULL; node = node->next)
+    {
+        PoolChunk* chunk = _poolFindChunk(pool, node);
+        if (chunk != NULL)
+        {
+            ++chunk->freeTally;
+        }
+    }
+
+    // free slots in a fully free chunk could be released; those in a partially used one can't
+    uint32_t stranded = 0;
+    for (PoolChunk* chunk = pool->chunks; chunk != NULL; chunk = chunk->next)
+    {
+        if (chunk->freeTally == pool->perChunk)
+        {
+            ++stats->emptyChunks;
+        }
+        else
+        {
+            stranded += chunk->freeTally;
+        }
+    }
+
+    if (stats->capacity > 0)
+    {
+        stats->occupancy = (float)stats->used / (float)stats->capacity;
+        stats->fragmentation = (float)stranded / (float)stats->capacity;
+    }
+}
+
+/// @brief Print stats for every live pool to the console
+void poolLogAllStats()
+{
+    for (Pool* pool = _pools; pool != NULL; pool = pool->nextPool)
+    {
+        PoolStats stats;
+        poolGetStats(pool, &stats);
+        printf("pool %-12s %4u B x %6u/%6u used (peak %6u), %3u chunks (%u empty), occupancy %5.1f%%, fragmentation %5.1f%%\n",
+            stats.name, stats.elementSize, stats.used, stats.capacity, stats.highWater,
+            stats.chunkCount, stats.emptyChunks, stats.occupancy * 100.0f, stats.fragmentation * 100.0f);
+    }
+}
+
+/// @brief Switch every pool between its chunks & plain malloc/free. Elements can't move
+/// between the two, so no pool may have any in use
+/// @param passthrough 
+void poolSetPassthrough(bool passthrough)
+{
+#ifdef _DEBUG
+    for (Pool* pool = _pools; pool != NULL; pool = pool->nextPool)
+    {
+        // switching with live elements; they'd be freed by the wrong allocator!
+        assert(pool->used == 0);
+    }
+#endif
+    _poolPassthrough = passthrough;
+}
+
+/// @brief Add a chunk and thread its elements onto the free list
+/// @param pool 
+/// @return 
+static bool _poolGrow(Pool* pool)
+{
+    size_t headerSize = (sizeof(PoolChunk) + POOL_CACHE_LINE - 1) & ~(size_t)(POOL_CACHE_LINE - 1);
+    PoolChunk* chunk = _aligned_malloc(headerSize + pool->stride * pool->perChunk, POOL_CACHE_LINE);
+    if (chunk == NULL)
+    {
+        return false;
+    }
+
+    chunk->elements = (uint8_t*)chunk + headerSize;
+    chunk->freeTally = 0;
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+    ++pool->chunkCount;
+
+    // push in reverse, so allocations walk forward through memory
+    for (uint32_t i = pool->perChunk; i > 0; --i)
+    {
+        PoolFreeNode* node = (PoolFreeNode*)(chunk->elements + (i - 1) * pool->stride);
+        node->next = pool->freeList;
+        pool->freeList = node;
+    }
+    return true;
+}
+
+/// @brief Find the chunk that owns an element
+/// @param pool 
+/// @param element 
+/// @return NULL if the element isn't from this pool
+static PoolChunk* _poolFindChunk(const Pool* pool, const void* element)
+{
+    const uint8_t* address = element;
+    for (PoolChunk* chunk = pool->chunks; chunk != NULL; chunk = chunk->next)
+    {
+        if (address >= chunk->elements && address < chunk->elements + pool->stride * pool->perChunk)
+        {
+            return chunk;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "baseTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// fail the current test if cond is false; the test keeps running, so one run reports every mismatch
+#define TEST_CHECK(cond) testCheck((cond), #cond, __FILE__, __LINE__)
+
+typedef void (*TestFunc)();
+
+void testRun(const char* name, TestFunc func);
+void testCheck(bool passed, const char* expr, const char* file, int line);
+double testGetSeconds();
+uint32_t testGetBenchThreads();
+
+// a headless level: the object manager & balls bouncing around a field, for simulation tests
+// & benches. Fixed steps are TEST_WORLD_STEP_MS long
+#define TEST_WORLD_STEP_MS 33
+void testWorldInit(uint32_t maxObjects);
+void testWorldShutdown();
+void testWorldSpawnBalls(Bounds2D field, uint32_t count);
+void testWorldSpawnBallsAt(Bounds2D field, const Coord2D* positions, uint32_t count);
+void testWorldStep(uint32_t steps);
+
+// suites, one per file; each runs its tests through testRun
+void objMgrTests();
+void determinismTests();
+void spriteBatchTests();
+void transformTests();
+void particleTests();
+void sceneTests();
+void ballTests();
+void renderSoftTests();
+
+// benches, run with the "bench" argument; each prints its own table
+void jobsBenches();
+void transformBenches();
+void objMgrBenches();
+void spatialGridBenches();
+void sceneBenches();
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,251 @@
+#include <stdio.h>
+#include "baseTypes.h"
+#include "jobs.h"
+#include "transform.h"
+#include "random.h"
+#include "objmgr.h"
+#include "particles.h"
+#include "testing.h"
+
+#define BENCH_BALLS 100000
+#define BENCH_WARMUP_STEPS 5
+#define BENCH_STEPS 20
+#define BENCH_INTEGRATE_PASSES 200
+// transforms per job, as the object manager splits them
+#define BENCH_INTEGRATE_GRAIN 4096
+// emitters are flagged thread-safe, so the object manager spreads their updates across threads
+#define BENCH_EMITTERS 16
+#define BENCH_EMITTER_PARTICLES 32768
+#define BENCH_EMITTER_FRAMES 50
+#define BENCH_EMITTER_FRAME_MS 16
+// powers of two below any 32 bit thread count, plus the count itself
+#define BENCH_MAX_THREAD_STEPS 33
+
+typedef struct bench_integrate_t {
+    TransformStore* store;
+    float seconds;
+} BenchIntegrate;
+
+static void _benchBallScaling();
+static double _benchBallSteps(uint32_t threads);
+static double _benchIntegrate(uint32_t threads);
+static void _benchIntegrateRange(void* data, uint32_t begin, uint32_t end);
+static void _benchEmitterScaling();
+static double _benchEmitterFrames(uint32_t threads);
+static uint32_t _benchGetMaxThreads();
+static uint32_t _benchGetThreadSteps(uint32_t* steps);
+
+/// @brief Job system benches
+void jobsBenches()
+{
+    _benchBallScaling();
+    _benchEmitterScaling();
+}
+
+/// @brief 100k bouncing balls with 1 to N threads: whole fixed steps, then just the
+/// integration the object manager spreads across them. Balls aren't thread-safe: their
+/// collisions move proxies in the shared broadphase & push events in order, which lockstep
+/// depends on, so they run on the calling thread. Whole steps therefore don't scale yet;
+/// only the integrate column does
+static void _benchBallScaling()
+{
+    uint32_t steps[BENCH_MAX_THREAD_STEPS];
+    uint32_t stepCount = _benchGetThreadSteps(steps);
+
+    printf("jobs: %u bouncing balls, ms per fixed step\n", BENCH_BALLS);
+    printf("(ball collisions run serially, so only integration is expected to scale)\n");
+    printf("%8s %12s %8s %14s %8s\n", "threads", "step", "speedup", "integrate", "speedup");
+
+    double stepBase = 0.0;
+    double integrateBase = 0.0;
+    for (uint32_t i = 0; i < stepCount; ++i)
+    {
+        uint32_t threads = steps[i];
+        double step = _benchBallSteps(threads);
+        double integrate = _benchIntegrate(threads);
+        if (threads == 1)
+        {
+            stepBase = step;
+            integrateBase = integrate;
+        }
+        printf("%8u %12.3f %7.2fx %14.4f %7.2fx\n", threads, step, stepBase / step, integrate, integrateBase / integrate);
+    }
+}
+
+/// @brief Particle emitters updated through the object manager with 1 to N threads
+static void _benchEmitterScaling()
+{
+    uint32_t steps[BENCH_MAX_THREAD_STEPS];
+    uint32_t stepCount = _benchGetThreadSteps(steps);
+
+    printf("jobs: %u emitters x %u particles, ms per update\n", BENCH_EMITTERS, BENCH_EMITTER_PARTICLES);
+    printf("%8s %12s %8s\n", "threads", "update", "speedup");
+
+    double base = 0.0;
+    for (uint32_t i = 0; i < stepCount; ++i)
+    {
+        uint32_t threads = steps[i];
+        double update = _benchEmitterFrames(threads);
+        if (threads == 1)
+        {
+            base = update;
+        }
+        printf("%8u %12.3f %7.2fx\n", threads, update, base / update);
+    }
+}
+
+/// @brief Time variable updates of full emitters. Particles live long enough that none die
+/// during the run, so every frame does the same work
+/// @param threads including the caller
+/// @return milliseconds per update
+static double _benchEmitterFrames(uint32_t threads)
+{
+    ParticleBurst burst = { BENCH_EMITTER_PARTICLES, 3.14159265f, 10.0f, 100.0f, 100.0f, 200.0f, 2.0f, 4.0f, 0xFFFFFF };
+    Coord2D gravity = { 0.0f, -50.0f };
+    Coord2D point = { 500.0f, 500.0f };
+    Coord2D normal = { 0.0f, 1.0f };
+    ParticleEmitter* emitters[BENCH_EMITTERS];
+
+    if (threads > 1)
+    {
+        jobsInit(threads - 1);
+    }
+    objMgrInit(BENCH_EMITTERS, false);
+    for (uint32_t i = 0; i < BENCH_EMITTERS; ++i)
+    {
+        emitters[i] = particleEmitterNew(BENCH_EMITTER_PARTICLES, 0, gravity, 0.1f);
+        if (emitters[i] != NULL)
+        {
+            particleEmitterBurst(emitters[i], &burst, point, normal);
+        }
+    }
+
+    double start = testGetSeconds();
+    for (uint32_t frame = 0; frame < BENCH_EMITTER_FRAMES; ++frame)
+    {
+        objMgrUpdate(BENCH_EMITTER_FRAME_MS);
+    }
+    double elapsed = testGetSeconds() - start;
+
+    for (uint32_t i = 0; i < BENCH_EMITTERS; ++i)
+    {
+        if (emitters[i] != NULL)
+        {
+            particleEmitterDelete(emitters[i]);
+        }
+    }
+    objMgrShutdown();
+    if (threads > 1)
+    {
+        jobsShutdown();
+    }
+    return elapsed * 1000.0 / BENCH_EMITTER_FRAMES;
+}
+
+/// @brief Time fixed steps of a crowded field of balls
+/// @param threads including the caller
+/// @return milliseconds per step
+static double _benchBallSteps(uint32_t threads)
+{
+    Bounds2D field = { { 0.0f, 0.0f }, { 30000.0f, 30000.0f } };
+
+    if (threads > 1)
+    {
+        jobsInit(threads - 1);
+    }
+    testWorldInit(BENCH_BALLS);
+    randSeed(1);
+    testWorldSpawnBalls(field, BENCH_BALLS);
+    testWorldStep(BENCH_WARMUP_STEPS);
+
+    double start = testGetSeconds();
+    testWorldStep(BENCH_STEPS);
+    double elapsed = testGetSeconds() - start;
+
+    testWorldShutdown();
+    if (threads > 1)
+    {
+        jobsShutdown();
+    }
+    return elapsed * 1000.0 / BENCH_STEPS;
+}
+
+/// @brief Time the transform integration alone, split the way the object manager splits it
+/// @param threads including the caller
+/// @return milliseconds per pass
+static double _benchIntegrate(uint32_t threads)
+{
+    TransformStore* store = transformStoreNew(BENCH_BALLS);
+    if (store == NULL)
+    {
+        return 0.0;
+    }
+    for (uint32_t i = 0; i < BENCH_BALLS; ++i)
+    {
+        RealCoord2D pos = { randGetReal(0.0f, 1000.0f), randGetReal(0.0f, 1000.0f) };
+        RealCoord2D vel = { randGetReal(-150.0f, 150.0f), randGetReal(-150.0f, 150.0f) };
+        RealCoord2D accel = { 0, 0 };
+        transformStoreSet(store, i, pos, vel, accel);
+    }
+
+    if (threads > 1)
+    {
+        jobsInit(threads - 1);
+    }
+    BenchIntegrate args = { store, TEST_WORLD_STEP_MS / 1000.0f };
+    double start = testGetSeconds();
+    for (uint32_t pass = 0; pass < BENCH_INTEGRATE_PASSES; ++pass)
+    {
+        jobsParallelFor(BENCH_BALLS, BENCH_INTEGRATE_GRAIN, _benchIntegrateRange, &args);
+    }
+    double elapsed = testGetSeconds() - start;
+    if (threads > 1)
+    {
+        jobsShutdown();
+    }
+
+    transformStoreDelete(store);
+    return elapsed * 1000.0 / BENCH_INTEGRATE_PASSES;
+}
+
+/// @brief Job body for the integration bench
+/// @param data 
+/// @param begin 
+/// @param end 
+static void _benchIntegrateRange(void* data, uint32_t begin, uint32_t end)
+{
+    BenchIntegrate* args = data;
+    transformIntegrateRange(args->store, begin, end, args->seconds);
+}
+
+/// @brief One thread per core, as jobsInit picks by default, unless the command line asked
+/// for more or fewer
+/// @return 
+static uint32_t _benchGetMaxThreads()
+{
+    if (testGetBenchThreads() != 0)
+    {
+        return testGetBenchThreads();
+    }
+
+    jobsInit(0);
+    uint32_t threads = jobsGetThreadCount();
+    jobsShutdown();
+    return threads;
+}
+
+/// @brief The thread counts to bench: powers of two below the maximum, then the maximum
+/// itself, so odd core counts are covered too
+/// @param steps filled in, BENCH_MAX_THREAD_STEPS long
+/// @return how many counts were filled in
+static uint32_t _benchGetThreadSteps(uint32_t* steps)
+{
+    uint32_t maxThreads = _benchGetMaxThreads();
+    uint32_t count = 0;
+    for (uint32_t threads = 1; threads < maxThreads && threads != 0; threads *= 2)
+    {
+        steps[count++] = threads;
+    }
+    steps[count++] = maxThreads;
+    return count;
+}
@@ -0,0 +1,222 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "baseTypes.h"
+#include "objmgr.h"
+#include "ball.h"
+#include "field.h"
+#include "pool.h"
+#include "random.h"
+#include "testing.h"
+
+#define BENCH_SPAWN_COUNT 100000
+#define BENCH_SPAWN_ROUNDS 10
+// load & unload cycles per level size
+#define BENCH_LEVEL_CYCLES 50
+
+static ObjVtable _benchObjVtable = {
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    0,
+    OBJ_LAYER_DEFAULT
+};
+
+static void _benchShuffle(uint32_t* order, uint32_t count);
+static void _benchSpawnObjects(double* spawn, double* despawn);
+static void _benchSpawnBalls(double* spawn, double* despawn);
+static void _benchLevelCycles(uint32_t ballCount, bool passthrough, double* load, double* unload);
+
+/// @brief Spawn 100k objects, then despawn them all in random order, a few rounds over:
+/// bare objects for the manager alone, then balls, which also go through the pool & the
+/// bounds tree. Then load & unload levels of a few sizes, from the pools & from malloc
+void objMgrBenches()
+{
+    double spawn, despawn;
+    printf("objmgr: %u spawns then despawns, ns per object\n", BENCH_SPAWN_COUNT);
+    printf("%8s %12s %12s\n", "", "spawn", "despawn");
+
+    _benchSpawnObjects(&spawn, &despawn);
+    printf("%8s %12.2f %12.2f\n", "objects", spawn, despawn);
+    _benchSpawnBalls(&spawn, &despawn);
+    printf("%8s %12.2f %12.2f\n", "balls", spawn, despawn);
+
+    // the game's level has 20 balls; bigger ones show how each allocator scales
+    const uint32_t levelSizes[] = { 20, 1000, 10000 };
+    printf("objmgr: %u level load & unload cycles, us per cycle\n", BENCH_LEVEL_CYCLES);
+    printf("%8s %12s %12s %12s %12s\n", "balls", "pool load", "pool unload", "malloc load", "malloc unload");
+    for (uint32_t i = 0; i < sizeof(levelSizes) / sizeof(levelSizes[0]); ++i)
+    {
+        double poolLoad, poolUnload, mallocLoad, mallocUnload;
+        _benchLevelCycles(levelSizes[i], false, &poolLoad, &poolUnload);
+        _benchLevelCycles(levelSizes[i], true, &mallocLoad, &mallocUnload);
+        printf("%8u %12.2f %12.2f %12.2f %12.2f\n", levelSizes[i], poolLoad, poolUnload, mallocLoad, mallocUnload);
+    }
+}
+
+/// @brief Objects with no bounds or callbacks, registered & unregistered through objInit &
+/// objDeinit as every game object is
+/// @param spawn nanoseconds per spawn
+/// @param despawn nanoseconds per despawn
+static void _benchSpawnObjects(double* spawn, double* despawn)
+{
+    Object* objs = malloc(BENCH_SPAWN_COUNT * sizeof(Object));
+    uint32_t* order = malloc(BENCH_SPAWN_COUNT * sizeof(uint32_t));
+    *spawn = *despawn = 0.0;
+    if (objs == NULL || order == NULL)
+    {
+        free(objs);
+        free(order);
+        return;
+    }
+
+    objMgrInit(BENCH_SPAWN_COUNT, true);
+    randSeed(1);
+    Coord2D pos = { 0.0f, 0.0f };
+    Coord2D vel = { 0.0f, 0.0f };
+    for (uint32_t round = 0; round < BENCH_SPAWN_ROUNDS; ++round)
+    {
+        double start = testGetSeconds();
+        for (uint32_t i = 0; i < BENCH_SPAWN_COUNT; ++i)
+        {
+            objInit(&objs[i], &_benchObjVtable, pos, vel);
+        }
+        *spawn += testGetSeconds() - start;
+
+        _benchShuffle(order, BENCH_SPAWN_COUNT);
+        start = testGetSeconds();
+        for (uint32_t i = 0; i < BENCH_SPAWN_COUNT; ++i)
+        {
+            objDeinit(&objs[order[i]]);
+        }
+        *despawn += testGetSeconds() - start;
+    }
+    objMgrShutdown();
+
+    free(objs);
+    free(order);
+    *spawn *= 1e9 / ((double)BENCH_SPAWN_ROUNDS * BENCH_SPAWN_COUNT);
+    *despawn *= 1e9 / ((double)BENCH_SPAWN_ROUNDS * BENCH_SPAWN_COUNT);
+}
+
+/// @brief Balls scattered over a field, as levels spawn them
+/// @param spawn nanoseconds per spawn
+/// @param despawn nanoseconds per despawn
+static void _benchSpawnBalls(double* spawn, double* despawn)
+{
+    Bounds2D field = { { 0.0f, 0.0f }, { 30000.0f, 30000.0f } };
+    Ball** balls = malloc(BENCH_SPAWN_COUNT * sizeof(Ball*));
+    uint32_t* order = malloc(BENCH_SPAWN_COUNT * sizeof(uint32_t));
+    *spawn = *despawn = 0.0;
+    if (balls == NULL || order == NULL)
+    {
+        free(balls);
+        free(order);
+        return;
+    }
+
+    objMgrInit(BENCH_SPAWN_COUNT, true);
+    ballInitPool();
+    randSeed(1);
+    for (uint32_t round = 0; round < BENCH_SPAWN_ROUNDS; ++round)
+    {
+        double start = testGetSeconds();
+        for (uint32_t i = 0; i < BENCH_SPAWN_COUNT; ++i)
+        {
+            Coord2D pos = { randGetFloat(0.0f, 30000.0f), randGetFloat(0.0f, 30000.0f) };
+            balls[i] = ballNewAt(field, pos);
+        }
+        *spawn += testGetSeconds() - start;
+
+        _benchShuffle(order, BENCH_SPAWN_COUNT);
+        start = testGetSeconds();
+        for (uint32_t i = 0; i < BENCH_SPAWN_COUNT; ++i)
+        {
+            ballDelete(balls[order[i]]);
+        }
+        *despawn += testGetSeconds() - start;
+    }
+    ballShutdownPool();
+    objMgrShutdown();
+
+    free(balls);
+    free(order);
+    *spawn *= 1e9 / ((double)BENCH_SPAWN_ROUNDS * BENCH_SPAWN_COUNT);
+    *despawn *= 1e9 / ((double)BENCH_SPAWN_ROUNDS * BENCH_SPAWN_COUNT);
+}
+
+/// @brief Load a level's objects (a field & its balls, scattered so the broadphases don't
+/// pile them into one cell) & unload them again, the way levelMgrLoad & levelMgrUnload do,
+/// with the per-type pools or with every pool passed through to plain malloc & free. The
+/// rest of a level (the player's JSON & textures, the particle emitters) costs the same
+/// either way, so it is left out
+/// @param ballCount 
+/// @param passthrough allocate with malloc & free instead of the pools
+/// @param load microseconds per load
+/// @param unload microseconds per unload
+static void _benchLevelCycles(uint32_t ballCount, bool passthrough, double* load, double* unload)
+{
+    Bounds2D bounds = { { 0.0f, 0.0f }, { 30000.0f, 30000.0f } };
+    Ball** balls = malloc(ballCount * sizeof(Ball*));
+    *load = *unload = 0.0;
+    if (balls == NULL)
+    {
+        return;
+    }
+
+    objMgrInit(ballCount + 1, true);
+    poolSetPassthrough(passthrough);
+    fieldInitPool();
+    ballInitPool();
+    randSeed(1);
+    for (uint32_t cycle = 0; cycle < BENCH_LEVEL_CYCLES; ++cycle)
+    {
+        double start = testGetSeconds();
+        Field* field = fieldNew(bounds, 0x00ff0000);
+        for (uint32_t i = 0; i < ballCount; ++i)
+        {
+            Coord2D pos = { randGetFloat(0.0f, 30000.0f), randGetFloat(0.0f, 30000.0f) };
+            balls[i] = ballNewAt(bounds, pos);
+        }
+        *load += testGetSeconds() - start;
+
+        start = testGetSeconds();
+        for (uint32_t i = 0; i < ballCount; ++i)
+        {
+            ballDelete(balls[i]);
+        }
+        fieldDelete(field);
+        *unload += testGetSeconds() - start;
+    }
+    ballShutdownPool();
+    fieldShutdownPool();
+    poolSetPassthrough(false);
+    objMgrShutdown();
+
+    free(balls);
+    *load *= 1e6 / BENCH_LEVEL_CYCLES;
+    *unload *= 1e6 / BENCH_LEVEL_CYCLES;
+}
+
+/// @brief Fill order with a random permutation of [0, count)
+/// @param order 
+/// @param count 
+static void _benchShuffle(uint32_t* order, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        order[i] = i;
+    }
+    for (uint32_t i = count - 1; i > 0; --i)
+    {
+        uint32_t j = (uint32_t)randGetInt(0, (int32_t)i + 1);
+        uint32_t swap = order[i];
+        order[i] = order[j];
+        order[j] = swap;
+    }
+}
@@ -0,0 +1,90 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "baseTypes.h"
+#include "scene.h"
+#include "random.h"
+#include "testing.h"
+
+#define BENCH_SCENE_BALLS 10000
+#define BENCH_SCENE_QUERIES 1000000
+#define BENCH_SCENE_FIELD 10000.0f
+// a short nearest-hit ray, as a shot or line of sight check; then a long one collecting
+// everything it passes through
+#define BENCH_SCENE_SHORT_RAY 200.0f
+#define BENCH_SCENE_LONG_RAY 1000.0f
+#define BENCH_SCENE_MAX_HITS 8
+
+static double _benchSceneRays(const Coord2D* points, const Coord2D* directions, float length, uint32_t maxHits);
+static double _benchScenePoints(const Coord2D* points);
+
+/// @brief A million raycasts, then a million point queries, against 10k balls tracked by
+/// the object manager's bounds tree
+void sceneBenches()
+{
+    Bounds2D field = { { 0.0f, 0.0f }, { BENCH_SCENE_FIELD, BENCH_SCENE_FIELD } };
+    Coord2D* points = malloc(BENCH_SCENE_QUERIES * sizeof(Coord2D));
+    Coord2D* directions = malloc(BENCH_SCENE_QUERIES * sizeof(Coord2D));
+    if (points == NULL || directions == NULL)
+    {
+        free(points);
+        free(directions);
+        return;
+    }
+
+    testWorldInit(BENCH_SCENE_BALLS);
+    randSeed(1);
+    testWorldSpawnBalls(field, BENCH_SCENE_BALLS);
+    // the fixed step leaves the tree as the game queries it, with balls off their spawn points
+    testWorldStep(2);
+
+    for (uint32_t i = 0; i < BENCH_SCENE_QUERIES; ++i)
+    {
+        points[i].x = randGetFloat(0.0f, BENCH_SCENE_FIELD);
+        points[i].y = randGetFloat(0.0f, BENCH_SCENE_FIELD);
+        directions[i].x = randGetFloat(-1.0f, 1.0f);
+        directions[i].y = randGetFloat(-1.0f, 1.0f);
+    }
+
+    double nearest = _benchSceneRays(points, directions, BENCH_SCENE_SHORT_RAY, 1);
+    double every = _benchSceneRays(points, directions, BENCH_SCENE_LONG_RAY, BENCH_SCENE_MAX_HITS);
+    double picks = _benchScenePoints(points);
+    printf("scene: %u balls, queries per second\n", BENCH_SCENE_BALLS);
+    printf("%24s %12.0f\n", "nearest hit, short ray", BENCH_SCENE_QUERIES / nearest);
+    printf("%24s %12.0f\n", "8 hits, long ray", BENCH_SCENE_QUERIES / every);
+    printf("%24s %12.0f\n", "point", BENCH_SCENE_QUERIES / picks);
+
+    testWorldShutdown();
+    free(points);
+    free(directions);
+}
+
+/// @brief Random rays from random points
+/// @param points origins
+/// @param directions 
+/// @param length 
+/// @param maxHits 
+/// @return seconds taken
+static double _benchSceneRays(const Coord2D* points, const Coord2D* directions, float length, uint32_t maxHits)
+{
+    SceneHit hits[BENCH_SCENE_MAX_HITS];
+    double start = testGetSeconds();
+    for (uint32_t i = 0; i < BENCH_SCENE_QUERIES; ++i)
+    {
+        sceneRaycast(points[i], directions[i], length, OBJ_LAYER_MASK_ALL, hits, maxHits);
+    }
+    return testGetSeconds() - start;
+}
+
+/// @brief Random points, as mouse picking would
+/// @param points 
+/// @return seconds taken
+static double _benchScenePoints(const Coord2D* points)
+{
+    SceneHit hits[BENCH_SCENE_MAX_HITS];
+    double start = testGetSeconds();
+    for (uint32_t i = 0; i < BENCH_SCENE_QUERIES; ++i)
+    {
+        scenePointQuery(points[i], OBJ_LAYER_MASK_ALL, hits, BENCH_SCENE_MAX_HITS);
+    }
+    return testGetSeconds() - start;
+}
@@ -0,0 +1,247 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "baseTypes.h"
+#include "broadphase.h"
+#include "spatialgrid.h"
+#include "sweepprune.h"
+#include "ball.h"
+#include "random.h"
+#include "testing.h"
+
+#define BENCH_GRID_BOXES 50000
+#define BENCH_GRID_REBUILDS 20
+// ball radii, as levels spawn them
+#define BENCH_GRID_MIN_RADIUS 10.0f
+#define BENCH_GRID_MAX_RADIUS 50.0f
+// how far each box wanders between rebuilds; a fixed step of a fast ball
+#define BENCH_GRID_JITTER 5.0f
+// the ball step's grid cell; the diameter of the largest ball
+#define BENCH_GRID_BALL_CELL 100.0f
+
+// creates the broadphase under test; param is the grid's cell size, unused by sweep & prune
+typedef Broadphase* (*BenchBroadphaseNew)(float param);
+
+// square fields the boxes are scattered over, densest first
+static const float _benchGridFields[] = { 10000.0f, 20000.0f, 40000.0f };
+static const float _benchGridCells[] = { 37.0f, 50.0f, 100.0f, 200.0f, 400.0f };
+// boxes removed & added again elsewhere on each rebuild, as balls are despawned & spawned
+static const uint32_t _benchGridChurnCounts[] = { 0, 5, 25 };
+
+static Broadphase* _benchGridNew(float cellSize);
+static Broadphase* _benchSweepPruneNew(float unused);
+static double _benchGridRebuilds(BenchBroadphaseNew newFunc, float param, float fieldSize, uint32_t churn, uint32_t* pairs);
+static void _benchGridChurn();
+static void _benchGridBallSteps();
+static void _benchGridScatter(Bounds2D* box, float fieldSize);
+static int _benchGridCompareX(const void* a, const void* b);
+static int _benchGridComparePosX(const void* a, const void* b);
+
+/// @brief Sweep the uniform grid's cell size against ball density, with sweep & prune on the
+/// same scenes, then the cost of spawn & despawn churn, then time whole fixed steps of 50k
+/// balls through each against the 30 Hz budget
+void spatialGridBenches()
+{
+    printf("spatialgrid: %u boxes, ms per move & find pairs (pairs found)\n", BENCH_GRID_BOXES);
+    printf("%8s", "field");
+    for (uint32_t c = 0; c < sizeof(_benchGridCells) / sizeof(_benchGridCells[0]); ++c)
+    {
+        printf(" %10.0f cell", _benchGridCells[c]);
+    }
+    printf(" %15s\n", "sweep & prune");
+
+    for (uint32_t f = 0; f < sizeof(_benchGridFields) / sizeof(_benchGridFields[0]); ++f)
+    {
+        uint32_t pairs = 0;
+        printf("%8.0f", _benchGridFields[f]);
+        for (uint32_t c = 0; c < sizeof(_benchGridCells) / sizeof(_benchGridCells[0]); ++c)
+        {
+            printf(" %15.3f", _benchGridRebuilds(_benchGridNew, _benchGridCells[c], _benchGridFields[f], 0, &pairs));
+        }
+        printf(" %15.3f", _benchGridRebuilds(_benchSweepPruneNew, 0.0f, _benchGridFields[f], 0, &pairs));
+        printf("  (%u)\n", pairs);
+    }
+
+    _benchGridChurn();
+    _benchGridBallSteps();
+}
+
+/// @brief A uniform grid, as a bench factory
+/// @param cellSize 
+/// @return 
+static Broadphase* _benchGridNew(float cellSize)
+{
+    return spatialGridNew(cellSize);
+}
+
+/// @brief Sweep & prune, as a bench factory
+/// @param unused 
+/// @return 
+static Broadphase* _benchSweepPruneNew(float unused)
+{
+    return sweepPruneNew();
+}
+
+/// @brief Scatter boxes over a field, then repeatedly nudge every one, swap some out for
+/// new ones & find the pairs, as the ball step does
+/// @param newFunc 
+/// @param param passed to newFunc
+/// @param fieldSize 
+/// @param churn boxes removed & added again at a new spot per rebuild
+/// @param pairs pairs found by the last rebuild
+/// @return milliseconds per rebuild
+static double _benchGridRebuilds(BenchBroadphaseNew newFunc, float param, float fieldSize, uint32_t churn, uint32_t* pairs)
+{
+    Broadphase* broadphase = newFunc(param);
+    Bounds2D* boxes = malloc(BENCH_GRID_BOXES * sizeof(Bounds2D));
+    uint32_t* proxies = malloc(BENCH_GRID_BOXES * sizeof(uint32_t));
+    if (broadphase == NULL || boxes == NULL || proxies == NULL)
+    {
+        broadphaseDelete(broadphase);
+        free(boxes);
+        free(proxies);
+        return 0.0;
+    }
+
+    // added left to right, so sweep & prune's first sort only has neighbours to swap; the
+    // grid doesn't care about the order
+    randSeed(1);
+    for (uint32_t i = 0; i < BENCH_GRID_BOXES; ++i)
+    {
+        _benchGridScatter(&boxes[i], fieldSize);
+    }
+    qsort(boxes, BENCH_GRID_BOXES, sizeof(Bounds2D), _benchGridCompareX);
+    for (uint32_t i = 0; i < BENCH_GRID_BOXES; ++i)
+    {
+        proxies[i] = broadphaseAdd(broadphase, &boxes[i], NULL);
+    }
+    const CollisionPair* found;
+    broadphaseFindPairs(broadphase, &found);
+
+    double start = testGetSeconds();
+    for (uint32_t rebuild = 0; rebuild < BENCH_GRID_REBUILDS; ++rebuild)
+    {
+        for (uint32_t i = 0; i < churn; ++i)
+        {
+            uint32_t victim = (uint32_t)randGetInt(0, BENCH_GRID_BOXES);
+            broadphaseRemove(broadphase, proxies[victim]);
+            _benchGridScatter(&boxes[victim], fieldSize);
+            proxies[victim] = broadphaseAdd(broadphase, &boxes[victim], NULL);
+        }
+        for (uint32_t i = 0; i < BENCH_GRID_BOXES; ++i)
+        {
+            float dx = randGetFloat(-BENCH_GRID_JITTER, BENCH_GRID_JITTER);
+            float dy = randGetFloat(-BENCH_GRID_JITTER, BENCH_GRID_JITTER);
+            boxes[i].topLeft.x += dx;
+            boxes[i].botRight.x += dx;
+            boxes[i].topLeft.y += dy;
+            boxes[i].botRight.y += dy;
+            broadphaseMove(broadphase, proxies[i], &boxes[i]);
+        }
+        *pairs = broadphaseFindPairs(broadphase, &found);
+    }
+    double elapsed = testGetSeconds() - start;
+
+    broadphaseDelete(broadphase);
+    free(boxes);
+    free(proxies);
+    return elapsed * 1000.0 / BENCH_GRID_REBUILDS;
+}
+
+/// @brief Rebuilds on the middle field with boxes despawned & respawned each time. Sweep &
+/// prune pays for every removal with a pass over its endpoints, for every add after one with
+/// a pass over its pair set, and for the sort carrying the new endpoints into place
+static void _benchGridChurn()
+{
+    const float fieldSize = _benchGridFields[1];
+    uint32_t pairs = 0;
+    printf("spatialgrid: %u boxes on a %.0f field, ms per rebuild with churn\n", BENCH_GRID_BOXES, fieldSize);
+    printf("%8s %15s %15s\n", "churn", "grid", "sweep & prune");
+    for (uint32_t c = 0; c < sizeof(_benchGridChurnCounts) / sizeof(_benchGridChurnCounts[0]); ++c)
+    {
+        double grid = _benchGridRebuilds(_benchGridNew, BENCH_GRID_BALL_CELL, fieldSize, _benchGridChurnCounts[c], &pairs);
+        double sap = _benchGridRebuilds(_benchSweepPruneNew, 0.0f, fieldSize, _benchGridChurnCounts[c], &pairs);
+        printf("%8u %15.3f %15.3f\n", _benchGridChurnCounts[c], grid, sap);
+    }
+}
+
+/// @brief Whole fixed steps of 50k balls on each field: movement, walls, the broadphase &
+/// ball vs ball response, against the time a 30 Hz step has. Once through the grid, once
+/// through sweep & prune
+static void _benchGridBallSteps()
+{
+    const BallBroadphase types[] = { BALL_BROADPHASE_GRID, BALL_BROADPHASE_SWEEP_PRUNE };
+    Coord2D* positions = malloc(BENCH_GRID_BOXES * sizeof(Coord2D));
+    if (positions == NULL)
+    {
+        return;
+    }
+
+    printf("spatialgrid: %u balls, ms per fixed step (budget %u)\n", BENCH_GRID_BOXES, TEST_WORLD_STEP_MS);
+    printf("%8s %15s %15s\n", "field", "grid", "sweep & prune");
+    for (uint32_t f = 0; f < sizeof(_benchGridFields) / sizeof(_benchGridFields[0]); ++f)
+    {
+        Bounds2D field = { { 0.0f, 0.0f }, { _benchGridFields[f], _benchGridFields[f] } };
+        printf("%8.0f", _benchGridFields[f]);
+        for (uint32_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t)
+        {
+            ballSetBroadphase(types[t]);
+            testWorldInit(BENCH_GRID_BOXES);
+            // spawned left to right, as the rebuilds add their boxes
+            randSeed(1);
+            for (uint32_t i = 0; i < BENCH_GRID_BOXES; ++i)
+            {
+                positions[i].x = randGetFloat(0.0f, _benchGridFields[f]);
+                positions[i].y = randGetFloat(0.0f, _benchGridFields[f]);
+            }
+            qsort(positions, BENCH_GRID_BOXES, sizeof(Coord2D), _benchGridComparePosX);
+            testWorldSpawnBallsAt(field, positions, BENCH_GRID_BOXES);
+            testWorldStep(2);
+
+            double start = testGetSeconds();
+            testWorldStep(BENCH_GRID_REBUILDS);
+            double elapsed = testGetSeconds() - start;
+            testWorldShutdown();
+
+            printf(" %15.3f", elapsed * 1000.0 / BENCH_GRID_REBUILDS);
+        }
+        printf("\n");
+    }
+    ballSetBroadphase(BALL_BROADPHASE_GRID);
+    free(positions);
+}
+
+/// @brief A ball sized box at a random spot on the field
+/// @param box 
+/// @param fieldSize 
+static void _benchGridScatter(Bounds2D* box, float fieldSize)
+{
+    float radius = randGetFloat(BENCH_GRID_MIN_RADIUS, BENCH_GRID_MAX_RADIUS);
+    float x = randGetFloat(0.0f, fieldSize);
+    float y = randGetFloat(0.0f, fieldSize);
+    box->topLeft.x = x - radius;
+    box->topLeft.y = y - radius;
+    box->botRight.x = x + radius;
+    box->botRight.y = y + radius;
+}
+
+/// @brief qsort comparison; orders boxes by their left edge
+/// @param a 
+/// @param b 
+/// @return 
+static int _benchGridCompareX(const void* a, const void* b)
+{
+    float ax = ((const Bounds2D*)a)->topLeft.x;
+    float bx = ((const Bounds2D*)b)->topLeft.x;
+    return ax < bx ? -1 : (ax > bx ? 1 : 0);
+}
+
+/// @brief qsort comparison; orders positions by x
+/// @param a 
+/// @param b 
+/// @return 
+static int _benchGridComparePosX(const void* a, const void* b)
+{
+    float ax = ((const Coord2D*)a)->x;
+    float bx = ((const Coord2D*)b)->x;
+    return ax < bx ? -1 : (ax > bx ? 1 : 0);
+}
@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "baseTypes.h"
+#include "Object.h"
+#include "transform.h"
+#include "random.h"
+#include "testing.h"
+
+// integrations timed per size; enough that the smallest size runs for a few milliseconds
+#define BENCH_TRANSFORM_WORK 20000000
+
+static const uint32_t _benchTransformSizes[] = { 1000, 10000, 100000 };
+
+static double _benchTransformObjects(uint32_t count);
+static double _benchTransformStore(uint32_t count);
+
+/// @brief Integration over objects one at a time (array of structs), against the transform
+/// store's kernels (struct of arrays), at a few object counts
+void transformBenches()
+{
+    printf("transform: ns per object integrated\n");
+    printf("%8s %12s %12s %8s\n", "objects", "objects", "store", "speedup");
+    for (uint32_t i = 0; i < sizeof(_benchTransformSizes) / sizeof(_benchTransformSizes[0]); ++i)
+    {
+        uint32_t count = _benchTransformSizes[i];
+        double objects = _benchTransformObjects(count);
+        double store = _benchTransformStore(count);
+        printf("%8u %12.3f %12.3f %7.2fx\n", count, objects, store, objects / store);
+    }
+}
+
+/// @brief objDefaultUpdate over an array of objects, as objects without a transform store
+/// integrate
+/// @param count 
+/// @return nanoseconds per object
+static double _benchTransformObjects(uint32_t count)
+{
+    Object* objs = malloc(count * sizeof(Object));
+    if (objs == NULL)
+    {
+        return 0.0;
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        Coord2D pos = { randGetFloat(0.0f, 1000.0f), randGetFloat(0.0f, 1000.0f) };
+        Coord2D vel = { randGetFloat(-150.0f, 150.0f), randGetFloat(-150.0f, 150.0f) };
+        objInit(&objs[i], NULL, pos, vel);
+    }
+
+    uint32_t passes = BENCH_TRANSFORM_WORK / count;
+    double start = testGetSeconds();
+    for (uint32_t pass = 0; pass < passes; ++pass)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            objDefaultUpdate(&objs[i], TEST_WORLD_STEP_MS / 1000.0f);
+        }
+    }
+    double elapsed = testGetSeconds() - start;
+
+    free(objs);
+    return elapsed * 1e9 / ((double)passes * count);
+}
+
+/// @brief transformIntegrate over a store of the same size
+/// @param count 
+/// @return nanoseconds per object
+static double _benchTransformStore(uint32_t count)
+{
+    TransformStore* store = transformStoreNew(count);
+    if (store == NULL)
+    {
+        return 0.0;
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        RealCoord2D pos = { randGetReal(0.0f, 1000.0f), randGetReal(0.0f, 1000.0f) };
+        RealCoord2D vel = { randGetReal(-150.0f, 150.0f), randGetReal(-150.0f, 150.0f) };
+        RealCoord2D accel = { 0, 0 };
+        transformStoreSet(store, i, pos, vel, accel);
+    }
+
+    uint32_t passes = BENCH_TRANSFORM_WORK / count;
+    double start = testGetSeconds();
+    for (uint32_t pass = 0; pass < passes; ++pass)
+    {
+        transformIntegrate(store, count, TEST_WORLD_STEP_MS / 1000.0f);
+    }
+    double elapsed = testGetSeconds() - start;
+
+    transformStoreDelete(store);
+    return elapsed * 1e9 / ((double)passes * count);
+}
@@ -0,0 +1,155 @@
+#include <math.h>
+#include "baseTypes.h"
+#include "objmgr.h"
+#include "ball.h"
+#include "collisionevents.h"
+#include "random.h"
+#include "testing.h"
+
+static void _ballBounceNearWall();
+static void _ballFilteredPairPasses();
+static void _ballCountBallEvents(void* context, const CollisionEvent* events, uint32_t count);
+static float _ballRadius(Ball* ball);
+
+/// @brief Ball collision tests
+void ballTests()
+{
+    testRun("ball: a bounce off a ball carries on from the contact", _ballBounceNearWall);
+    testRun("ball: pairs the layer matrix filters out never collide", _ballFilteredPairPasses);
+}
+
+/// @brief A small ball hits a bigger, resting one late in the step, right by the wall, and
+/// bounces back. Only its path after the contact says where it ends up: walking back from
+/// the end at the new velocity would start it beyond the wall
+static void _ballBounceNearWall()
+{
+    Bounds2D field = { { 0.0f, 0.0f }, { 10000.0f, 1000.0f } };
+    const float SPEED = 10000.0f;
+    const float CONTACT = 0.9f;
+
+    testWorldInit(2);
+    randSeed(1);
+    Coord2D spawn = { 5000.0f, 500.0f };
+    Ball* first = ballNewAt(field, spawn);
+    Ball* second = ballNewAt(field, spawn);
+    TEST_CHECK(first != NULL && second != NULL);
+    if (first == NULL || second == NULL)
+    {
+        testWorldShutdown();
+        return;
+    }
+
+    // the small one bounces back off the big one
+    Ball* small = _ballRadius(first) < _ballRadius(second) ? first : second;
+    Ball* big = small == first ? second : first;
+    float radiusSmall = _ballRadius(small);
+    float radiusBig = _ballRadius(big);
+    float massSmall = radiusSmall * radiusSmall;
+    float massBig = radiusBig * radiusBig;
+    float seconds = TEST_WORLD_STEP_MS / 1000.0f;
+    float contact = CONTACT * seconds;
+    float rebound = SPEED * (massBig - massSmall) / (massBig + massSmall);
+
+    // the big ball rests against the wall, & the small one reaches it at the contact time
+    Coord2D bigPos = { field.botRight.x - radiusBig - 1.0f, spawn.y };
+    Coord2D smallPos = { bigPos.x - radiusBig - radiusSmall - SPEED * contact, spawn.y };
+    Coord2D still = { 0.0f, 0.0f };
+    Coord2D fast = { SPEED, 0.0f };
+    objSetPosition((Object*)big, bigPos);
+    objSetVelocity((Object*)big, still);
+    objSetPosition((Object*)small, smallPos);
+    objSetVelocity((Object*)small, fast);
+
+    // the walk back from where it ends up has to cross the wall for this to test anything
+    float contactX = smallPos.x + SPEED * contact;
+    TEST_CHECK(contactX + rebound * contact > field.botRight.x - radiusSmall);
+
+    testWorldStep(1);
+
+    float expected = contactX - rebound * (seconds - contact);
+    TEST_CHECK(fabsf(objGetPosition((Object*)small).x - expected) < 0.5f);
+    TEST_CHECK(objGetVelocity((Object*)small).x < 0.0f);
+
+    ballDelete(small);
+    ballDelete(big);
+    testWorldShutdown();
+}
+
+/// @brief Two balls on a collision course, on layers the matrix keeps apart, pass through
+/// each other: the broadphase drops the pair, so it is never swept or pushed apart
+static void _ballFilteredPairPasses()
+{
+    Bounds2D field = { { 0.0f, 0.0f }, { 1000.0f, 1000.0f } };
+    const float SPEED = 300.0f;
+
+    // balls collide with the field only
+    uint32_t layerMasks[OBJ_LAYER_COUNT];
+    for (uint32_t layer = 0; layer < OBJ_LAYER_COUNT; ++layer)
+    {
+        layerMasks[layer] = OBJ_LAYER_MASK_ALL;
+    }
+    layerMasks[OBJ_LAYER_BALL] = OBJ_LAYER_BIT(OBJ_LAYER_FIELD);
+    objSetLayerMatrix(layerMasks);
+
+    testWorldInit(2);
+    randSeed(1);
+    uint32_t ballEvents = 0;
+    collisionEventsAddListener(_ballCountBallEvents, &ballEvents);
+    Coord2D leftPos = { 400.0f, 500.0f };
+    Coord2D rightPos = { 600.0f, 500.0f };
+    Ball* left = ballNewAt(field, leftPos);
+    Ball* right = ballNewAt(field, rightPos);
+    TEST_CHECK(left != NULL && right != NULL);
+    if (left == NULL || right == NULL)
+    {
+        objSetLayerMatrix(NULL);
+        testWorldShutdown();
+        return;
+    }
+
+    // head on, overlapping part way through
+    Coord2D toRight = { SPEED, 0.0f };
+    Coord2D toLeft = { -SPEED, 0.0f };
+    objSetVelocity((Object*)left, toRight);
+    objSetVelocity((Object*)right, toLeft);
+
+    // long enough to cross paths, not long enough to reach a wall
+    testWorldStep(10);
+
+    float seconds = 10 * TEST_WORLD_STEP_MS / 1000.0f;
+    TEST_CHECK(ballEvents == 0);
+    TEST_CHECK(objGetVelocity((Object*)left).x == SPEED && objGetVelocity((Object*)right).x == -SPEED);
+    TEST_CHECK(fabsf(objGetPosition((Object*)left).x - (leftPos.x + SPEED * seconds)) < 0.5f);
+    TEST_CHECK(fabsf(objGetPosition((Object*)right).x - (rightPos.x - SPEED * seconds)) < 0.5f);
+
+    collisionEventsRemoveListener(_ballCountBallEvents, &ballEvents);
+    ballDelete(left);
+    ballDelete(right);
+    objSetLayerMatrix(NULL);
+    testWorldShutdown();
+}
+
+/// @brief Collision listener; counts ball vs ball events
+/// @param context the count
+/// @param events 
+/// @param count 
+static void _ballCountBallEvents(void* context, const CollisionEvent* events, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (events[i].b != OBJ_INVALID_HANDLE)
+        {
+            ++*(uint32_t*)context;
+        }
+    }
+}
+
+/// @brief A ball's radius, from its bounds
+/// @param ball 
+/// @return 
+static float _ballRadius(Ball* ball)
+{
+    Bounds2D box;
+    objGetBounds((Object*)ball, &box);
+    return (box.botRight.x - box.topLeft.x) / 2;
+}
@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include "baseTypes.h"
+#include "objmgr.h"
+#include "random.h"
+#include "testing.h"
+
+#define DETERMINISM_BALLS 500
+#define DETERMINISM_STEPS 300
+#define DETERMINISM_SEED 12345
+// objMgrHashState after the run above in a GAME_FIXED_POINT build. Fixed point results don't
+// depend on the compiler or CPU (the ReleaseFastFP & ReleaseAVX2 configurations check that with
+// /fp:fast & /arch:AVX2), so any change here means the simulation itself changed; if that was
+// intended, record the new hash this test prints
+#define DETERMINISM_FIXED_HASH 0x56374614af80e94bull
+
+static uint64_t _determinismRun();
+static void _determinismRepeats();
+#ifdef GAME_FIXED_POINT
+static void _determinismMatchesRecorded();
+#endif
+
+/// @brief Simulation determinism tests
+void determinismTests()
+{
+    testRun("determinism: a seeded run repeats exactly", _determinismRepeats);
+#ifdef GAME_FIXED_POINT
+    testRun("determinism: fixed point hash matches the recorded one", _determinismMatchesRecorded);
+#endif
+}
+
+/// @brief The same seed & steps in one build must hash alike, whatever the number type
+static void _determinismRepeats()
+{
+    uint64_t first = _determinismRun();
+    uint64_t second = _determinismRun();
+    TEST_CHECK(first == second);
+}
+
+#ifdef GAME_FIXED_POINT
+/// @brief Fixed point runs must hash alike across builds, so compare against a stored run
+static void _determinismMatchesRecorded()
+{
+    uint64_t hash = _determinismRun();
+    if (hash != DETERMINISM_FIXED_HASH)
+    {
+        printf("     state hash %016llx, recorded %016llx\n", (unsigned long long)hash, DETERMINISM_FIXED_HASH);
+    }
+    TEST_CHECK(hash == DETERMINISM_FIXED_HASH);
+}
+#endif
+
+/// @brief Seed the shared random generator, fill a field with balls & run fixed steps
+/// @return the state hash at the end
+static uint64_t _determinismRun()
+{
+    Bounds2D field = { { 0.0f, 0.0f }, { 2000.0f, 2000.0f } };
+
+    testWorldInit(DETERMINISM_BALLS);
+    randSeed(DETERMINISM_SEED);
+    testWorldSpawnBalls(field, DETERMINISM_BALLS);
+    testWorldStep(DETERMINISM_STEPS);
+    uint64_t hash = objMgrHashState();
+    testWorldShutdown();
+    return hash;
+}
@@ -0,0 +1,96 @@
+#include <Windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "baseTypes.h"
+#include "testing.h"
+
+static struct testing_t {
+    const char* current;
+    uint32_t run;
+    uint32_t failed;
+    bool currentFailed;
+    uint32_t benchThreads;
+} _testing = { NULL, 0, 0, false, 0 };
+
+/// @brief Run every test suite, or with "bench [threads]", every benchmark. Headless: nothing
+/// here needs a window or a GL context
+/// @param argc 
+/// @param argv 
+/// @return 0 if every test passed
+int main(int argc, char** argv)
+{
+    if (argc > 1 && strcmp(argv[1], "bench") == 0)
+    {
+        _testing.benchThreads = argc > 2 ? (uint32_t)atoi(argv[2]) : 0;
+        jobsBenches();
+        transformBenches();
+        objMgrBenches();
+        spatialGridBenches();
+        sceneBenches();
+        return 0;
+    }
+
+    objMgrTests();
+    determinismTests();
+    spriteBatchTests();
+    transformTests();
+    particleTests();
+    sceneTests();
+    ballTests();
+    renderSoftTests();
+
+    printf("%u tests, %u failed\n", _testing.run, _testing.failed);
+    return _testing.failed == 0 ? 0 : 1;
+}
+
+/// @brief Run a single test, reporting whether every check in it passed
+/// @param name 
+/// @param func 
+void testRun(const char* name, TestFunc func)
+{
+    _testing.current = name;
+    _testing.currentFailed = false;
+
+    func();
+
+    ++_testing.run;
+    if (_testing.currentFailed)
+    {
+        ++_testing.failed;
+    }
+    printf("%s %s\n", _testing.currentFailed ? "FAIL" : "ok  ", name);
+    _testing.current = NULL;
+}
+
+/// @brief Record the outcome of one check within the current test
+/// @param passed 
+/// @param expr 
+/// @param file 
+/// @param line 
+void testCheck(bool passed, const char* expr, const char* file, int line)
+{
+    if (!passed)
+    {
+        printf("  %s(%d): %s: check failed: %s\n", file, line, _testing.current != NULL ? _testing.current : "?", expr);
+        _testing.currentFailed = true;
+    }
+}
+
+/// @brief Most threads benches should scale up to, from the command line
+/// @return 0 for one per core
+uint32_t testGetBenchThreads()
+{
+    return _testing.benchThreads;
+}
+
+/// @brief High resolution wall clock time, for benchmarks
+/// @return seconds since an arbitrary point
+double testGetSeconds()
+{
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+}
@@ -0,0 +1,231 @@
+#include <string.h>
+#include "baseTypes.h"
+#include "objmgr.h"
+#include "testing.h"
+
+#define TEST_OBJ_COUNT 10
+// the object that deletes others during its update
+#define TEST_OBJ_KILLER 2
+// spawned by the killer, so they aren't initialized up front; the doomed one is deleted
+// again in the same update
+#define TEST_OBJ_SPAWNED (TEST_OBJ_COUNT - 2)
+#define TEST_OBJ_DOOMED (TEST_OBJ_COUNT - 1)
+
+typedef struct test_obj_t {
+    Object obj;
+    uint32_t id;
+    uint32_t updates;
+} TestObj;
+
+static void _testObjUpdate(Object* obj, uint32_t milliseconds);
+static void _testObjWake(Object* obj);
+static void _testObjDelete(Object* obj);
+static void _testObjNew(uint32_t id);
+static void _testDestroyFromUpdate();
+#ifdef NDEBUG
+static void _testRawRemovalFromUpdate();
+#endif
+
+static ObjVtable _testObjVtable = {
+    NULL,
+    _testObjUpdate,
+    NULL,
+    NULL,
+    NULL,
+    _testObjWake,
+    NULL,
+    NULL,
+    NULL,
+    0,
+    OBJ_LAYER_DEFAULT
+};
+
+static TestObj _testObjs[TEST_OBJ_COUNT];
+static bool _testDestroyed[TEST_OBJ_COUNT];
+static uint32_t _testWakes[TEST_OBJ_COUNT];
+// the killer deletes directly instead of through objMgrDestroy
+static bool _testRawRemoval = false;
+
+/// @brief Object manager tests
+void objMgrTests()
+{
+    testRun("objmgr: destroy from inside an update", _testDestroyFromUpdate);
+#ifdef NDEBUG
+    // debug builds assert on this misuse instead
+    testRun("objmgr: raw removal from inside an update", _testRawRemovalFromUpdate);
+#endif
+}
+
+/// @brief Delete objects before, after & including the one being updated, from its update
+/// callback, and spawn two, deleting one of them straight away. Deletes of live objects must
+/// wait for the pass to end, and nothing may touch a deleted object afterwards
+static void _testDestroyFromUpdate()
+{
+    objMgrInit(TEST_OBJ_COUNT, true);
+    memset(_testDestroyed, 0, sizeof(_testDestroyed));
+    memset(_testWakes, 0, sizeof(_testWakes));
+    for (uint32_t i = 0; i < TEST_OBJ_SPAWNED; ++i)
+    {
+        _testObjNew(i);
+    }
+
+    objMgrUpdate(16);
+
+    // every object alive at the start of the pass got its update, including the ones
+    // destroyed during it; the spawned one waits for the next pass
+    for (uint32_t i = 0; i < TEST_OBJ_SPAWNED; ++i)
+    {
+        TEST_CHECK(_testDestroyed[i] || _testObjs[i].updates == 1);
+    }
+    TEST_CHECK(_testDestroyed[0] && _testDestroyed[TEST_OBJ_KILLER] && _testDestroyed[5]);
+    TEST_CHECK(objMgrGetHandle(&_testObjs[TEST_OBJ_SPAWNED].obj) != OBJ_INVALID_HANDLE);
+    TEST_CHECK(_testObjs[TEST_OBJ_SPAWNED].updates == 0);
+    TEST_CHECK(_testDestroyed[TEST_OBJ_DOOMED]);
+
+    // the survivors (& the spawned object) keep updating, once each; only the spawned
+    // object's wakeup survives, since the doomed one's handle went stale
+    objMgrUpdate(16);
+    uint32_t survivors[] = { 1, 3, 4, 6, 7 };
+    for (uint32_t i = 0; i < sizeof(survivors) / sizeof(survivors[0]); ++i)
+    {
+        TEST_CHECK(_testObjs[survivors[i]].updates == 2);
+    }
+    TEST_CHECK(_testObjs[TEST_OBJ_SPAWNED].updates == 1);
+    TEST_CHECK(_testWakes[TEST_OBJ_SPAWNED] == 1);
+    TEST_CHECK(_testWakes[TEST_OBJ_DOOMED] == 0);
+
+    // the transforms followed their objects when the live array was compacted
+    for (uint32_t i = 0; i < TEST_OBJ_COUNT; ++i)
+    {
+        if (!_testDestroyed[i])
+        {
+            TEST_CHECK(objGetPosition(&_testObjs[i].obj).x == (float)i);
+            objDeinit(&_testObjs[i].obj);
+        }
+    }
+    objMgrShutdown();
+}
+
+#ifdef NDEBUG
+/// @brief Free live objects from an update callback without going through objMgrDestroy. The
+/// pass must skip them from then on, & the manager must come out packed & consistent
+static void _testRawRemovalFromUpdate()
+{
+    objMgrInit(TEST_OBJ_COUNT, true);
+    memset(_testDestroyed, 0, sizeof(_testDestroyed));
+    memset(_testWakes, 0, sizeof(_testWakes));
+    for (uint32_t i = 0; i < TEST_OBJ_SPAWNED; ++i)
+    {
+        _testObjNew(i);
+    }
+
+    _testRawRemoval = true;
+    objMgrUpdate(16);
+    _testRawRemoval = false;
+
+    // 5 was freed before its turn, so the pass never reached it
+    TEST_CHECK(_testDestroyed[0] && _testDestroyed[5] && _testDestroyed[TEST_OBJ_KILLER]);
+    uint32_t survivors[] = { 1, 3, 4, 6, 7 };
+    for (uint32_t i = 0; i < sizeof(survivors) / sizeof(survivors[0]); ++i)
+    {
+        TEST_CHECK(_testObjs[survivors[i]].updates == 1);
+    }
+
+    // the freed slots are recycled, & everything left is updated & keeps its transform
+    _testObjNew(TEST_OBJ_SPAWNED);
+    objMgrUpdate(16);
+    for (uint32_t i = 0; i < sizeof(survivors) / sizeof(survivors[0]); ++i)
+    {
+        TEST_CHECK(_testObjs[survivors[i]].updates == 2);
+    }
+    TEST_CHECK(_testObjs[TEST_OBJ_SPAWNED].updates == 1);
+    for (uint32_t i = 0; i < TEST_OBJ_SPAWNED + 1; ++i)
+    {
+        if (!_testDestroyed[i])
+        {
+            TEST_CHECK(objGetPosition(&_testObjs[i].obj).x == (float)i);
+            objDeinit(&_testObjs[i].obj);
+        }
+    }
+    objMgrShutdown();
+}
+#endif
+
+/// @brief Update callback; the killer deletes 0 (already updated), 5 (not yet updated, &
+/// twice) & itself, then spawns a replacement, and one more that it deletes right away. In
+/// the raw removal test, it frees 0, 5 & itself directly instead
+/// @param obj 
+/// @param milliseconds 
+static void _testObjUpdate(Object* obj, uint32_t milliseconds)
+{
+    TestObj* testObj = (TestObj*)obj;
+    ++testObj->updates;
+    if (testObj->id != TEST_OBJ_KILLER)
+    {
+        return;
+    }
+
+    if (_testRawRemoval)
+    {
+        ObjHandle victim = objMgrGetHandle(&_testObjs[5].obj);
+        _testObjDelete(&_testObjs[0].obj);
+        _testObjDelete(&_testObjs[5].obj);
+        _testObjDelete(obj);
+        TEST_CHECK(objMgrResolve(victim) == NULL);
+        return;
+    }
+
+    ObjHandle victim = objMgrGetHandle(&_testObjs[5].obj);
+    objMgrDestroy(objMgrGetHandle(&_testObjs[0].obj), _testObjDelete);
+    objMgrDestroy(victim, _testObjDelete);
+    objMgrDestroy(victim, _testObjDelete);
+    objMgrDestroy(objMgrGetHandle(obj), _testObjDelete);
+
+    // deferred, so everything is still allocated & tracked
+    TEST_CHECK(!_testDestroyed[0] && !_testDestroyed[5] && !_testDestroyed[TEST_OBJ_KILLER]);
+    TEST_CHECK(objMgrResolve(victim) == &_testObjs[5].obj);
+
+    // spawned objects have a handle & can ask for wakeups before the pass ends
+    _testObjNew(TEST_OBJ_SPAWNED);
+    TEST_CHECK(objWakeIn(&_testObjs[TEST_OBJ_SPAWNED].obj, 16));
+
+    // deleting a spawned object at once is fine, since the pass doesn't hold it yet; its
+    // add & wakeup must not reach the freed object
+    _testObjNew(TEST_OBJ_DOOMED);
+    ObjHandle doomed = objMgrGetHandle(&_testObjs[TEST_OBJ_DOOMED].obj);
+    TEST_CHECK(doomed != OBJ_INVALID_HANDLE);
+    TEST_CHECK(objWakeIn(&_testObjs[TEST_OBJ_DOOMED].obj, 16));
+    _testObjDelete(&_testObjs[TEST_OBJ_DOOMED].obj);
+    TEST_CHECK(objMgrResolve(doomed) == NULL);
+}
+
+/// @brief Wake callback; counts wakeups per object
+/// @param obj 
+static void _testObjWake(Object* obj)
+{
+    ++_testWakes[((TestObj*)obj)->id];
+}
+
+/// @brief Destroy callback. Scribbles over the object the way a freed pool block would be
+/// reused, so anything still reading it goes wrong
+/// @param obj 
+static void _testObjDelete(Object* obj)
+{
+    TestObj* testObj = (TestObj*)obj;
+    TEST_CHECK(!_testDestroyed[testObj->id]);
+
+    objDeinit(obj);
+    _testDestroyed[testObj->id] = true;
+    memset(testObj, 0xDD, sizeof(TestObj));
+}
+
+/// @brief Initialize a test object, positioned at its id
+/// @param id 
+static void _testObjNew(uint32_t id)
+{
+    Coord2D pos = { (float)id, 0.0f };
+    Coord2D vel = { 0.0f, 0.0f };
+    _testObjs[id].id = id;
+    _testObjs[id].updates = 0;
+    objInit(&_testObjs[id].obj, &_testObjVtable, pos, vel);
+}
@@ -0,0 +1,140 @@
+#include <string.h>
+#include "baseTypes.h"
+#include "particles.h"
+#include "random.h"
+#include "testing.h"
+
+// not a multiple of any register width, so partly filled registers get aged too
+#define PARTICLE_TEST_COUNT 1001
+#define PARTICLE_TEST_STEPS 40
+#define PARTICLE_TEST_STEP_SECONDS 0.016f
+
+static void _particleTestFill(ParticleEmitter* emitter);
+static bool _particleEmittersMatch(const ParticleEmitter* a, const ParticleEmitter* b);
+static void _particleSimdMatchesScalar();
+static void _particleCompactMixedLanes();
+
+/// @brief Particle emitter tests
+void particleTests()
+{
+    testRun("particles: vector update matches scalar as particles die", _particleSimdMatchesScalar);
+    testRun("particles: compaction keeps exactly the live particles", _particleCompactMixedLanes);
+}
+
+/// @brief Random lifetimes, so particles die all over the arrays on every step: alone, in
+/// runs, in whole registers & at the end. Both updates must age, kill & reorder identically
+static void _particleSimdMatchesScalar()
+{
+    Coord2D gravity = { 3.0f, -98.0f };
+    ParticleEmitter* vector = particleEmitterNew(PARTICLE_TEST_COUNT, 0, gravity, 0.5f);
+    ParticleEmitter* scalar = particleEmitterNew(PARTICLE_TEST_COUNT, 0, gravity, 0.5f);
+    TEST_CHECK(vector != NULL && scalar != NULL);
+    if (vector == NULL || scalar == NULL)
+    {
+        particleEmitterDelete(vector);
+        particleEmitterDelete(scalar);
+        return;
+    }
+
+    randSeed(7);
+    _particleTestFill(vector);
+    randSeed(7);
+    _particleTestFill(scalar);
+
+    for (uint32_t step = 0; step < PARTICLE_TEST_STEPS; ++step)
+    {
+        particleEmitterUpdate(vector, PARTICLE_TEST_STEP_SECONDS);
+        particleEmitterUpdateScalar(scalar, PARTICLE_TEST_STEP_SECONDS);
+        TEST_CHECK(_particleEmittersMatch(vector, scalar));
+    }
+    // most, but not all, should be gone by the end
+    TEST_CHECK(vector->count > 0 && vector->count < PARTICLE_TEST_COUNT / 2);
+
+    particleEmitterDelete(vector);
+    particleEmitterDelete(scalar);
+}
+
+/// @brief A hand laid out pattern: a fully dead register, a fully live one, dead lanes mixed
+/// into live ones & a dead last particle. Afterwards only the live ones may remain, each once
+static void _particleCompactMixedLanes()
+{
+    Coord2D gravity = { 0.0f, 0.0f };
+    ParticleEmitter* emitter = particleEmitterNew(32, 0, gravity, 0.0f);
+    TEST_CHECK(emitter != NULL);
+    if (emitter == NULL)
+    {
+        return;
+    }
+
+    // 1 lives, 0 dies on the next update; x tags each particle with its starting index
+    const uint8_t alive[27] = {
+        0, 0, 0, 0, 0, 0, 0, 0,
+        1, 1, 1, 1, 1, 1, 1, 1,
+        1, 0, 1, 0, 0, 1, 1, 0,
+        1, 0, 0
+    };
+    uint32_t expectedLive = 0;
+    emitter->count = sizeof(alive);
+    for (uint32_t i = 0; i < emitter->count; ++i)
+    {
+        emitter->posX[i] = (float)i;
+        emitter->posY[i] = emitter->velX[i] = emitter->velY[i] = 0.0f;
+        emitter->life[i] = alive[i] ? 1.0f : 0.001f;
+        emitter->invLifetime[i] = emitter->size[i] = 1.0f;
+        emitter->color[i] = 0;
+        expectedLive += alive[i];
+    }
+
+    particleEmitterUpdate(emitter, PARTICLE_TEST_STEP_SECONDS);
+
+    TEST_CHECK(emitter->count == expectedLive);
+    uint8_t seen[sizeof(alive)];
+    memset(seen, 0, sizeof(seen));
+    for (uint32_t i = 0; i < emitter->count; ++i)
+    {
+        uint32_t tag = (uint32_t)emitter->posX[i];
+        TEST_CHECK(tag < sizeof(alive) && alive[tag] && !seen[tag]);
+        if (tag < sizeof(alive))
+        {
+            seen[tag] = 1;
+        }
+    }
+
+    particleEmitterDelete(emitter);
+}
+
+/// @brief Fill an emitter to capacity from the shared random generator, with lifetimes
+/// spread over a few steps
+/// @param emitter 
+static void _particleTestFill(ParticleEmitter* emitter)
+{
+    emitter->count = PARTICLE_TEST_COUNT;
+    for (uint32_t i = 0; i < PARTICLE_TEST_COUNT; ++i)
+    {
+        emitter->posX[i] = randGetFloat(0.0f, 500.0f);
+        emitter->posY[i] = randGetFloat(0.0f, 500.0f);
+        emitter->velX[i] = randGetFloat(-200.0f, 200.0f);
+        emitter->velY[i] = randGetFloat(-200.0f, 200.0f);
+        emitter->life[i] = randGetFloat(0.0f, 1.0f);
+        emitter->invLifetime[i] = 1.0f / emitter->life[i];
+        emitter->size[i] = randGetFloat(1.0f, 4.0f);
+        emitter->color[i] = (uint32_t)randGetInt(0, 0xFFFFFF);
+    }
+}
+
+/// @brief Compare the exact bits of every live particle
+/// @param a 
+/// @param b 
+/// @return 
+static bool _particleEmittersMatch(const ParticleEmitter* a, const ParticleEmitter* b)
+{
+    if (a->count != b->count)
+    {
+        return false;
+    }
+    size_t bytes = a->count * sizeof(float);
+    return memcmp(a->posX, b->posX, bytes) == 0 && memcmp(a->posY, b->posY, bytes) == 0
+        && memcmp(a->velX, b->velX, bytes) == 0 && memcmp(a->velY, b->velY, bytes) == 0
+        && memcmp(a->life, b->life, bytes) == 0 && memcmp(a->invLifetime, b->invLifetime, bytes) == 0
+        && memcmp(a->size, b->size, bytes) == 0 && memcmp(a->color, b->color, a->count * sizeof(uint32_t)) == 0;
+}
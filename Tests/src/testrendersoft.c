@@ -0,0 +1,231 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "baseTypes.h"
+#include "render.h"
+#include "rendersoft.h"
+#include "jobs.h"
+#include "testing.h"
+
+// 4 x 4 tiles, so shapes can straddle tile corners
+#define SOFT_TEST_SIZE 256
+#define SOFT_TEST_MAX_COMMANDS 64
+#define SOFT_TEST_MAX_VERTICES 256
+// worker threads for the multi-threaded frames
+#define SOFT_TEST_WORKERS 3
+// the seam frame: a disk centered on the corner of 4 tiles, & an outline whose radius ends
+// short of the tile edge at x = 64 while its outer ring, 2 further out, doesn't
+#define SOFT_TEST_DISK_X 128.0f
+#define SOFT_TEST_DISK_Y 128.0f
+#define SOFT_TEST_DISK_RADIUS 30.0f
+#define SOFT_TEST_RING_X 42.5f
+#define SOFT_TEST_RING_Y 30.0f
+#define SOFT_TEST_RING_RADIUS 20.0f
+
+static const uint32_t SOFT_TEST_CLEAR = 0xFF000000;
+static const uint32_t SOFT_TEST_WHITE = 0xFFFFFFFF;
+
+static void _softSampling();
+static void _softAlphaBlend();
+static void _softTileSeams();
+static RenderBackend* _softBegin();
+static void _softEnd(RenderBackend* backend);
+static void _softQuad(float depth, uint32_t texture, float left, float top, float right, float bottom, float z, uint32_t rgba);
+static void _softDrawSeamFrame();
+static uint32_t _softPixel(const RenderBackend* backend, uint32_t x, uint32_t y);
+
+/// @brief Software rasterizer tests: frames are rendered headless & checked pixel by pixel
+void renderSoftTests()
+{
+    testRun("rendersoft: nearest & linear sampling", _softSampling);
+    testRun("rendersoft: alpha blends over what is behind", _softAlphaBlend);
+    testRun("rendersoft: circles match across tile seams, on any thread count", _softTileSeams);
+}
+
+/// @brief A 2 x 2 texture, black on the left & white on the right, stretched over 4 x 4
+/// pixels. Nearest shows the texels as they are; linear blends pixel centers between
+/// texel centers, wrapping around at the edges
+static void _softSampling()
+{
+    const uint8_t texels[] = {
+        0, 0, 0, 255,   255, 255, 255, 255,
+        0, 0, 0, 255,   255, 255, 255, 255
+    };
+    // pixel centers sit at u = 1/8, 3/8, 5/8 & 7/8
+    const uint8_t nearest[] = { 0, 0, 255, 255 };
+    const uint8_t linear[] = { 64, 64, 191, 191 };
+
+    RenderBackend* backend = _softBegin();
+    uint32_t nearestTexture = renderSoftAddTexture(backend, texels, 2, 2, RENDER_FILTER_NEAREST);
+    uint32_t linearTexture = renderSoftAddTexture(backend, texels, 2, 2, RENDER_FILTER_LINEAR);
+    TEST_CHECK(nearestTexture != 0 && linearTexture != 0 && nearestTexture != linearTexture);
+
+    renderBeginFrame();
+    _softQuad(0.0f, nearestTexture, 0.0f, 0.0f, 4.0f, 4.0f, 0.0f, SOFT_TEST_WHITE);
+    _softQuad(0.0f, linearTexture, 0.0f, 8.0f, 4.0f, 12.0f, 0.0f, SOFT_TEST_WHITE);
+    renderEndFrame();
+
+    for (uint32_t y = 0; y < 4; ++y)
+    {
+        for (uint32_t x = 0; x < 4; ++x)
+        {
+            TEST_CHECK(_softPixel(backend, x, y) == renderPackColor(nearest[x], nearest[x], nearest[x], 255));
+            TEST_CHECK(_softPixel(backend, x, y + 8) == renderPackColor(linear[x], linear[x], linear[x], 255));
+        }
+    }
+    // nothing past the quads' right & bottom edges
+    TEST_CHECK(_softPixel(backend, 4, 0) == SOFT_TEST_CLEAR);
+    TEST_CHECK(_softPixel(backend, 0, 4) == SOFT_TEST_CLEAR);
+    _softEnd(backend);
+}
+
+/// @brief Half transparent red in front of opaque white blends with src-alpha, 1 - src-alpha;
+/// the same red behind the white is hidden by the depth test, even though it draws later
+static void _softAlphaBlend()
+{
+    RenderBackend* backend = _softBegin();
+
+    renderBeginFrame();
+    _softQuad(-0.5f, 0, 0.0f, 0.0f, 16.0f, 16.0f, -0.5f, SOFT_TEST_WHITE);
+    _softQuad(0.5f, 0, 4.0f, 4.0f, 12.0f, 12.0f, 0.5f, renderPackColor(255, 0, 0, 128));
+    _softQuad(0.75f, 0, 20.0f, 0.0f, 28.0f, 8.0f, -0.5f, SOFT_TEST_WHITE);
+    _softQuad(0.8f, 0, 20.0f, 0.0f, 28.0f, 8.0f, -0.75f, renderPackColor(255, 0, 0, 128));
+    renderEndFrame();
+
+    // (255 * 128 + 255 * 127) / 255 & (0 * 128 + 255 * 127) / 255
+    uint32_t blended = _softPixel(backend, 8, 8);
+    TEST_CHECK((blended & 0xFF) == 255);
+    TEST_CHECK(((blended >> 8) & 0xFF) == 127);
+    TEST_CHECK(((blended >> 16) & 0xFF) == 127);
+    TEST_CHECK(_softPixel(backend, 2, 2) == SOFT_TEST_WHITE);
+    TEST_CHECK(_softPixel(backend, 24, 4) == SOFT_TEST_WHITE);
+    _softEnd(backend);
+}
+
+/// @brief A disk centered on a tile corner covers exactly the pixel centers inside it, an
+/// outline whose rings reach past its radius into the next tile gets drawn there, & the
+/// frame is the same whether one thread or several rasterize the tiles
+static void _softTileSeams()
+{
+    RenderBackend* backend = _softBegin();
+    _softDrawSeamFrame();
+
+    for (uint32_t y = 64; y < 192; ++y)
+    {
+        for (uint32_t x = 64; x < 192; ++x)
+        {
+            float dx = (float)x + 0.5f - SOFT_TEST_DISK_X;
+            float dy = (float)y + 0.5f - SOFT_TEST_DISK_Y;
+            bool inside = dx * dx + dy * dy < SOFT_TEST_DISK_RADIUS * SOFT_TEST_DISK_RADIUS;
+            TEST_CHECK(_softPixel(backend, x, y) == (inside ? SOFT_TEST_WHITE : SOFT_TEST_CLEAR));
+        }
+    }
+
+    uint32_t pastEdge = 0;
+    uint32_t outOfReach = 0;
+    for (uint32_t y = 0; y < 64; ++y)
+    {
+        for (uint32_t x = 0; x < 72; ++x)
+        {
+            if (_softPixel(backend, x, y) == SOFT_TEST_CLEAR)
+            {
+                continue;
+            }
+            pastEdge += x >= 64 ? 1 : 0;
+            float dx = (float)x + 0.5f - SOFT_TEST_RING_X;
+            float dy = (float)y + 0.5f - SOFT_TEST_RING_Y;
+            outOfReach += sqrtf(dx * dx + dy * dy) > SOFT_TEST_RING_RADIUS + 3.0f ? 1 : 0;
+        }
+    }
+    TEST_CHECK(pastEdge > 0);
+    TEST_CHECK(outOfReach == 0);
+
+    uint32_t* serial = malloc(SOFT_TEST_SIZE * SOFT_TEST_SIZE * sizeof(uint32_t));
+    TEST_CHECK(serial != NULL);
+    if (serial != NULL)
+    {
+        memcpy(serial, renderSoftGetPixels(backend, NULL, NULL), SOFT_TEST_SIZE * SOFT_TEST_SIZE * sizeof(uint32_t));
+
+        jobsInit(SOFT_TEST_WORKERS);
+        _softDrawSeamFrame();
+        jobsShutdown();
+
+        TEST_CHECK(memcmp(serial, renderSoftGetPixels(backend, NULL, NULL), SOFT_TEST_SIZE * SOFT_TEST_SIZE * sizeof(uint32_t)) == 0);
+        free(serial);
+    }
+    _softEnd(backend);
+}
+
+/// @brief Set up the command buffer with a fresh software backend
+/// @return 
+static RenderBackend* _softBegin()
+{
+    renderInit(SOFT_TEST_MAX_COMMANDS, SOFT_TEST_MAX_VERTICES);
+    RenderBackend* backend = renderSoftNew(SOFT_TEST_SIZE, SOFT_TEST_SIZE);
+    renderSoftSetClearColor(backend, SOFT_TEST_CLEAR);
+    renderSetBackend(backend);
+    return backend;
+}
+
+/// @brief Tear down what _softBegin set up
+/// @param backend 
+static void _softEnd(RenderBackend* backend)
+{
+    renderSetBackend(NULL);
+    renderBackendDelete(backend);
+    renderShutdown();
+}
+
+/// @brief Record an axis aligned quad, corners in TL, BL, BR, TR order as sprites are
+/// @param depth sort depth
+/// @param texture 0 for a flat quad
+/// @param left 
+/// @param top 
+/// @param right 
+/// @param bottom 
+/// @param z every corner's z
+/// @param rgba 
+static void _softQuad(float depth, uint32_t texture, float left, float top, float right, float bottom, float z, uint32_t rgba)
+{
+    RenderVertex* v = renderQuads(RENDER_LAYER_WORLD, depth, texture, 4);
+    TEST_CHECK(v != NULL);
+    if (v == NULL)
+    {
+        return;
+    }
+
+    const float xs[4] = { left, left, right, right };
+    const float ys[4] = { top, bottom, bottom, top };
+    const float us[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+    const float vs[4] = { 0.0f, 1.0f, 1.0f, 0.0f };
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        v[i].x = xs[i];
+        v[i].y = ys[i];
+        v[i].z = z;
+        v[i].u = us[i];
+        v[i].v = vs[i];
+        v[i].rgba = rgba;
+    }
+}
+
+/// @brief Render the seam test's frame
+static void _softDrawSeamFrame()
+{
+    renderBeginFrame();
+    renderCircle(RENDER_LAYER_WORLD, 0.0f, SOFT_TEST_DISK_X, SOFT_TEST_DISK_Y, SOFT_TEST_DISK_RADIUS, SOFT_TEST_WHITE, true);
+    renderCircle(RENDER_LAYER_WORLD, 0.0f, SOFT_TEST_RING_X, SOFT_TEST_RING_Y, SOFT_TEST_RING_RADIUS, SOFT_TEST_WHITE, false);
+    renderEndFrame();
+}
+
+/// @brief Read one pixel of the last frame
+/// @param backend 
+/// @param x 
+/// @param y 
+/// @return 
+static uint32_t _softPixel(const RenderBackend* backend, uint32_t x, uint32_t y)
+{
+    uint32_t width;
+    const uint32_t* pixels = renderSoftGetPixels(backend, &width, NULL);
+    return pixels[y * width + x];
+}
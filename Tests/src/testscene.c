@@ -0,0 +1,57 @@
+#include <math.h>
+#include "baseTypes.h"
+#include "objmgr.h"
+#include "ball.h"
+#include "scene.h"
+#include "random.h"
+#include "testing.h"
+
+static void _sceneBallsHitAsCircles();
+
+/// @brief Scene query tests
+void sceneTests()
+{
+    testRun("scene: balls are hit by their circle, not their box", _sceneBallsHitAsCircles);
+}
+
+/// @brief Rays & points inside a ball's box but outside its circle must miss it; through
+/// the circle they hit where it's entered
+static void _sceneBallsHitAsCircles()
+{
+    Bounds2D field = { { 0.0f, 0.0f }, { 1000.0f, 1000.0f } };
+    Coord2D center = { 500.0f, 500.0f };
+
+    testWorldInit(1);
+    randSeed(1);
+    Ball* ball = ballNewAt(field, center);
+    Bounds2D box;
+    TEST_CHECK(ball != NULL && objGetBounds((Object*)ball, &box));
+    if (ball == NULL)
+    {
+        testWorldShutdown();
+        return;
+    }
+    float radius = (box.botRight.x - box.topLeft.x) / 2;
+    uint32_t mask = OBJ_LAYER_BIT(OBJ_LAYER_BALL);
+    SceneHit hits[2];
+
+    // straight at the center from the left
+    Coord2D origin = { 100.0f, center.y };
+    Coord2D right = { 1.0f, 0.0f };
+    TEST_CHECK(sceneRaycast(origin, right, 1000.0f, mask, hits, 2) == 1);
+    TEST_CHECK(hits[0].obj == (Object*)ball && fabsf(hits[0].distance - (center.x - radius - origin.x)) < 0.01f);
+
+    // diagonally across the box's top left corner: through the box, clear of the circle
+    Coord2D corner = { box.topLeft.x + 0.1f * radius, box.topLeft.y + 0.1f * radius };
+    Coord2D across = { corner.x - 200.0f, corner.y + 200.0f };
+    Coord2D upRight = { 1.0f, -1.0f };
+    TEST_CHECK(sceneRaycast(across, upRight, 1000.0f, mask, hits, 2) == 0);
+
+    // the same corner as a point is outside the circle; just inside its edge isn't
+    TEST_CHECK(scenePointQuery(corner, mask, hits, 2) == 0);
+    Coord2D inside = { center.x + radius * 0.9f, center.y };
+    TEST_CHECK(scenePointQuery(inside, mask, hits, 2) == 1);
+
+    ballDelete(ball);
+    testWorldShutdown();
+}
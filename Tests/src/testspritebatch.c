@@ -0,0 +1,160 @@
+#include <string.h>
+#include "baseTypes.h"
+#include "spritebatch.h"
+#include "testing.h"
+
+// more than any test submits
+#define CAPTURE_MAX_SPRITES 64
+#define CAPTURE_MAX_BATCHES 16
+
+/// @brief Everything the batcher submitted, in place of the render command buffer. Sprites
+/// are drawn with zero size, so each quad's x gives back the id its center was tagged with
+typedef struct sprite_capture_t {
+    uint32_t ids[CAPTURE_MAX_SPRITES];
+    uint32_t spriteCount;
+    uint32_t batchTextures[CAPTURE_MAX_BATCHES];
+    uint32_t batchSizes[CAPTURE_MAX_BATCHES];
+    uint32_t batchCount;
+} SpriteCapture;
+
+static void _captureSubmit(void* context, uint32_t texture, const RenderVertex* vertices, uint32_t vertexCount);
+static void _captureBegin(SpriteCapture* capture, uint32_t maxSprites);
+static void _captureEnd();
+static void _drawTagged(uint32_t id, uint32_t texture, float depth);
+static void _spriteBatchSortOrder();
+static void _spriteBatchRuns();
+static void _spriteBatchEarlyFlush();
+
+/// @brief Sprite batcher tests, headless: batches go to a capture instead of GL
+void spriteBatchTests()
+{
+    testRun("spritebatch: sorts by texture, then depth, then submission", _spriteBatchSortOrder);
+    testRun("spritebatch: one batch per run of a texture", _spriteBatchRuns);
+    testRun("spritebatch: flushes early when the queue fills", _spriteBatchEarlyFlush);
+}
+
+/// @brief Mixed textures & depths, with ties on both
+static void _spriteBatchSortOrder()
+{
+    SpriteCapture capture;
+    _captureBegin(&capture, CAPTURE_MAX_SPRITES);
+    _drawTagged(0, 2, 0.5f);
+    _drawTagged(1, 1, 0.5f);
+    _drawTagged(2, 2, -1.0f);
+    _drawTagged(3, 1, 0.5f);
+    _drawTagged(4, 1, -0.25f);
+    _drawTagged(5, 2, 0.5f);
+    _drawTagged(6, 0, 3.0f);
+    _captureEnd();
+
+    const uint32_t expected[] = { 6, 4, 1, 3, 2, 0, 5 };
+    TEST_CHECK(capture.spriteCount == 7);
+    TEST_CHECK(memcmp(capture.ids, expected, sizeof(expected)) == 0);
+}
+
+/// @brief Runs split wherever the texture changes in sorted order, however the draws were
+/// interleaved, & the counters agree with what was submitted
+static void _spriteBatchRuns()
+{
+    SpriteCapture capture;
+    _captureBegin(&capture, CAPTURE_MAX_SPRITES);
+    for (uint32_t i = 0; i < 12; ++i)
+    {
+        _drawTagged(i, 1 + i % 3, (float)i);
+    }
+    _captureEnd();
+
+    TEST_CHECK(capture.batchCount == 3);
+    for (uint32_t batch = 0; batch < capture.batchCount; ++batch)
+    {
+        TEST_CHECK(capture.batchTextures[batch] == batch + 1);
+        TEST_CHECK(capture.batchSizes[batch] == 4);
+    }
+
+    const SpriteBatchStats* stats = spriteBatchGetStats();
+    TEST_CHECK(stats->sprites == 12);
+    TEST_CHECK(stats->batches == 3);
+    TEST_CHECK(stats->flushes == 1);
+}
+
+/// @brief A full queue is sorted & submitted on the next draw; sprites queued after that
+/// sort among themselves only
+static void _spriteBatchEarlyFlush()
+{
+    SpriteCapture capture;
+    _captureBegin(&capture, 4);
+    _drawTagged(0, 2, 0.0f);
+    _drawTagged(1, 1, 0.0f);
+    _drawTagged(2, 2, 0.0f);
+    _drawTagged(3, 1, 0.0f);
+    TEST_CHECK(capture.spriteCount == 0);
+
+    _drawTagged(4, 1, 0.0f);
+    TEST_CHECK(capture.spriteCount == 4);
+    _drawTagged(5, 0, 0.0f);
+    _captureEnd();
+
+    const uint32_t expected[] = { 1, 3, 0, 2, 5, 4 };
+    TEST_CHECK(capture.spriteCount == 6);
+    TEST_CHECK(memcmp(capture.ids, expected, sizeof(expected)) == 0);
+
+    const SpriteBatchStats* stats = spriteBatchGetStats();
+    TEST_CHECK(stats->sprites == 6);
+    TEST_CHECK(stats->batches == 4);
+    TEST_CHECK(stats->flushes == 2);
+}
+
+/// @brief Record each batch's texture & size, & the ids of its sprites in order
+/// @param context the SpriteCapture
+/// @param texture 
+/// @param vertices 
+/// @param vertexCount 
+static void _captureSubmit(void* context, uint32_t texture, const RenderVertex* vertices, uint32_t vertexCount)
+{
+    SpriteCapture* capture = context;
+    if (capture->batchCount < CAPTURE_MAX_BATCHES)
+    {
+        capture->batchTextures[capture->batchCount] = texture;
+        capture->batchSizes[capture->batchCount] = vertexCount / 4;
+        ++capture->batchCount;
+    }
+    for (uint32_t i = 0; i < vertexCount && capture->spriteCount < CAPTURE_MAX_SPRITES; i += 4)
+    {
+        capture->ids[capture->spriteCount++] = (uint32_t)vertices[i].x;
+    }
+}
+
+/// @brief Start a frame with batches going to a capture
+/// @param capture 
+/// @param maxSprites queue size
+static void _captureBegin(SpriteCapture* capture, uint32_t maxSprites)
+{
+    memset(capture, 0, sizeof(SpriteCapture));
+    spriteBatchInit(maxSprites);
+    spriteBatchSetSubmit(_captureSubmit, capture);
+    spriteBatchBegin();
+}
+
+/// @brief End the frame & put the batcher back as the game has it. Stats survive until the
+/// next Begin
+static void _captureEnd()
+{
+    spriteBatchEnd();
+    spriteBatchSetSubmit(NULL, NULL);
+    spriteBatchShutdown();
+}
+
+/// @brief Queue a zero sized sprite whose x is its id
+/// @param id 
+/// @param texture 
+/// @param depth 
+static void _drawTagged(uint32_t id, uint32_t texture, float depth)
+{
+    Sprite sprite;
+    memset(&sprite, 0, sizeof(Sprite));
+    sprite.center.x = (float)id;
+    sprite.depth = depth;
+    sprite.texture = texture;
+    sprite.color = 0xFFFFFFFF;
+    spriteBatchDraw(&sprite);
+}
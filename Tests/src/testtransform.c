@@ -0,0 +1,103 @@
+#include <string.h>
+#include "baseTypes.h"
+#include "transform.h"
+#include "random.h"
+#include "testing.h"
+
+// not a multiple of any register width, so the remainder loop runs too
+#define TRANSFORM_TEST_COUNT 1003
+#define TRANSFORM_TEST_STEPS 10
+// where the second of two ranges starts; a multiple of TRANSFORM_LANES
+#define TRANSFORM_TEST_SPLIT 512
+
+static TransformStore* _transformTestStore();
+static bool _transformStoresMatch(const TransformStore* a, const TransformStore* b, uint32_t count);
+static void _transformSimdMatchesScalar();
+static void _transformRangesMatchWhole();
+
+/// @brief Transform store tests
+void transformTests()
+{
+    testRun("transform: vector integration matches scalar", _transformSimdMatchesScalar);
+    testRun("transform: integrating in ranges matches one pass", _transformRangesMatchWhole);
+}
+
+/// @brief The SSE/AVX kernels round exactly as the scalar reference does, step after step
+static void _transformSimdMatchesScalar()
+{
+    randSeed(3);
+    TransformStore* vector = _transformTestStore();
+    randSeed(3);
+    TransformStore* scalar = _transformTestStore();
+    TEST_CHECK(vector != NULL && scalar != NULL);
+    if (vector == NULL || scalar == NULL)
+    {
+        transformStoreDelete(vector);
+        transformStoreDelete(scalar);
+        return;
+    }
+
+    for (uint32_t step = 0; step < TRANSFORM_TEST_STEPS; ++step)
+    {
+        transformIntegrate(vector, TRANSFORM_TEST_COUNT, TEST_WORLD_STEP_MS / 1000.0f);
+        transformIntegrateScalar(scalar, TRANSFORM_TEST_COUNT, TEST_WORLD_STEP_MS / 1000.0f);
+    }
+    TEST_CHECK(_transformStoresMatch(vector, scalar, TRANSFORM_TEST_COUNT));
+
+    transformStoreDelete(vector);
+    transformStoreDelete(scalar);
+}
+
+/// @brief Two ranges, as the job system splits them, give the same result as one call
+static void _transformRangesMatchWhole()
+{
+    randSeed(4);
+    TransformStore* split = _transformTestStore();
+    randSeed(4);
+    TransformStore* whole = _transformTestStore();
+    TEST_CHECK(split != NULL && whole != NULL);
+    if (split == NULL || whole == NULL)
+    {
+        transformStoreDelete(split);
+        transformStoreDelete(whole);
+        return;
+    }
+
+    transformIntegrateRange(split, TRANSFORM_TEST_SPLIT, TRANSFORM_TEST_COUNT, 0.02f);
+    transformIntegrateRange(split, 0, TRANSFORM_TEST_SPLIT, 0.02f);
+    transformIntegrate(whole, TRANSFORM_TEST_COUNT, 0.02f);
+    TEST_CHECK(_transformStoresMatch(split, whole, TRANSFORM_TEST_COUNT));
+
+    transformStoreDelete(split);
+    transformStoreDelete(whole);
+}
+
+/// @brief A store of random transforms, drawn from the shared random generator
+/// @return NULL if it couldn't be allocated
+static TransformStore* _transformTestStore()
+{
+    TransformStore* store = transformStoreNew(TRANSFORM_TEST_COUNT);
+    if (store != NULL)
+    {
+        for (uint32_t i = 0; i < TRANSFORM_TEST_COUNT; ++i)
+        {
+            RealCoord2D pos = { randGetReal(-1000.0f, 1000.0f), randGetReal(-1000.0f, 1000.0f) };
+            RealCoord2D vel = { randGetReal(-300.0f, 300.0f), randGetReal(-300.0f, 300.0f) };
+            RealCoord2D accel = { randGetReal(-50.0f, 50.0f), randGetReal(-50.0f, 50.0f) };
+            transformStoreSet(store, i, pos, vel, accel);
+        }
+    }
+    return store;
+}
+
+/// @brief Compare the exact bits of two stores' positions & velocities
+/// @param a 
+/// @param b 
+/// @param count 
+/// @return 
+static bool _transformStoresMatch(const TransformStore* a, const TransformStore* b, uint32_t count)
+{
+    size_t bytes = count * sizeof(Real);
+    return memcmp(a->posX, b->posX, bytes) == 0 && memcmp(a->posY, b->posY, bytes) == 0
+        && memcmp(a->velX, b->velX, bytes) == 0 && memcmp(a->velY, b->velY, bytes) == 0;
+}
@@ -0,0 +1,109 @@
+#include <stdlib.h>
+#include <assert.h>
+#include "baseTypes.h"
+#include "objmgr.h"
+#include "collisionevents.h"
+#include "ball.h"
+#include "random.h"
+#include "testing.h"
+
+// plenty for every ball hitting a wall & another ball in a step; the rest are dropped
+#define TEST_WORLD_MAX_EVENTS 65536
+
+static struct test_world_t {
+    Ball** balls;
+    uint32_t ballCount;
+    uint32_t maxBalls;
+} _testWorld = { NULL, 0, 0 };
+
+static bool _testWorldSpawnBall(Bounds2D field, Coord2D pos);
+
+/// @brief Set up the object manager (with a transform store, as the game runs it), collision
+/// events & the ball pool
+/// @param maxObjects 
+void testWorldInit(uint32_t maxObjects)
+{
+    objMgrInit(maxObjects, true);
+    objMgrSetFixedStep(TEST_WORLD_STEP_MS, 1);
+    collisionEventsInit(TEST_WORLD_MAX_EVENTS);
+    ballInitPool();
+
+    _testWorld.balls = malloc(maxObjects * sizeof(Ball*));
+    _testWorld.ballCount = 0;
+    _testWorld.maxBalls = _testWorld.balls != NULL ? maxObjects : 0;
+}
+
+/// @brief Delete every ball & shut down what testWorldInit set up
+void testWorldShutdown()
+{
+    for (uint32_t i = 0; i < _testWorld.ballCount; ++i)
+    {
+        ballDelete(_testWorld.balls[i]);
+    }
+    free(_testWorld.balls);
+    _testWorld.balls = NULL;
+    _testWorld.ballCount = _testWorld.maxBalls = 0;
+
+    ballShutdownPool();
+    collisionEventsShutdown();
+    objMgrShutdown();
+}
+
+/// @brief Scatter balls across the field, at positions & velocities drawn from the shared
+/// random generator (so randSeed first for a repeatable world)
+/// @param field 
+/// @param count 
+void testWorldSpawnBalls(Bounds2D field, uint32_t count)
+{
+    for (uint32_t i = 0; i < count && _testWorld.ballCount < _testWorld.maxBalls; ++i)
+    {
+        Coord2D pos = { randGetFloat(field.topLeft.x, field.botRight.x), randGetFloat(field.topLeft.y, field.botRight.y) };
+        if (!_testWorldSpawnBall(field, pos))
+        {
+            return;
+        }
+    }
+}
+
+/// @brief Spawn balls at the given positions, in order; velocities are still drawn from the
+/// shared random generator
+/// @param field 
+/// @param positions 
+/// @param count 
+void testWorldSpawnBallsAt(Bounds2D field, const Coord2D* positions, uint32_t count)
+{
+    for (uint32_t i = 0; i < count && _testWorld.ballCount < _testWorld.maxBalls; ++i)
+    {
+        if (!_testWorldSpawnBall(field, positions[i]))
+        {
+            return;
+        }
+    }
+}
+
+/// @brief Spawn one ball & keep it for testWorldShutdown
+/// @param field 
+/// @param pos 
+/// @return false if the pool is out of balls
+static bool _testWorldSpawnBall(Bounds2D field, Coord2D pos)
+{
+    Ball* ball = ballNewAt(field, pos);
+    assert(ball != NULL);
+    if (ball == NULL)
+    {
+        return false;
+    }
+    _testWorld.balls[_testWorld.ballCount++] = ball;
+    return true;
+}
+
+/// @brief Run fixed steps, delivering each step's collision events as the game would
+/// @param steps 
+void testWorldStep(uint32_t steps)
+{
+    for (uint32_t i = 0; i < steps; ++i)
+    {
+        objMgrFixedUpdate(TEST_WORLD_STEP_MS);
+        collisionEventsDispatch();
+    }
+}